@@ -0,0 +1,554 @@
+/**
+ * @file simulador_bench.cpp
+ * @brief Banco de pruebas de rendimiento del núcleo de la simulación
+ *
+ * Micro: operaciones sueltas del tick (siguiente paso, salida más cercana,
+ * colisiones y registro de estadísticas) y la generación de planos de 10M
+ * celdas. Macro: ticks completos con 1k, 10k y 100k agentes en mapas de
+ * 100², 500² y 2000², en cada modo de movimiento, y en planos generados
+ * (edificio, salón, estadio y laberinto).
+ *
+ * Uso:
+ *   simulador_bench [--filtro texto] [--salida resultados.json]
+ *                   [--base base.json] [--umbral 10] [--rapido] [--todo]
+ *
+ * Los resultados se escriben en JSON (--salida); ese mismo archivo sirve
+ * como base de una corrida posterior (--base), que informa la diferencia
+ * de cada caso en porcentaje y termina con código 1 si alguno empeoró más
+ * que el umbral.
+ */
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/Simulador.h"
+#include "../include/Escenario.h"
+#include "../include/PathFinder.h"
+#include "../include/EstadisticasSimulacion.h"
+#include "../include/Persona.h"
+#include "../include/FactoriaAgentes.h"
+#include "../include/GeneradorEscenarios.h"
+
+// Acceso a los pasos internos del tick (Simulador lo declara friend)
+class AccesoBancoSimulador {
+public:
+    // Programa a los agentes en el hilo de simulación sin correr un tick
+    static void preparar(Simulador& simulador) {
+        simulador.ejecutarEnHilo([&simulador]() { simulador.prepararSimulacion(); });
+    }
+
+    // El paso de colisiones de procesarAgente; solo con la simulación pausada
+    static bool comprobarColision(Simulador& simulador, Posicion destino) {
+        return simulador.comprobarColision(destino);
+    }
+};
+
+namespace {
+
+const uint32_t SEMILLA = 12345;
+const int VERSION_RESULTADOS = 1;
+
+const TipoPlano PLANOS[] = {TipoPlano::EDIFICIO, TipoPlano::SALON, TipoPlano::ESTADIO, TipoPlano::LABERINTO};
+
+// Fracción máxima de celdas ocupadas al colocar a los agentes
+const double DENSIDAD_MAXIMA = 0.3;
+
+// Agentes * celdas por encima del cual un tick en rejilla (búsqueda de ruta
+// por agente sobre todo el mapa) tarda minutos; --todo lo corre igual
+const double LIMITE_TRABAJO_REJILLA = 5e7;
+
+// Tope de operaciones por tanda en los micro (acota la memoria de los que acumulan)
+const uint64_t MAXIMO_POR_TANDA = uint64_t(1) << 20;
+
+volatile int64_t sumidero = 0;  // Evita que el compilador descarte lo medido
+
+struct Opciones {
+    std::string filtro;
+    std::string salida;
+    std::string base;
+    double umbral = 10.0;
+    bool rapido = false;
+    bool todo = false;
+};
+
+struct Resultado {
+    std::string nombre;
+    double nsPorOperacion = 0.0;
+    uint64_t operaciones = 0;
+    std::string nota;  // No vacía si el caso se omitió
+};
+
+double ahoraNs() {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+class Banco {
+public:
+    explicit Banco(const Opciones& opciones) : opciones(opciones) {}
+
+    bool incluye(const std::string& nombre) const {
+        return opciones.filtro.empty() || nombre.find(opciones.filtro) != std::string::npos;
+    }
+
+    /**
+     * @brief Mide cuerpo(i) por operación: tandas crecientes hasta el tiempo
+     * mínimo y luego la mediana de varias repeticiones
+     * @param preparar Se llama antes de cada tanda con su cantidad de operaciones, fuera de la medición
+     */
+    void micro(const std::string& nombre, const std::function<void(uint64_t)>& cuerpo,
+               const std::function<void(uint64_t)>& preparar = nullptr) {
+        if (!incluye(nombre)) return;
+
+        const double tiempoMinimoNs = opciones.rapido ? 2e7 : 2e8;
+        const int repeticiones = opciones.rapido ? 3 : 5;
+
+        auto tanda = [&](uint64_t n) {
+            if (preparar) preparar(n);
+            const double inicio = ahoraNs();
+            for (uint64_t i = 0; i < n; ++i) {
+                cuerpo(i);
+            }
+            return ahoraNs() - inicio;
+        };
+
+        uint64_t n = 1;
+        while (n < MAXIMO_POR_TANDA && tanda(n) < tiempoMinimoNs) {
+            n *= 2;
+        }
+
+        std::vector<double> medidas;
+        for (int r = 0; r < repeticiones; ++r) {
+            medidas.push_back(tanda(n) / static_cast<double>(n));
+        }
+        std::sort(medidas.begin(), medidas.end());
+        agregar(Resultado{nombre, medidas[medidas.size() / 2], n * repeticiones, ""});
+    }
+
+    void agregar(const Resultado& resultado) {
+        resultados.push_back(resultado);
+        if (resultado.nota.empty()) {
+            std::printf("%-44s %14.1f ns/op  (%llu op)\n", resultado.nombre.c_str(),
+                        resultado.nsPorOperacion, static_cast<unsigned long long>(resultado.operaciones));
+        } else {
+            std::printf("%-44s %14s        (%s)\n", resultado.nombre.c_str(), "omitido", resultado.nota.c_str());
+        }
+        std::fflush(stdout);
+    }
+
+    const std::vector<Resultado>& getResultados() const { return resultados; }
+    const Opciones& getOpciones() const { return opciones; }
+
+private:
+    Opciones opciones;
+    std::vector<Resultado> resultados;
+};
+
+// Mapa abierto con una salida centrada en cada lado
+void colocarSalidas(Escenario& escenario, int anchoSalida) {
+    const int lado = escenario.filas;
+    const int desde = (lado - anchoSalida) / 2;
+    for (int k = desde; k < desde + anchoSalida; ++k) {
+        escenario.setCelda(0, k, 2);
+        escenario.setCelda(lado - 1, k, 2);
+        escenario.setCelda(k, 0, 2);
+        escenario.setCelda(k, lado - 1, 2);
+    }
+}
+
+std::unique_ptr<Escenario> crearMapa(int lado, int anchoSalida) {
+    auto escenario = std::make_unique<Escenario>(lado, lado);
+    colocarSalidas(*escenario, anchoSalida);
+    return escenario;
+}
+
+std::vector<Posicion> puntosAleatorios(int lado, size_t cantidad, std::mt19937& rng) {
+    std::uniform_int_distribution<int> coordenada(1, lado - 2);
+    std::vector<Posicion> puntos(cantidad);
+    for (Posicion& p : puntos) {
+        p = Posicion(coordenada(rng), coordenada(rng));
+    }
+    return puntos;
+}
+
+// ============================================================================
+// Micro
+// ============================================================================
+
+void microBenchmarks(Banco& banco) {
+    std::mt19937 rng(SEMILLA);
+
+    {
+        const int lado = 100;
+        auto escenario = crearMapa(lado, 1);
+        const std::vector<Posicion> origenes = puntosAleatorios(lado, 1024, rng);
+        std::vector<Posicion> salidas;
+        for (const Posicion& origen : origenes) {
+            salidas.push_back(escenario->getSalidaMasCercana(origen));
+        }
+        banco.micro("micro/pathfinder_siguiente_paso/100x100", [&](uint64_t i) {
+            const size_t k = i % origenes.size();
+            sumidero += PathFinder::calcularSiguientePaso(escenario.get(), origenes[k], salidas[k]).x();
+        });
+    }
+
+    {
+        const int lado = 500;
+        auto escenario = crearMapa(lado, 2);
+        const std::vector<Posicion> origenes = puntosAleatorios(lado, 1024, rng);
+        banco.micro("micro/salida_mas_cercana/500x500", [&](uint64_t i) {
+            sumidero += escenario->getSalidaMasCercana(origenes[i % origenes.size()]).y();
+        });
+    }
+
+    if (banco.incluye("micro/colision/500x500")) {
+        // La comprobación de procesarAgente (celda destino ocupada y registro
+        // del choque) en un simulador con la rejilla ocupada al DENSIDAD_MAXIMA
+        const int lado = 500;
+        Simulador simulador;
+        simulador.cargarEscenario(lado, lado);
+        std::bernoulli_distribution ocupada(DENSIDAD_MAXIMA);
+        int id = 0;
+        for (int f = 1; f < lado - 1; ++f) {
+            for (int c = 1; c < lado - 1; ++c) {
+                if (ocupada(rng)) {
+                    simulador.agregarAgente(std::make_shared<Persona>(id++, Posicion(f, c)));
+                }
+            }
+        }
+        AccesoBancoSimulador::preparar(simulador);
+
+        const std::vector<Posicion> destinos = puntosAleatorios(lado, 4096, rng);
+        banco.micro("micro/colision/500x500", [&](uint64_t i) {
+            sumidero += AccesoBancoSimulador::comprobarColision(simulador, destinos[i % destinos.size()]);
+        });
+    }
+
+    {
+        const int lado = 500;
+        const std::vector<Posicion> posiciones = puntosAleatorios(lado, 1024, rng);
+        std::vector<std::shared_ptr<AgenteBase>> agentes;
+        EstadisticasSimulacion estadisticas;
+        // Da de alta a los primeros 'cantidad' agentes; los que faltan se crean una vez
+        auto registrarAgentes = [&](size_t cantidad) {
+            estadisticas.iniciar(lado, lado);
+            for (size_t k = agentes.size(); k < cantidad; ++k) {
+                agentes.push_back(std::make_shared<Persona>(static_cast<int>(k), posiciones[k % posiciones.size()]));
+            }
+            for (size_t k = 0; k < cantidad; ++k) {
+                estadisticas.registrarAgente(agentes[k]);
+            }
+        };
+
+        banco.micro("micro/estadisticas_movimiento", [&](uint64_t i) {
+            // Cada agente va y vuelve entre su celda y la de abajo
+            const size_t k = i % posiciones.size();
+            const bool ida = (i / posiciones.size()) % 2 == 0;
+            const Posicion celda = posiciones[k];
+            const Posicion vecina(celda.x() + 1, celda.y());
+            estadisticas.registrarMovimiento(agentes[k], ida ? celda : vecina, ida ? vecina : celda);
+        }, [&](uint64_t) { registrarAgentes(posiciones.size()); });
+
+        // Cada operación evacua a un agente distinto: la tanda tiene tantos como operaciones
+        banco.micro("micro/estadisticas_evacuacion", [&](uint64_t i) {
+            estadisticas.registrarEvacuacion(agentes[i], Posicion(0, lado / 2), 0.5 * static_cast<double>(i));
+        }, [&](uint64_t n) { registrarAgentes(n); });
+    }
+
+    {
+        // Planos de ~10M celdas (lo que no se puede dibujar a mano)
+        const int lado = 3163;
+        const std::string sufijo = "/" + std::to_string(lado) + "x" + std::to_string(lado);
+        std::unique_ptr<Escenario> escenario;
+        GeneradorEscenarios generador(SEMILLA);
+        for (TipoPlano tipo : PLANOS) {
+            const std::string nombre = "micro/generar_plano/" + std::string(GeneradorEscenarios::nombreTipo(tipo)) + sufijo;
+            if (!banco.incluye(nombre)) continue;
+            if (!escenario) escenario = std::make_unique<Escenario>(lado, lado);
+            ParametrosPlano parametros;
+            parametros.tipo = tipo;
+            banco.micro(nombre, [&](uint64_t) {
+                generador.generar(*escenario, parametros);
+                sumidero += escenario->getVersion();
+            });
+        }
+    }
+}
+
+// ============================================================================
+// Macro
+// ============================================================================
+
+const char* nombreModo(ModoMovimiento modo) {
+    switch (modo) {
+        case ModoMovimiento::REJILLA: return "rejilla";
+        case ModoMovimiento::CONTINUO: return "continuo";
+        case ModoMovimiento::CAMPO_PISO: return "campo_piso";
+    }
+    return "";
+}
+
+// Mediana del tiempo por tick; el primero no se mide
+void medirTicks(Banco& banco, const std::string& nombre, Simulador& simulador) {
+    const Opciones& opciones = banco.getOpciones();
+
+    // El primer tick prepara la simulación (rutas, campos, índices): no se mide
+    simulador.pasoUnico();
+
+    const int maximoTicks = opciones.rapido ? 5 : 20;
+    const double presupuestoNs = opciones.rapido ? 2e9 : 1e10;
+    std::vector<double> ticks;
+    double total = 0.0;
+    while (static_cast<int>(ticks.size()) < maximoTicks && total < presupuestoNs &&
+           !simulador.estaTerminada()) {
+        const double inicio = ahoraNs();
+        simulador.pasoUnico();
+        ticks.push_back(ahoraNs() - inicio);
+        total += ticks.back();
+    }
+    if (ticks.empty()) {
+        banco.agregar(Resultado{nombre, 0.0, 0, "terminó en el primer tick"});
+        return;
+    }
+    std::sort(ticks.begin(), ticks.end());
+    banco.agregar(Resultado{nombre, ticks[ticks.size() / 2], ticks.size(), ""});
+}
+
+void macroTick(Banco& banco, int lado, int numAgentes, ModoMovimiento modo) {
+    const std::string nombre = "macro/tick/" + std::string(nombreModo(modo)) + "/" +
+                               std::to_string(lado) + "x" + std::to_string(lado) + "/" +
+                               std::to_string(numAgentes);
+    if (!banco.incluye(nombre)) return;
+
+    const Opciones& opciones = banco.getOpciones();
+    const double celdas = static_cast<double>(lado) * lado;
+    if (numAgentes > celdas * DENSIDAD_MAXIMA) {
+        banco.agregar(Resultado{nombre, 0.0, 0, "no entran en el mapa"});
+        return;
+    }
+    if (modo == ModoMovimiento::REJILLA && !opciones.todo && numAgentes * celdas > LIMITE_TRABAJO_REJILLA) {
+        banco.agregar(Resultado{nombre, 0.0, 0, "demasiado lento en rejilla; usar --todo"});
+        return;
+    }
+
+    Simulador simulador;
+    simulador.cargarEscenario(lado, lado);
+    simulador.setModoMovimiento(modo);
+    colocarSalidas(*simulador.getEscenario(), std::max(1, lado / 20));
+
+    // Celdas distintas, elegidas con la misma semilla en cada corrida
+    std::mt19937 rng(SEMILLA + static_cast<uint32_t>(lado) * 31 + static_cast<uint32_t>(numAgentes));
+    std::uniform_int_distribution<int> coordenada(1, lado - 2);
+    std::uniform_int_distribution<int> edad(18, 80);
+    std::bernoulli_distribution movilidadReducida(0.1);
+    std::vector<uint8_t> usada(static_cast<size_t>(celdas), 0);
+    for (int id = 0; id < numAgentes; ) {
+        const Posicion celda(coordenada(rng), coordenada(rng));
+        uint8_t& marca = usada[static_cast<size_t>(celda.x()) * lado + celda.y()];
+        if (marca) continue;
+        marca = 1;
+        simulador.agregarAgente(std::make_shared<Persona>(id, celda, edad(rng), movilidadReducida(rng)));
+        ++id;
+    }
+
+    medirTicks(banco, nombre, simulador);
+}
+
+// Tick en campo de piso sobre un plano generado, con la población en grupos
+void macroPlano(Banco& banco, TipoPlano tipo, int lado, int numAgentes) {
+    const std::string nombre = "macro/plano/" + std::string(GeneradorEscenarios::nombreTipo(tipo)) + "/" +
+                               std::to_string(lado) + "x" + std::to_string(lado) + "/" +
+                               std::to_string(numAgentes);
+    if (!banco.incluye(nombre)) return;
+
+    Simulador simulador;
+    simulador.cargarEscenario(lado, lado);
+    simulador.setModoMovimiento(ModoMovimiento::CAMPO_PISO);
+
+    GeneradorEscenarios generador(SEMILLA + static_cast<uint32_t>(tipo));
+    ParametrosPlano parametros;
+    parametros.tipo = tipo;
+    parametros.salidas = 8;
+    generador.generar(*simulador.getEscenario(), parametros);
+
+    FactoriaAgentes factoria;
+    for (const auto& persona : generador.poblar(*simulador.getEscenario(), factoria, numAgentes)) {
+        simulador.agregarAgente(persona);
+    }
+
+    medirTicks(banco, nombre, simulador);
+}
+
+void macroBenchmarks(Banco& banco) {
+    const ModoMovimiento modos[] = {ModoMovimiento::REJILLA, ModoMovimiento::CONTINUO, ModoMovimiento::CAMPO_PISO};
+    const int lados[] = {100, 500, 2000};
+    const int agentes[] = {1000, 10000, 100000};
+    for (ModoMovimiento modo : modos) {
+        for (int lado : lados) {
+            for (int numAgentes : agentes) {
+                macroTick(banco, lado, numAgentes, modo);
+            }
+        }
+    }
+    for (TipoPlano tipo : PLANOS) {
+        macroPlano(banco, tipo, 1000, 10000);
+    }
+}
+
+// ============================================================================
+// Resultados y comparación con la base
+// ============================================================================
+
+bool guardarResultados(const Banco& banco, const std::string& ruta) {
+    QJsonArray resultados;
+    for (const Resultado& r : banco.getResultados()) {
+        QJsonObject objeto;
+        objeto["nombre"] = QString::fromStdString(r.nombre);
+        objeto["ns_por_op"] = r.nsPorOperacion;
+        objeto["operaciones"] = static_cast<double>(r.operaciones);
+        if (!r.nota.empty()) {
+            objeto["omitido"] = QString::fromStdString(r.nota);
+        }
+        resultados.append(objeto);
+    }
+
+    QJsonObject raiz;
+    raiz["version"] = VERSION_RESULTADOS;
+    raiz["fecha"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    raiz["hilos"] = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+#ifdef NDEBUG
+    raiz["optimizado"] = true;
+#else
+    raiz["optimizado"] = false;
+#endif
+    raiz["resultados"] = resultados;
+
+    QFile archivo(QString::fromStdString(ruta));
+    if (!archivo.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    archivo.write(QJsonDocument(raiz).toJson());
+    return true;
+}
+
+/**
+ * @return Cantidad de casos que empeoraron más que el umbral, o -1 si la base no se pudo leer
+ */
+int compararConBase(const Banco& banco, const std::string& ruta, double umbral) {
+    QFile archivo(QString::fromStdString(ruta));
+    if (!archivo.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QJsonDocument documento = QJsonDocument::fromJson(archivo.readAll());
+    if (!documento.isObject()) {
+        return -1;
+    }
+
+    std::map<std::string, double> base;
+    for (const QJsonValue& valor : documento.object()["resultados"].toArray()) {
+        const QJsonObject objeto = valor.toObject();
+        if (!objeto.contains("omitido")) {
+            base[objeto["nombre"].toString().toStdString()] = objeto["ns_por_op"].toDouble();
+        }
+    }
+
+    int regresiones = 0;
+    std::printf("\n%-44s %14s %14s %9s\n", "Comparación con la base", "base (ns)", "actual (ns)", "cambio");
+    for (const Resultado& r : banco.getResultados()) {
+        auto it = base.find(r.nombre);
+        if (!r.nota.empty() || it == base.end() || it->second <= 0.0) {
+            continue;
+        }
+        const double cambio = 100.0 * (r.nsPorOperacion - it->second) / it->second;
+        const bool regresion = cambio > umbral;
+        regresiones += regresion;
+        std::printf("%-44s %14.1f %14.1f %+8.1f%%%s\n", r.nombre.c_str(), it->second, r.nsPorOperacion,
+                    cambio, regresion ? "  REGRESIÓN" : "");
+    }
+    return regresiones;
+}
+
+bool leerOpciones(int argc, char* argv[], Opciones& opciones) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hayValor = i + 1 < argc;
+        if (arg == "--filtro" && hayValor) {
+            opciones.filtro = argv[++i];
+        } else if (arg == "--salida" && hayValor) {
+            opciones.salida = argv[++i];
+        } else if (arg == "--base" && hayValor) {
+            opciones.base = argv[++i];
+        } else if (arg == "--umbral" && hayValor) {
+            opciones.umbral = std::atof(argv[++i]);
+        } else if (arg == "--rapido") {
+            opciones.rapido = true;
+        } else if (arg == "--todo") {
+            opciones.todo = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Los mensajes de depuración del simulador ensucian la tabla de resultados
+void descartarMensajes(QtMsgType tipo, const QMessageLogContext&, const QString& mensaje) {
+    if (tipo != QtDebugMsg && tipo != QtInfoMsg) {
+        std::fprintf(stderr, "%s\n", mensaje.toLocal8Bit().constData());
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication aplicacion(argc, argv);  // El hilo de simulación necesita un bucle de eventos
+    qInstallMessageHandler(descartarMensajes);
+    std::clog.rdbuf(nullptr);  // Tampoco el registro asíncrono (escribe en std::clog)
+
+    Opciones opciones;
+    if (!leerOpciones(argc, argv, opciones)) {
+        std::fprintf(stderr, "Uso: %s [--filtro texto] [--salida resultados.json] [--base base.json] "
+                             "[--umbral %%] [--rapido] [--todo]\n", argv[0]);
+        return 2;
+    }
+#ifndef NDEBUG
+    std::printf("Aviso: compilado sin optimizaciones (use -DCMAKE_BUILD_TYPE=Release)\n\n");
+#endif
+
+    Banco banco(opciones);
+    microBenchmarks(banco);
+    macroBenchmarks(banco);
+
+    if (!opciones.salida.empty() && !guardarResultados(banco, opciones.salida)) {
+        std::fprintf(stderr, "No se pudo escribir %s\n", opciones.salida.c_str());
+        return 2;
+    }
+    if (!opciones.base.empty()) {
+        const int regresiones = compararConBase(banco, opciones.base, opciones.umbral);
+        if (regresiones < 0) {
+            std::fprintf(stderr, "No se pudo leer la base %s\n", opciones.base.c_str());
+            return 2;
+        }
+        if (regresiones > 0) {
+            std::printf("\n%d caso(s) más de %.1f%% más lentos que la base\n", regresiones, opciones.umbral);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,511 @@
+/**
+ * @file simulador_escalado.cpp
+ * @brief Estudio de escalado: costo del tick según agentes, área del mapa e hilos
+ *
+ * Hace tres barridos sobre planos generados (GeneradorEscenarios), cada uno
+ * variando un solo factor alrededor de un punto central:
+ *
+ *   agentes: 10 .. 1M en un mapa de 3163² (~10M celdas)
+ *   area:    100² .. 3163² con 1000 agentes
+ *   hilos:   1 .. núcleos disponibles con 100k agentes en 1000² (solo los
+ *            modos continuo y campo de piso usan el pool)
+ *
+ * Cada caso corre en un proceso hijo (el mismo ejecutable con --caso), así
+ * el pico de memoria es el del caso y un caso que no termina dentro del
+ * límite se corta sin perder el resto; los casos mayores del mismo barrido
+ * se omiten. De cada caso se informa ticks por segundo, milisegundos por
+ * tick, pico de memoria y, compilando con -DSIMULADOR_PERFILADO=ON, la
+ * mediana de cada fase del tick.
+ *
+ * Por cada barrido se ajusta el exponente k de tiempo ∝ xᵏ (mínimos
+ * cuadrados en escala log-log) y se muestra también el exponente local
+ * entre casos consecutivos: una fase que crece como O(n²) aparece con k ≈ 2.
+ *
+ * Uso:
+ *   simulador_escalado [--modos rejilla,continuo,campo_piso] [--plano salon]
+ *                      [--barridos agentes,area,hilos] [--csv escalado.csv]
+ *                      [--limite 120] [--rapido]
+ */
+
+#include <QCoreApplication>
+#include <QProcess>
+#include <QStringList>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/Simulador.h"
+#include "../include/FactoriaAgentes.h"
+#include "../include/GeneradorEscenarios.h"
+#include "../include/PerfiladorTick.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+const uint32_t SEMILLA = 12345;
+const char* const MARCA_RESULTADO = "RESULTADO";
+const char* const MARCA_OMITIDO = "OMITIDO";
+const size_t NUM_FASES = PerfiladorTick::NUM_FASES;
+
+// Nombres de columna del CSV (sin tildes ni espacios), en el orden de FaseTick
+const char* const CLAVES_FASE[NUM_FASES] = {
+    "busqueda_salida", "busqueda_ruta", "colisiones", "motor", "rescate",
+    "estadisticas", "eventos", "publicacion", "tick"
+};
+
+struct Opciones {
+    std::vector<ModoMovimiento> modos{ModoMovimiento::REJILLA, ModoMovimiento::CONTINUO, ModoMovimiento::CAMPO_PISO};
+    std::vector<std::string> barridos{"agentes", "area", "hilos"};
+    TipoPlano plano = TipoPlano::SALON;
+    std::string csv = "escalado.csv";
+    int limiteSegundos = 120;  // Por caso, incluida la preparación
+    bool rapido = false;
+};
+
+struct Caso {
+    std::string barrido;
+    ModoMovimiento modo;
+    TipoPlano plano;
+    int lado;
+    int agentes;
+    unsigned int hilos;
+};
+
+struct Medicion {
+    bool completa = false;
+    std::string nota;           // Por qué no se midió
+    int ticks = 0;
+    double nsPorTick = 0.0;     // Mediana
+    double picoMB = 0.0;        // Pico de memoria residente del proceso hijo
+    double preparacionS = 0.0;  // Generación, población y primer tick
+    double fasesUs[NUM_FASES];  // Mediana por fase; < 0 si no se midió
+
+    Medicion() { std::fill(fasesUs, fasesUs + NUM_FASES, -1.0); }
+};
+
+double ahoraS() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* nombreModo(ModoMovimiento modo) {
+    switch (modo) {
+        case ModoMovimiento::REJILLA: return "rejilla";
+        case ModoMovimiento::CONTINUO: return "continuo";
+        case ModoMovimiento::CAMPO_PISO: return "campo_piso";
+    }
+    return "";
+}
+
+bool modoDesdeNombre(const std::string& nombre, ModoMovimiento& modo) {
+    const ModoMovimiento modos[] = {ModoMovimiento::REJILLA, ModoMovimiento::CONTINUO, ModoMovimiento::CAMPO_PISO};
+    for (ModoMovimiento candidato : modos) {
+        if (nombre == nombreModo(candidato)) {
+            modo = candidato;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> separar(const std::string& texto, char separador) {
+    std::vector<std::string> partes;
+    std::stringstream ss(texto);
+    std::string parte;
+    while (std::getline(ss, parte, separador)) {
+        if (!parte.empty()) partes.push_back(parte);
+    }
+    return partes;
+}
+
+unsigned int hilosDisponibles() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Pico de memoria residente del proceso, en MB
+double picoMemoriaMB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS contadores;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &contadores, sizeof(contadores))) {
+        return static_cast<double>(contadores.PeakWorkingSetSize) / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#else
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+#if defined(__APPLE__)
+    return static_cast<double>(uso.ru_maxrss) / (1024.0 * 1024.0);  // Bytes
+#else
+    return static_cast<double>(uso.ru_maxrss) / 1024.0;  // KB
+#endif
+#endif
+}
+
+// ============================================================================
+// Proceso hijo: un caso
+// ============================================================================
+
+int ejecutarCaso(const Caso& caso, bool rapido) {
+    const double inicio = ahoraS();
+
+    Simulador simulador(nullptr, caso.hilos);
+    simulador.cargarEscenario(caso.lado, caso.lado);
+    simulador.setModoMovimiento(caso.modo);
+
+    GeneradorEscenarios generador(SEMILLA);
+    ParametrosPlano parametros;
+    parametros.tipo = caso.plano;
+    parametros.salidas = 8;
+    generador.generar(*simulador.getEscenario(), parametros);
+
+    FactoriaAgentes factoria;
+    const auto personas = generador.poblar(*simulador.getEscenario(), factoria, caso.agentes);
+    if (static_cast<int>(personas.size()) < caso.agentes) {
+        std::printf("%s no entran en el plano\n", MARCA_OMITIDO);
+        return 0;
+    }
+    for (const auto& persona : personas) {
+        simulador.agregarAgente(persona);
+    }
+
+    // El primer tick prepara rutas, campos e índices: cuenta como preparación
+    simulador.pasoUnico();
+    const double preparacion = ahoraS() - inicio;
+
+    const int maximoTicks = rapido ? 5 : 20;
+    const double presupuesto = rapido ? 2.0 : 10.0;
+    std::vector<double> ticks;
+    double total = 0.0;
+    while (static_cast<int>(ticks.size()) < maximoTicks && total < presupuesto &&
+           !simulador.estaTerminada()) {
+        const double t0 = ahoraS();
+        simulador.pasoUnico();
+        ticks.push_back(ahoraS() - t0);
+        total += ticks.back();
+    }
+    if (ticks.empty()) {
+        std::printf("%s terminó en el primer tick\n", MARCA_OMITIDO);
+        return 0;
+    }
+    std::sort(ticks.begin(), ticks.end());
+
+    std::printf("%s %zu %.1f %.1f %.3f", MARCA_RESULTADO, ticks.size(), ticks[ticks.size() / 2] * 1e9,
+                picoMemoriaMB(), preparacion);
+    for (size_t i = 0; i < NUM_FASES; ++i) {
+        const HistogramaHDR& h = simulador.getPerfilador().getHistograma(static_cast<FaseTick>(i));
+        std::printf(" %.3f", h.getCantidad() > 0 ? h.percentil(50) : -1.0);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+    return 0;
+}
+
+// ============================================================================
+// Proceso padre: barridos, reporte y CSV
+// ============================================================================
+
+Medicion medirEnHijo(const Caso& caso, const Opciones& opciones) {
+    QStringList argumentos;
+    argumentos << "--caso" << nombreModo(caso.modo) << GeneradorEscenarios::nombreTipo(caso.plano)
+               << QString::number(caso.lado) << QString::number(caso.agentes) << QString::number(caso.hilos);
+    if (opciones.rapido) {
+        argumentos << "--rapido";
+    }
+
+    Medicion medicion;
+    QProcess hijo;
+    hijo.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    hijo.start(QCoreApplication::applicationFilePath(), argumentos);
+    if (!hijo.waitForStarted()) {
+        medicion.nota = "no se pudo lanzar el proceso";
+        return medicion;
+    }
+    if (!hijo.waitForFinished(opciones.limiteSegundos * 1000)) {
+        hijo.kill();
+        hijo.waitForFinished();
+        medicion.nota = "más de " + std::to_string(opciones.limiteSegundos) + " s";
+        return medicion;
+    }
+
+    std::stringstream salida(hijo.readAllStandardOutput().toStdString());
+    std::string linea;
+    while (std::getline(salida, linea)) {
+        std::stringstream campos(linea);
+        std::string marca;
+        campos >> marca;
+        if (marca == MARCA_OMITIDO) {
+            std::getline(campos >> std::ws, medicion.nota);
+            return medicion;
+        }
+        if (marca == MARCA_RESULTADO) {
+            campos >> medicion.ticks >> medicion.nsPorTick >> medicion.picoMB >> medicion.preparacionS;
+            for (size_t i = 0; i < NUM_FASES; ++i) {
+                campos >> medicion.fasesUs[i];
+            }
+            medicion.completa = static_cast<bool>(campos);
+            if (!medicion.completa) medicion.nota = "salida ilegible";
+            return medicion;
+        }
+    }
+    medicion.nota = hijo.exitStatus() == QProcess::CrashExit ? "el proceso terminó con error"
+                                                              : "sin resultado";
+    return medicion;
+}
+
+/**
+ * @brief Pendiente de log(y) contra log(x) por mínimos cuadrados
+ * @return NAN con menos de dos puntos válidos
+ */
+double ajustarExponente(const std::vector<double>& x, const std::vector<double>& y) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    int n = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (x[i] <= 0 || y[i] <= 0) continue;
+        const double lx = std::log(x[i]);
+        const double ly = std::log(y[i]);
+        sx += lx; sy += ly; sxx += lx * lx; sxy += lx * ly;
+        ++n;
+    }
+    const double denominador = n * sxx - sx * sx;
+    if (n < 2 || denominador <= 0) return NAN;
+    return (n * sxy - sx * sy) / denominador;
+}
+
+double variable(const Caso& caso) {
+    if (caso.barrido == "agentes") return caso.agentes;
+    if (caso.barrido == "area") return static_cast<double>(caso.lado) * caso.lado;
+    return caso.hilos;
+}
+
+std::vector<Caso> armarBarrido(const std::string& barrido, ModoMovimiento modo, const Opciones& opciones) {
+    std::vector<Caso> casos;
+    const unsigned int hilos = hilosDisponibles();
+    if (barrido == "agentes") {
+        const int lado = opciones.rapido ? 1000 : 3163;
+        for (int n = 10; n <= (opciones.rapido ? 100000 : 1000000); n *= 10) {
+            casos.push_back(Caso{barrido, modo, opciones.plano, lado, n, hilos});
+        }
+    } else if (barrido == "area") {
+        const int lados[] = {100, 316, 1000, 3163};
+        for (int lado : lados) {
+            if (opciones.rapido && lado > 1000) break;
+            casos.push_back(Caso{barrido, modo, opciones.plano, lado, 1000, hilos});
+        }
+    } else if (barrido == "hilos" && modo != ModoMovimiento::REJILLA) {
+        for (unsigned int h = 1; ; h = std::min(h * 2, hilos)) {
+            casos.push_back(Caso{barrido, modo, opciones.plano, 1000, opciones.rapido ? 10000 : 100000, h});
+            if (h == hilos) break;
+        }
+    }
+    return casos;
+}
+
+std::string formatear(double valor, int decimales) {
+    if (!(valor > 0)) return "-";
+    char texto[32];
+    std::snprintf(texto, sizeof(texto), "%.*f", decimales, valor);
+    return texto;
+}
+
+std::string formatearExponente(double k) {
+    if (std::isnan(k)) return "-";
+    char texto[16];
+    std::snprintf(texto, sizeof(texto), "%+.2f", k);
+    return texto;
+}
+
+void escribirFilaCsv(std::ofstream& csv, const Caso& caso, const Medicion& m) {
+    csv << caso.barrido << ',' << nombreModo(caso.modo) << ',' << GeneradorEscenarios::nombreTipo(caso.plano) << ','
+        << caso.agentes << ',' << static_cast<long long>(caso.lado) * caso.lado << ',' << caso.hilos << ','
+        << (m.completa ? "ok" : "omitido") << ',' << m.ticks << ',';
+    if (m.completa) {
+        csv << m.nsPorTick / 1e6 << ',' << 1e9 / m.nsPorTick << ',' << m.picoMB << ',' << m.preparacionS;
+    } else {
+        csv << ",,,";
+    }
+    for (size_t i = 0; i < NUM_FASES; ++i) {
+        csv << ',';
+        if (m.completa && m.fasesUs[i] >= 0) csv << m.fasesUs[i];
+    }
+    csv << '\n';
+    csv.flush();
+}
+
+int ejecutarEstudio(const Opciones& opciones) {
+    std::ofstream csv(opciones.csv);
+    if (!csv) {
+        std::fprintf(stderr, "No se pudo escribir %s\n", opciones.csv.c_str());
+        return 2;
+    }
+    csv << "barrido,modo,plano,agentes,celdas,hilos,estado,ticks,ms_tick,ticks_por_s,pico_mb,preparacion_s";
+    for (const char* clave : CLAVES_FASE) {
+        csv << ",us_" << clave;
+    }
+    csv << '\n';
+
+#ifndef NDEBUG
+    std::printf("Aviso: compilado sin optimizaciones (use -DCMAKE_BUILD_TYPE=Release)\n");
+#endif
+    if (!PerfiladorTick::ACTIVO) {
+        std::printf("Aviso: sin -DSIMULADOR_PERFILADO=ON no hay tiempos por fase\n");
+    }
+    std::printf("Plano %s, límite %d s por caso, %u hilos disponibles\n\n",
+                GeneradorEscenarios::nombreTipo(opciones.plano), opciones.limiteSegundos, hilosDisponibles());
+    std::printf("%-8s %-11s %9s %10s %5s %10s %10s %8s %8s  %s\n", "Barrido", "Modo", "Agentes", "Celdas",
+                "Hilos", "Ticks/s", "ms/tick", "RSS MB", "k local", "Nota");
+
+    std::vector<std::string> resumen;
+    for (const std::string& barrido : opciones.barridos) {
+        for (ModoMovimiento modo : opciones.modos) {
+            const std::vector<Caso> casos = armarBarrido(barrido, modo, opciones);
+            if (casos.empty()) continue;
+
+            std::vector<double> x, t;
+            std::vector<std::vector<double>> fases(NUM_FASES);
+            const Medicion* anterior = nullptr;
+            const Caso* casoAnterior = nullptr;
+            std::vector<Medicion> mediciones;
+            mediciones.reserve(casos.size());
+            bool cortado = false;
+
+            for (const Caso& caso : casos) {
+                if (cortado) {
+                    mediciones.emplace_back();
+                    mediciones.back().nota = "omitido: el caso anterior superó el límite";
+                } else {
+                    mediciones.push_back(medirEnHijo(caso, opciones));
+                    cortado = mediciones.back().nota.rfind("más de", 0) == 0;
+                }
+                const Medicion& m = mediciones.back();
+
+                double kLocal = NAN;
+                if (m.completa && anterior && anterior->completa && variable(caso) != variable(*casoAnterior)) {
+                    kLocal = std::log(m.nsPorTick / anterior->nsPorTick) /
+                             std::log(variable(caso) / variable(*casoAnterior));
+                }
+                std::printf("%-8s %-11s %9d %10lld %5u %10s %10s %8s %8s  %s\n", barrido.c_str(), nombreModo(modo),
+                            caso.agentes, static_cast<long long>(caso.lado) * caso.lado, caso.hilos,
+                            formatear(m.completa ? 1e9 / m.nsPorTick : 0, 1).c_str(),
+                            formatear(m.nsPorTick / 1e6, 2).c_str(), formatear(m.picoMB, 0).c_str(),
+                            formatearExponente(kLocal).c_str(), m.nota.c_str());
+                std::fflush(stdout);
+                escribirFilaCsv(csv, caso, m);
+
+                if (m.completa) {
+                    x.push_back(variable(caso));
+                    t.push_back(m.nsPorTick);
+                    for (size_t i = 0; i < NUM_FASES; ++i) {
+                        fases[i].push_back(m.fasesUs[i]);
+                    }
+                    anterior = &m;
+                    casoAnterior = &caso;
+                }
+            }
+
+            // Exponente global y, si hay perfil, el de cada fase
+            std::string linea = barrido + " / " + nombreModo(modo) + ": k = " +
+                                formatearExponente(ajustarExponente(x, t));
+            for (size_t i = 0; i < NUM_FASES; ++i) {
+                const double k = ajustarExponente(x, fases[i]);
+                if (!std::isnan(k) && static_cast<FaseTick>(i) != FaseTick::TICK) {
+                    linea += std::string(", ") + CLAVES_FASE[i] + " " + formatearExponente(k);
+                }
+            }
+            resumen.push_back(linea);
+        }
+    }
+
+    std::printf("\nExponentes ajustados (tiempo por tick ∝ xᵏ; en hilos lo ideal es k = -1):\n");
+    for (const std::string& linea : resumen) {
+        std::printf("  %s\n", linea.c_str());
+    }
+    std::printf("\nCSV: %s\n", opciones.csv.c_str());
+    return 0;
+}
+
+// ============================================================================
+// Opciones
+// ============================================================================
+
+bool leerOpciones(int argc, char* argv[], Opciones& opciones, bool& esCaso, Caso& caso) {
+    esCaso = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hayValor = i + 1 < argc;
+        if (arg == "--caso" && i + 5 < argc) {
+            esCaso = true;
+            caso.barrido.clear();
+            if (!modoDesdeNombre(argv[i + 1], caso.modo) ||
+                !GeneradorEscenarios::tipoDesdeNombre(argv[i + 2], caso.plano)) {
+                return false;
+            }
+            caso.lado = std::atoi(argv[i + 3]);
+            caso.agentes = std::atoi(argv[i + 4]);
+            caso.hilos = static_cast<unsigned int>(std::atoi(argv[i + 5]));
+            i += 5;
+        } else if (arg == "--modos" && hayValor) {
+            opciones.modos.clear();
+            for (const std::string& nombre : separar(argv[++i], ',')) {
+                ModoMovimiento modo;
+                if (!modoDesdeNombre(nombre, modo)) return false;
+                opciones.modos.push_back(modo);
+            }
+        } else if (arg == "--barridos" && hayValor) {
+            opciones.barridos = separar(argv[++i], ',');
+            for (const std::string& barrido : opciones.barridos) {
+                if (barrido != "agentes" && barrido != "area" && barrido != "hilos") return false;
+            }
+        } else if (arg == "--plano" && hayValor) {
+            if (!GeneradorEscenarios::tipoDesdeNombre(argv[++i], opciones.plano)) return false;
+        } else if (arg == "--csv" && hayValor) {
+            opciones.csv = argv[++i];
+        } else if (arg == "--limite" && hayValor) {
+            opciones.limiteSegundos = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--rapido") {
+            opciones.rapido = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Los mensajes de depuración del simulador ensucian la tabla
+void descartarMensajes(QtMsgType tipo, const QMessageLogContext&, const QString& mensaje) {
+    if (tipo != QtDebugMsg && tipo != QtInfoMsg) {
+        std::fprintf(stderr, "%s\n", mensaje.toLocal8Bit().constData());
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication aplicacion(argc, argv);  // El hilo de simulación necesita un bucle de eventos
+    qInstallMessageHandler(descartarMensajes);
+    std::clog.rdbuf(nullptr);  // Tampoco el registro asíncrono (escribe en std::clog)
+
+    Opciones opciones;
+    Caso caso;
+    bool esCaso = false;
+    if (!leerOpciones(argc, argv, opciones, esCaso, caso)) {
+        std::fprintf(stderr, "Uso: %s [--modos rejilla,continuo,campo_piso] [--plano salon] "
+                             "[--barridos agentes,area,hilos] [--csv escalado.csv] [--limite s] [--rapido]\n",
+                     argv[0]);
+        return 2;
+    }
+    return esCaso ? ejecutarCaso(caso, opciones.rapido) : ejecutarEstudio(opciones);
+}
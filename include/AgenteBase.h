@@ -1,10 +1,14 @@
 #ifndef AGENTEBASE_H
 #define AGENTEBASE_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
-#include <QPoint>
+#include "BusEventos.h"
+#include "Posicion.h"
 
 /**
  * @brief Enumeración para los diferentes estados de un agente
@@ -27,10 +31,40 @@ enum class TipoComportamiento {
     RESCATISTA
 };
 
-typedef QPoint Posicion;
+/**
+ * @brief Clase concreta de un agente (jerarquía cerrada)
+ *
+ * Permite distinguir Persona de Rescatista con una comparación en lugar de
+ * dynamic_cast; ver comoAgente().
+ */
+enum class TipoAgente : uint8_t {
+    PERSONA,
+    RESCATISTA
+};
+
+/**
+ * @brief Cantidad de agentes en cada estado
+ *
+ * La mantienen los propios agentes: cada cambio de estado pasa una unidad de
+ * un contador a otro, así que contar no requiere recorrer a los agentes.
+ */
+struct ConteoEstados {
+    static constexpr size_t NUM_ESTADOS = 5;
+    std::atomic<int> porEstado[NUM_ESTADOS];
 
-// Forward declaration para el patrón Observer
-class ObservadorEvento;
+    ConteoEstados() {
+        for (auto& contador : porEstado) {
+            contador.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    int get(EstadoAgente estado) const {
+        return porEstado[static_cast<size_t>(estado)].load(std::memory_order_relaxed);
+    }
+    void sumar(EstadoAgente estado, int cantidad) {
+        porEstado[static_cast<size_t>(estado)].fetch_add(cantidad, std::memory_order_relaxed);
+    }
+};
 
 /**
  * @brief Clase abstracta base para todos los agentes en la simulación
@@ -46,17 +80,23 @@ protected:
     double velocidad;
     EstadoAgente estado;
     TipoComportamiento tipoComportamiento;
+    TipoAgente tipoAgente;
     std::vector<Posicion> ruta;
     int indiceRutaActual;
     
-    // Para el patrón Observer
-    std::vector<std::weak_ptr<ObservadorEvento>> observadores;
+    // Para el patrón Observer: los eventos se publican en el bus del simulador
+    BusEventos* bus;
+
+    // Contadores por estado del simulador (nullptr fuera de una simulación)
+    ConteoEstados* conteoEstados;
+
+    void cambiarEstado(EstadoAgente nuevoEstado);
     
 public:
     /**
      * @brief Constructor de la clase base
      */
-    AgenteBase(int id, Posicion posInicial, double velocidad, TipoComportamiento tipo);
+    AgenteBase(int id, Posicion posInicial, double velocidad, TipoComportamiento tipo, TipoAgente tipoAgente);
     
     /**
      * @brief Destructor virtual para permitir polimorfismo
@@ -107,6 +147,7 @@ public:
     double getVelocidad() const { return velocidad; }
     EstadoAgente getEstado() const { return estado; }
     TipoComportamiento getTipoComportamiento() const { return tipoComportamiento; }
+    TipoAgente getTipoAgente() const { return tipoAgente; }
     
     // Setters
     void setPosicion(const Posicion& pos) { posicion = pos; }
@@ -114,8 +155,35 @@ public:
     void setVelocidad(double nuevaVelocidad) { velocidad = nuevaVelocidad; }
     
     // Métodos para el patrón Observer
-    void agregarObservador(std::weak_ptr<ObservadorEvento> observador);
-    void notificarEvento(const std::string& evento);
+    void setBusEventos(BusEventos* nuevoBus) { bus = nuevoBus; }
+
+    /**
+     * @brief Se da de alta en los contadores (y de baja de los anteriores)
+     */
+    void setConteoEstados(ConteoEstados* conteo);
+    void notificarEvento(TipoEvento evento, int32_t dato = -1);
 };
 
+/**
+ * @brief Conversión a la clase concreta T (Persona o Rescatista) sin RTTI
+ * @return nullptr si el agente no es de esa clase
+ *
+ * Cada clase concreta declara su TipoAgente en T::TIPO y es final, así que
+ * comparar la etiqueta basta para que static_cast sea seguro.
+ */
+template <typename T>
+T* comoAgente(AgenteBase* agente) {
+    return agente && agente->getTipoAgente() == T::TIPO ? static_cast<T*>(agente) : nullptr;
+}
+
+template <typename T>
+const T* comoAgente(const AgenteBase* agente) {
+    return agente && agente->getTipoAgente() == T::TIPO ? static_cast<const T*>(agente) : nullptr;
+}
+
+template <typename T>
+std::shared_ptr<T> comoAgente(const std::shared_ptr<AgenteBase>& agente) {
+    return agente && agente->getTipoAgente() == T::TIPO ? std::static_pointer_cast<T>(agente) : nullptr;
+}
+
 #endif // AGENTEBASE_H
@@ -0,0 +1,174 @@
+#ifndef ARCHIVOCOLUMNAR_H
+#define ARCHIVOCOLUMNAR_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <QFile>
+#include <QString>
+
+/**
+ * @brief Tipo de los valores de una columna
+ */
+enum class TipoColumna : uint8_t {
+    ENTERO32 = 0,  // int32_t
+    REAL64 = 1,    // double
+    BYTE = 2       // uint8_t (categorías)
+};
+
+/**
+ * @brief Cómo se guardan los valores de una columna en cada grupo
+ */
+enum class CompresionColumna : uint8_t {
+    PLANA = 0,  // Valores tal cual: el lector los puede usar sin copiarlos
+    DELTA = 1,  // Diferencia con el anterior en zigzag + varint (solo ENTERO32)
+    RLE = 2     // Corridas: varint(repeticiones) + valor
+};
+
+struct DefinicionColumna {
+    std::string nombre;
+    TipoColumna tipo;
+    CompresionColumna compresion;
+};
+
+template <typename T> struct TipoColumnaDe;
+template <> struct TipoColumnaDe<int32_t> { static constexpr TipoColumna valor = TipoColumna::ENTERO32; };
+template <> struct TipoColumnaDe<double> { static constexpr TipoColumna valor = TipoColumna::REAL64; };
+template <> struct TipoColumnaDe<uint8_t> { static constexpr TipoColumna valor = TipoColumna::BYTE; };
+
+/**
+ * @brief Escribe una tabla en formato columnar binario
+ *
+ * Formato (little-endian):
+ * - Cabecera: "COLS", versión y el esquema (tipo, compresión y nombre de
+ *   cada columna), de modo que el archivo se describe solo.
+ * - Grupos de hasta filasPorGrupo filas. Dentro de un grupo cada columna es
+ *   un fragmento contiguo, comprimido por separado y alineado a 8 bytes.
+ * - Índice: filas de cada grupo y offset y tamaño de cada fragmento,
+ *   seguido de un epílogo de tamaño fijo que indica dónde empieza.
+ *
+ * Los valores se agregan columna por columna y terminarFila() cierra la fila.
+ */
+class EscritorColumnas {
+public:
+    static constexpr uint32_t FILAS_POR_GRUPO = 1 << 16;
+
+    explicit EscritorColumnas(uint32_t filasPorGrupo = FILAS_POR_GRUPO);
+    ~EscritorColumnas();
+
+    EscritorColumnas(const EscritorColumnas&) = delete;
+    EscritorColumnas& operator=(const EscritorColumnas&) = delete;
+
+    bool abrir(const std::string& ruta, const std::vector<DefinicionColumna>& esquema);
+
+    void agregarEntero(size_t columna, int32_t valor) { agregar(columna, valor); }
+    void agregarReal(size_t columna, double valor) { agregar(columna, valor); }
+    void agregarByte(size_t columna, uint8_t valor) { agregar(columna, valor); }
+    void terminarFila();
+
+    /**
+     * @brief Escribe el último grupo, el índice y el epílogo
+     * @return false si hubo un error de escritura
+     */
+    bool cerrar();
+
+    bool estaAbierto() const { return archivo.is_open(); }
+
+private:
+    std::ofstream archivo;
+    uint32_t filasPorGrupo;
+    std::vector<DefinicionColumna> esquema;
+    std::vector<std::vector<uint8_t>> valores;  // Valores sin comprimir del grupo actual
+    std::vector<uint8_t> fragmento;
+    uint32_t filasGrupo;
+    uint64_t totalFilas;
+    uint64_t posicion;
+
+    struct Fragmento {
+        uint64_t offset;
+        uint64_t bytes;
+    };
+    std::vector<uint32_t> filasPorGrupoEscrito;
+    std::vector<Fragmento> indice;  // numGrupos * numColumnas
+
+    template <typename T>
+    void agregar(size_t columna, T valor) {
+        if (columna < valores.size() && esquema[columna].tipo == TipoColumnaDe<T>::valor) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&valor);
+            valores[columna].insert(valores[columna].end(), bytes, bytes + sizeof(T));
+        }
+    }
+    void escribirGrupo();
+    void escribir(const std::vector<uint8_t>& bytes);
+};
+
+/**
+ * @brief Lee un archivo columnar mapeado en memoria
+ *
+ * Solo se toca el fragmento de la columna y el grupo pedidos: recorrer una
+ * columna no lee ni decodifica las demás. Las columnas PLANA se ven
+ * directamente sobre el mapeo, sin copias (vista()).
+ */
+class LectorColumnas {
+public:
+    LectorColumnas();
+    ~LectorColumnas();
+
+    bool abrir(const QString& ruta);
+    void cerrar();
+
+    size_t getNumColumnas() const { return columnas.size(); }
+    const DefinicionColumna& getColumna(size_t columna) const { return columnas[columna]; }
+    int buscarColumna(const std::string& nombre) const;  // -1 si no existe
+
+    uint64_t getNumFilas() const { return numFilas; }
+    size_t getNumGrupos() const { return filasGrupo.size(); }
+    uint32_t getFilasGrupo(size_t grupo) const { return filasGrupo[grupo]; }
+
+    /**
+     * @brief Valores de una columna PLANA en un grupo, sin copiarlos
+     * @return nullptr si el tipo no coincide o la columna está comprimida
+     */
+    template <typename T>
+    const T* vista(size_t columna, size_t grupo) const {
+        if (columna >= columnas.size() || grupo >= filasGrupo.size() ||
+            columnas[columna].tipo != TipoColumnaDe<T>::valor ||
+            columnas[columna].compresion != CompresionColumna::PLANA) {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(datos + fragmento(columna, grupo).offset);
+    }
+
+    /**
+     * @brief Decodifica una columna de un grupo (o la copia si es PLANA)
+     * @return false si el tipo no coincide o el fragmento está dañado
+     */
+    bool leer(size_t columna, size_t grupo, std::vector<int32_t>& destino) const;
+    bool leer(size_t columna, size_t grupo, std::vector<double>& destino) const;
+    bool leer(size_t columna, size_t grupo, std::vector<uint8_t>& destino) const;
+
+private:
+    struct Fragmento {
+        uint64_t offset;
+        uint64_t bytes;
+    };
+
+    QFile archivo;
+    const uchar* datos;
+    qint64 tamano;
+
+    std::vector<DefinicionColumna> columnas;
+    std::vector<uint32_t> filasGrupo;
+    std::vector<Fragmento> indice;
+    uint64_t numFilas;
+
+    const Fragmento& fragmento(size_t columna, size_t grupo) const {
+        return indice[grupo * columnas.size() + columna];
+    }
+
+    template <typename T>
+    bool decodificar(size_t columna, size_t grupo, std::vector<T>& destino) const;
+};
+
+#endif // ARCHIVOCOLUMNAR_H
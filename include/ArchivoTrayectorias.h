@@ -0,0 +1,130 @@
+#ifndef ARCHIVOTRAYECTORIAS_H
+#define ARCHIVOTRAYECTORIAS_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <QFile>
+#include <QString>
+#include "Escenario.h"
+#include "FrameAgentes.h"
+
+/**
+ * @brief Graba la trayectoria de una simulación en un archivo binario
+ *
+ * Formato (little-endian):
+ * - Cabecera: "TRAY", versión, filas, columnas, intervalo de keyframes,
+ *   segundos por tick y el grid del escenario (un byte por celda).
+ * - Un bloque por tick: tick, tipo (keyframe o delta), cantidad de registros
+ *   y los registros. Un keyframe contiene a todos los agentes; un delta solo
+ *   a los que cambiaron o desaparecieron.
+ * - Índice de keyframes (tick -> offset) seguido de un epílogo de tamaño fijo
+ *   que indica dónde empieza el índice.
+ */
+class GrabadorTrayectorias {
+public:
+    explicit GrabadorTrayectorias(uint32_t intervaloKeyframe = 32);
+    ~GrabadorTrayectorias();
+
+    /**
+     * @brief Crea el archivo y escribe la cabecera con el grid actual
+     */
+    bool abrir(const std::string& ruta, const Escenario& escenario, double segundosPorTick);
+
+    /**
+     * @brief Registra el estado de los agentes en un tick (ticks crecientes)
+     */
+    void registrarTick(uint32_t tick, const std::vector<InstantaneaAgente>& agentes);
+
+    /**
+     * @brief Escribe el índice y el epílogo y cierra el archivo
+     */
+    void cerrar();
+
+    bool estaAbierto() const { return archivo.is_open(); }
+
+private:
+    struct UltimoRegistro {
+        InstantaneaAgente instantanea;
+        uint32_t tickVisto;
+    };
+
+    std::ofstream archivo;
+    uint32_t intervaloKeyframe;
+    uint32_t ticksDesdeKeyframe;
+    uint32_t primerTick;
+    uint32_t ultimoTick;
+    bool hayTicks;
+
+    std::vector<std::pair<uint32_t, uint64_t>> indiceKeyframes;
+    std::unordered_map<int32_t, UltimoRegistro> ultimosRegistros;
+    std::vector<InstantaneaAgente> registros;
+    std::vector<InstantaneaAgente> eliminados;
+    std::vector<char> buffer;
+};
+
+/**
+ * @brief Lee un archivo de trayectorias mapeado en memoria
+ *
+ * Para mostrar un tick se busca en el índice el keyframe anterior y solo se
+ * decodifican los deltas que hay entre ese keyframe y el tick pedido, por lo
+ * que saltar a cualquier punto de la grabación cuesta lo mismo.
+ */
+class LectorTrayectorias {
+public:
+    LectorTrayectorias();
+    ~LectorTrayectorias();
+
+    bool abrir(const QString& ruta);
+    void cerrar();
+
+    /**
+     * @brief Reconstruye el estado de los agentes en el tick indicado
+     * @return false si el tick está fuera de la grabación o el bloque está dañado
+     */
+    bool decodificarFrame(uint32_t tick, FrameAgentes& frame);
+
+    /**
+     * @brief Crea un escenario con el grid grabado en la cabecera
+     */
+    std::unique_ptr<Escenario> crearEscenario() const;
+
+    int getFilas() const { return filas; }
+    int getColumnas() const { return columnas; }
+    uint32_t getPrimerTick() const { return primerTick; }
+    uint32_t getUltimoTick() const { return ultimoTick; }
+    double getSegundosPorTick() const { return segundosPorTick; }
+
+private:
+    QFile archivo;
+    const uchar* datos;
+    qint64 tamano;
+
+    int filas;
+    int columnas;
+    double segundosPorTick;
+    uint64_t offsetGrid;
+    uint64_t offsetBloques;
+    uint64_t offsetIndice;
+    uint32_t numKeyframes;
+    uint32_t primerTick;
+    uint32_t ultimoTick;
+
+    // Estado decodificado del último tick pedido (permite avanzar sin volver al keyframe)
+    std::unordered_map<int32_t, InstantaneaAgente> estadoActual;
+    uint64_t offsetSiguiente;
+    uint32_t tickDecodificado;
+    uint32_t keyframeDecodificado;
+    bool hayEstado;
+
+    uint32_t tickKeyframe(uint32_t i) const;
+    uint64_t offsetKeyframe(uint32_t i) const;
+    // Aplica el bloque en 'offset' al estado y deja en 'siguiente' dónde empieza
+    // el próximo; false si el bloque no cabe entero antes del índice
+    bool aplicarBloque(uint64_t offset, uint64_t& siguiente);
+};
+
+#endif // ARCHIVOTRAYECTORIAS_H
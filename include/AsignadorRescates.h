@@ -0,0 +1,87 @@
+#ifndef ASIGNADORRESCATES_H
+#define ASIGNADORRESCATES_H
+
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "IndiceEspacial.h"
+
+class Persona;
+class Rescatista;
+
+/**
+ * @brief Reparte a la vez a todos los rescatistas libres entre las personas que necesitan ayuda
+ *
+ * Resuelve la asignación con el algoritmo de subasta de Bertsekas sobre un
+ * conjunto disperso de candidatos: cada rescatista solo puja por sus
+ * CANDIDATOS_POR_RESCATISTA personas más cercanas (consultadas en el
+ * IndiceEspacial, a cualquier distancia). El valor de una persona es
+ * alcance - distancia, con un alcance mayor que cualquier distancia del mapa,
+ * y no asignar a nadie vale 0: el resultado asigna a todas las que puede y
+ * minimiza (con tolerancia EPSILON por rescatista) la distancia total
+ * recorrida en lugar de dejar que el primero tome a la más cercana y los
+ * demás se queden sin nadie. Nadie puja por la persona que antes le resultó
+ * inalcanzable.
+ *
+ * La subasta se corta al agotar el presupuesto de tiempo. Lo asignado hasta
+ * ese momento vale; los precios se guardan y la subasta continúa con ellos en
+ * la siguiente llamada.
+ */
+class AsignadorRescates {
+public:
+    static constexpr size_t CANDIDATOS_POR_RESCATISTA = 8;
+    static constexpr double EPSILON = 0.05;             // celdas
+    static constexpr double PRESUPUESTO_MS = 1.0;
+
+    struct Asignacion {
+        std::shared_ptr<Rescatista> rescatista;
+        std::shared_ptr<Persona> persona;
+    };
+
+    AsignadorRescates();
+
+    /**
+     * @brief Asigna a los rescatistas que no están asistiendo a nadie
+     *
+     * No modifica rescatistas ni índice: quien llama aplica el resultado.
+     */
+    const std::vector<Asignacion>& asignar(const std::vector<std::shared_ptr<Rescatista>>& rescatistas,
+                                           const IndiceEspacial& indice);
+
+    void limpiar();
+
+    // Resultado de la última llamada
+    bool getCompleta() const { return completa; }
+    size_t getPujas() const { return pujas; }
+
+private:
+    struct Candidato {
+        int objeto;
+        double valor;
+    };
+
+    // Problema de la llamada en curso (reutilizado entre llamadas)
+    std::vector<std::shared_ptr<Rescatista>> postores;
+    std::vector<size_t> inicioCandidatos;          // postores.size() + 1
+    std::vector<Candidato> candidatos;
+    std::vector<std::shared_ptr<Persona>> objetos;
+    std::vector<double> precios;
+    std::vector<int> duenos;                        // Postor que tiene cada objeto, -1 = ninguno
+    std::unordered_map<int, int> objetoPorPersona;  // id de persona -> objeto
+    std::vector<std::pair<double, std::shared_ptr<Persona>>> cercanas;
+
+    // Precios que quedaron de una subasta cortada (id de persona -> precio)
+    std::unordered_map<int, double> preciosPendientes;
+
+    std::vector<Asignacion> asignaciones;
+    bool completa;
+    size_t pujas;
+
+    void construirCandidatos(const std::vector<std::shared_ptr<Rescatista>>& rescatistas,
+                             const IndiceEspacial& indice);
+    bool subastar(std::chrono::steady_clock::time_point limite);
+};
+
+#endif // ASIGNADORRESCATES_H
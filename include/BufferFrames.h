@@ -0,0 +1,64 @@
+#ifndef BUFFERFRAMES_H
+#define BUFFERFRAMES_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "FrameAgentes.h"
+#include "ResumenEstadisticas.h"
+
+/**
+ * @brief Instantánea inmutable de un tick para la interfaz
+ *
+ * Contiene los agentes visibles y los contadores del panel, de modo que la
+ * GUI no necesita tocar el modelo mientras el hilo de simulación avanza.
+ */
+struct FrameSimulacion : FrameAgentes {
+    ResumenEstadisticas estadisticas;
+};
+
+/**
+ * @brief Triple buffer sin bloqueos entre el hilo de simulación y la GUI
+ *
+ * El escritor llena siempre su propio frame y lo publica intercambiándolo con
+ * el frame intermedio; el lector toma el intermedio solo si hay uno nuevo.
+ * Ninguno de los dos espera al otro: si la GUI va más lenta que la simulación
+ * los frames intermedios se descartan, y si va más rápida sigue mostrando el
+ * último. Un único escritor y un único lector.
+ */
+class BufferFrames {
+public:
+    BufferFrames();
+
+    /**
+     * @brief Frame que el escritor puede modificar (reutiliza su memoria)
+     */
+    FrameSimulacion& escritura() { return frames[indiceEscritura]; }
+
+    /**
+     * @brief Hace visible al lector el frame de escritura
+     */
+    void publicar();
+
+    /**
+     * @brief Toma el último frame publicado
+     * @return true si había un frame nuevo desde la última lectura
+     */
+    bool leer();
+
+    /**
+     * @brief Último frame tomado por el lector (válido hasta el siguiente leer())
+     */
+    const FrameSimulacion& lectura() const { return frames[indiceLectura]; }
+
+private:
+    static constexpr uint8_t MASCARA_INDICE = 0x3;
+    static constexpr uint8_t BIT_NUEVO = 0x4;
+
+    std::array<FrameSimulacion, 3> frames;
+    std::atomic<uint8_t> intermedio;  // Índice del frame intermedio | BIT_NUEVO
+    uint8_t indiceEscritura;
+    uint8_t indiceLectura;
+};
+
+#endif // BUFFERFRAMES_H
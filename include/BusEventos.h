@@ -0,0 +1,105 @@
+#ifndef BUSEVENTOS_H
+#define BUSEVENTOS_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Eventos que pueden emitir los agentes
+ */
+enum class TipoEvento : uint8_t {
+    INICIO_EVACUACION,
+    EVACUANDO,
+    PANICO,
+    EVACUADO,
+    BLOQUEADO,
+    EVACUACION_EXITOSA,
+    OBSTACULO_ENCONTRADO,
+    RESCATISTA_OBSTACULO,
+    ASISTIENDO_PERSONA,
+    PERSONA_LIBERADA,
+    NUM_TIPOS
+};
+
+/**
+ * @brief Nombre del evento (para reportes y registros)
+ */
+const char* nombreEvento(TipoEvento tipo);
+
+/**
+ * @brief Evento de tamaño fijo, sin punteros al modelo
+ */
+struct Evento {
+    TipoEvento tipo;
+    uint32_t tick;
+    int32_t agenteId;
+    int32_t fila;
+    int32_t columna;
+    int32_t dato;  // Depende del tipo (p. ej. la persona asistida); -1 si no aplica
+};
+
+/**
+ * @brief Bus de eventos tipado y por lotes
+ *
+ * publicar() solo agrega el evento al búfer del hilo que llama (sin
+ * comparar cadenas, sin E/S y sin reservar memoria una vez que el búfer
+ * alcanzó su tamaño de trabajo). despachar() vacía todos los búferes una
+ * vez por tick y entrega cada evento a los suscriptores de su tipo.
+ *
+ * despachar() y suscribir() no deben correr a la vez que un publicar() de
+ * otro hilo: el simulador despacha entre dos fases, con los hilos de
+ * trabajo detenidos. Los suscriptores corren en el hilo que despacha.
+ */
+class BusEventos {
+public:
+    typedef std::function<void(const Evento&)> Suscriptor;
+
+    BusEventos();
+
+    BusEventos(const BusEventos&) = delete;
+    BusEventos& operator=(const BusEventos&) = delete;
+
+    void suscribir(TipoEvento tipo, Suscriptor suscriptor);
+    void limpiarSuscripciones();
+
+    /**
+     * @brief Tick que se anota en los eventos publicados a partir de ahora
+     */
+    void setTick(uint32_t tick) { tickActual.store(tick, std::memory_order_relaxed); }
+
+    void publicar(TipoEvento tipo, int32_t agenteId, int32_t fila, int32_t columna, int32_t dato = -1);
+
+    /**
+     * @brief Entrega los eventos pendientes y vacía los búferes (conservan su capacidad)
+     * @return Cantidad de eventos entregados
+     */
+    size_t despachar();
+
+    /**
+     * @brief Descarta los eventos pendientes sin entregarlos
+     */
+    void descartar();
+
+private:
+    struct BufferHilo {
+        std::thread::id hilo;  // Único hilo que escribe en él
+        std::vector<Evento> eventos;
+    };
+
+    static constexpr size_t CAPACIDAD_INICIAL = 4096;
+
+    const uint64_t identificador;  // Distingue buses aunque reutilicen dirección
+    std::atomic<uint32_t> tickActual;
+    std::mutex mutexBuferes;
+    std::vector<std::unique_ptr<BufferHilo>> buferes;
+    std::vector<Suscriptor> suscriptores[static_cast<size_t>(TipoEvento::NUM_TIPOS)];
+
+    BufferHilo& bufferDelHilo();
+};
+
+#endif // BUSEVENTOS_H
@@ -0,0 +1,55 @@
+#ifndef CAMPODISTANCIAS_H
+#define CAMPODISTANCIAS_H
+
+#include <limits>
+#include <vector>
+#include "Escenario.h"
+
+/**
+ * @brief Distancia de cada celda a la salida más cercana
+ *
+ * Se calcula una sola vez por mapa con un Dijkstra multi-origen desde todas
+ * las salidas (8 vecinos, diagonales de costo √2 sin atravesar esquinas de
+ * pared). Reemplaza, para los motores de movimiento en masa, la búsqueda de
+ * salida y de ruta por agente: la dirección deseada de cualquier agente es
+ * una consulta O(1).
+ */
+class CampoDistancias {
+public:
+    static constexpr float INALCANZABLE = std::numeric_limits<float>::max();
+
+    CampoDistancias();
+
+    void calcular(const Escenario& escenario);
+    void limpiar();
+
+    bool vacio() const { return distancias.empty(); }
+    int getFilas() const { return filas; }
+    int getColumnas() const { return columnas; }
+
+    /**
+     * @brief Distancia (en celdas) a la salida más cercana; INALCANZABLE si no hay camino
+     */
+    float getDistancia(int fila, int col) const;
+
+    /**
+     * @brief Dirección unitaria hacia la salida (hacia el vecino más cercano a ella)
+     */
+    void getDireccion(int fila, int col, float& dirFila, float& dirColumna) const;
+
+    /**
+     * @brief Dirección interpolada en una posición continua (x = fila, y = columna)
+     */
+    void getDireccionInterpolada(float x, float y, float& dirFila, float& dirColumna) const;
+
+    const std::vector<float>& getDistancias() const { return distancias; }
+
+private:
+    int filas;
+    int columnas;
+    std::vector<float> distancias;        // fila * columnas + columna
+    std::vector<float> direccionesFila;
+    std::vector<float> direccionesColumna;
+};
+
+#endif // CAMPODISTANCIAS_H
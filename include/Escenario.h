@@ -1,11 +1,15 @@
 #ifndef ESCENARIO_H
 #define ESCENARIO_H
 
+#include <cstdint>
 #include <vector>
-#include <QPoint>
+#include "Posicion.h"
 
 class Escenario {
 public:
+    // Lado máximo: Posicion guarda cada coordenada en 16 bits
+    static constexpr int LADO_MAXIMO = 32767;
+
     int filas;
     int columnas;
     bool puedeEvacuar(int x, int y);
@@ -16,7 +20,17 @@ public:
     void setCelda(int x, int y, int tipo);
     bool esTransitable(int x, int y);
     bool esSalida(int x, int y);
-    QPoint getSalidaMasCercana(QPoint origen);
+    Posicion getSalidaMasCercana(Posicion origen);
+
+    // Copia un mapa completo (fila * columnas + columna) de una vez; cuenta como un solo cambio
+    void reemplazarCeldas(const std::vector<uint8_t>& celdas);
+
+    // Se incrementa con cada cambio del mapa (permite detectar ediciones).
+    // El mapa del simulador solo se modifica en su hilo (Simulador::editarCelda)
+    unsigned int getVersion() const { return version; }
+
+private:
+    unsigned int version;
 };
 
 #endif
@@ -1,22 +1,57 @@
 #ifndef ESTADISTICASSIMULACION_H
 #define ESTADISTICASSIMULACION_H
 
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <memory>
-#include <QPoint>  // Qt Core
 #include "AgenteBase.h"
+#include "SerieDensidad.h"
+#include "HistogramaHDR.h"
+#include "ResumenEstadisticas.h"
+
+/**
+ * @brief Caja de celdas [filaMin, filaMax] x [columnaMin, columnaMax]
+ */
+struct ZonaCeldas {
+    int filaMin = 0, columnaMin = 0;
+    int filaMax = -1, columnaMax = -1;  // Por defecto, vacía
+
+    bool esVacia() const { return filaMax < filaMin || columnaMax < columnaMin; }
+};
 
 /**
  * @brief Estructura que almacena información sobre un evento de evacuación
  */
 struct EventoEvacuacion {
     int agenteId;
-    std::string tipoAgente;  // "Persona" o "Rescatista"
-    QPoint salida;           // Posición de la salida utilizada
-    double tiempoEvacuacion; // Tiempo en segundos que tardó en evacuar
-    int pasosRealizados;     // Número de pasos/movimientos
+    TipoAgente tipoAgente;
+    Posicion salida;           // Posición de la salida utilizada
+    double tiempoEvacuacion;   // Tiempo en segundos que tardó en evacuar
+    int pasosRealizados;       // Número de pasos/movimientos
+    double distanciaRecorrida; // Celdas recorridas (suma de los pasos)
+    ZonaCeldas zonaRecorrida;  // Caja que contiene la trayectoria
+};
+
+/**
+ * @brief Resumen incremental de la trayectoria de un agente activo
+ *
+ * Reemplaza a guardar cada celda visitada: ocupa lo mismo sin importar
+ * cuánto dure la simulación.
+ */
+struct AcumuladorTrayectoria {
+    Posicion ultima;
+    double distancia = 0.0;
+    int pasos = 0;
+    int filaMin = 0, filaMax = 0;
+    int columnaMin = 0, columnaMax = 0;
+    uint32_t tickLlegada = 0;  // Tick en que llegó a la celda actual
+
+    void iniciar(Posicion origen, uint32_t tick);
+    void agregar(Posicion hasta);
 };
 
 /**
@@ -28,6 +63,9 @@ struct EstadisticasGlobales {
     double tiempoPromedioEvacuacion;
     double tiempoMinimoEvacuacion;
     double tiempoMaximoEvacuacion;
+    double tiempoP50Evacuacion;
+    double tiempoP95Evacuacion;
+    double tiempoP99Evacuacion;
     
     // Contadores generales
     int totalAgentes;
@@ -37,8 +75,10 @@ struct EstadisticasGlobales {
     int rescatistasEvacuados;
     
     // Métricas por salida
+    // Se llenan en calcularEstadisticas() a partir de los contadores por celda
     std::map<std::string, int> personasPorSalida;  // "x,y" -> cantidad
     std::map<std::string, double> tiempoPromedioSalida;
+    std::map<std::string, double> tiempoP95Salida;
     
     // Métricas de comportamiento
     int personasConPanico;
@@ -48,10 +88,9 @@ struct EstadisticasGlobales {
     // Métricas de eficiencia
     double tasaEvacuacion;  // Personas evacuadas por segundo
     double densidadPromedio; // Densidad de agentes en el escenario
-    std::vector<QPoint> cuellosBotellaDetectados;
+    std::vector<Posicion> cuellosBotellaDetectados;
     
     // Estadísticas avanzadas
-    std::map<std::string, int> eventosRegistrados; // tipo_evento -> cantidad
     double distanciaPromedioRecorrida;
     int colisionesTotales;
 };
@@ -64,40 +103,95 @@ struct EstadisticasGlobales {
  */
 class EstadisticasSimulacion {
 public:
+    /**
+     * @brief Recibe cada paso si se quiere conservar la trayectoria completa
+     */
+    typedef std::function<void(int agenteId, Posicion desde, Posicion hasta)> SumideroTrayectorias;
+
+    // Colisiones a partir de las cuales una celda es cuello de botella
+    static constexpr uint32_t UMBRAL_CUELLO_BOTELLA = 5;
+
+    // Ticks entre dos muestras de la serie de densidad
+    static constexpr uint32_t INTERVALO_DENSIDAD = 10;
+
     // Constructor
     EstadisticasSimulacion();
     ~EstadisticasSimulacion();
     
     // Inicialización
-    void iniciar(int totalAgentes, int filas, int columnas);
+    void iniciar(int filas, int columnas);
     void reiniciar();
+
+    /**
+     * @brief Da de alta a un agente (al iniciar o si se agrega durante la corrida)
+     */
+    void registrarAgente(const std::shared_ptr<AgenteBase>& agente);
     
     // Registro de eventos
-    void registrarEvacuacion(std::shared_ptr<AgenteBase> agente, QPoint salida, double tiempo, int pasos);
-    void registrarColision(QPoint posicion);
-    void registrarCuelloBotella(QPoint posicion);
-    void registrarMovimiento(std::shared_ptr<AgenteBase> agente, QPoint desde, QPoint hasta);
-    void registrarCambioPanico(int agenteId, bool entroPanico);
+    // Los pasos y la distancia salen de la trayectoria registrada; devuelve el evento agregado
+    const EventoEvacuacion& registrarEvacuacion(std::shared_ptr<AgenteBase> agente, Posicion salida, double tiempo);
+    void registrarColision(Posicion posicion);
+    void registrarCuelloBotella(Posicion posicion);
+    void registrarMovimiento(const std::shared_ptr<AgenteBase>& agente, Posicion desde, Posicion hasta);
     
     // Actualización continua
-    void actualizarTiempoSimulacion(double tiempo);
-    void actualizarEstadoAgentes(const std::vector<std::shared_ptr<AgenteBase>>& agentes);
+    void actualizarTiempoSimulacion(uint32_t tick, double tiempo);
+
+    /**
+     * @brief Arma el resumen del tick en O(1) con los contadores por estado
+     * @param activos Agentes que siguen en el escenario
+     */
+    void actualizarResumen(const ConteoEstados& conteo, int activos);
+    const ResumenEstadisticas& getResumen() const { return resumen; }
+    static std::string formatearResumen(const ResumenEstadisticas& resumen);
+
+    /**
+     * @brief Agrega a la serie de densidad el conteo por celda si toca en este tick
+     */
+    void muestrearDensidad(uint32_t tick, const std::vector<std::shared_ptr<AgenteBase>>& agentes);
     
     // Cálculo de métricas
     void calcularEstadisticas();
-    EstadisticasGlobales getEstadisticas() const;
+    const EstadisticasGlobales& getEstadisticas() const;
     
     // Exportación de datos
     std::string generarReporte() const;
     std::string generarReporteCSV() const;
     std::string generarReporteJSON() const;
     bool exportarReporte(const std::string& rutaArchivo) const;
+    bool exportarDensidad(const std::string& rutaArchivo) const { return serieDensidad.exportar(rutaArchivo); }
+
+    /**
+     * @brief Escribe los eventos de evacuación en formato columnar (ver EscritorColumnas)
+     *
+     * Columnas: agente, tipo (0 persona, 1 rescatista), salida_fila,
+     * salida_columna, tiempo, pasos y distancia.
+     */
+    bool exportarEventos(const std::string& rutaArchivo) const;
     
     // Consultas específicas
-    int getPersonasEvacuadasPorSalida(QPoint salida) const;
-    double getTiempoPromedioSalida(QPoint salida) const;
+    int getPersonasEvacuadasPorSalida(Posicion salida) const;
+    double getTiempoPromedioSalida(Posicion salida) const;
     std::vector<EventoEvacuacion> getEventosEvacuacion() const;
-    std::vector<QPoint> getCuellosBotellaDetectados() const;
+    std::vector<Posicion> getCuellosBotellaDetectados() const;
+    const AcumuladorTrayectoria* getAcumulador(int agenteId) const;
+
+    // Mapas de calor por celda (índice fila * columnas + columna)
+    const std::vector<uint32_t>& getMapaColisiones() const { return colisionesPorCelda; }
+    const std::vector<uint32_t>& getMapaOcupacion() const { return ocupacionPorCelda; }  // Estadías terminadas
+    const std::vector<uint32_t>& getMapaFlujo() const { return flujoPorCelda; }
+    const SerieDensidad& getSerieDensidad() const { return serieDensidad; }
+
+    // Tiempos de evacuación (percentiles en cualquier momento de la corrida)
+    const HistogramaHDR& getHistogramaTiempos() const { return tiemposEvacuacion; }
+    const HistogramaHDR& getHistogramaTiempos(TipoAgente tipo) const;
+    const HistogramaHDR* getHistogramaSalida(Posicion salida) const;
+    size_t getAgentesSeguidos() const { return acumuladores.size(); }
+
+    /**
+     * @brief Trayectorias completas (opcional); sin sumidero solo se acumula
+     */
+    void setSumideroTrayectorias(SumideroTrayectorias sumidero) { sumideroTrayectorias = std::move(sumidero); }
     
     // Visualización de datos
     std::map<std::string, double> getMetricasResumen() const;
@@ -107,19 +201,40 @@ private:
     // Datos internos
     EstadisticasGlobales estadisticas;
     std::vector<EventoEvacuacion> eventosEvacuacion;
-    std::map<int, std::vector<QPoint>> trayectoriasAgentes; // agenteId -> ruta
-    std::map<std::string, int> contadorCuellosBottela; // posición -> frecuencia
+    std::unordered_map<int, AcumuladorTrayectoria> acumuladores; // Solo agentes activos
+    SumideroTrayectorias sumideroTrayectorias;
+
+    // Contadores densos por celda: registrar es un incremento
+    std::vector<uint32_t> colisionesPorCelda;
+    std::vector<uint32_t> ocupacionPorCelda;     // Ticks con un agente en la celda
+    std::vector<uint32_t> flujoPorCelda;         // Entradas de agentes a la celda
+    std::vector<uint32_t> evacuadosPorCelda;     // Solo es distinto de 0 en salidas
+    std::vector<double> tiempoEvacuacionPorCelda;
+
+    // Tiempos de evacuación: global, por tipo de agente y por salida (celda)
+    HistogramaHDR tiemposEvacuacion;
+    HistogramaHDR tiemposPorTipo[2];  // Indexado por TipoAgente
+    std::unordered_map<int, HistogramaHDR> tiemposPorSalida;
+
+    // Densidad en el tiempo
+    SerieDensidad serieDensidad;
+    std::vector<uint8_t> conteoDensidad;
     
     // Métricas en tiempo real
+    ResumenEstadisticas resumen;
+    double distanciaTotalEvacuados;  // Suma de las trayectorias de los evacuados
+    int movilidadReducidaActivos;
+    uint32_t tickActual;
     double tiempoActual;
     int filas, columnas;
     bool simulacionIniciada;
     
     // Métodos auxiliares
-    std::string puntoToString(QPoint punto) const;
-    double calcularDistancia(QPoint p1, QPoint p2) const;
-    void detectarCuellosBottela();
-    std::string formatearTiempo(double segundos) const;
+    std::string puntoToString(Posicion punto) const;
+    int indiceCelda(Posicion punto) const;  // -1 si está fuera del escenario
+    void resumirMapas();
+    void cerrarEstadias();
+    static std::string formatearTiempo(double segundos);
 };
 
 #endif // ESTADISTICASSIMULACION_H
@@ -0,0 +1,85 @@
+#ifndef EXPORTADORSERIE_H
+#define EXPORTADORSERIE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Posicion.h"
+#include "ResumenEstadisticas.h"
+
+/**
+ * @brief Exporta una fila por tick a un CSV desde un hilo aparte
+ *
+ * El hilo de simulación solo copia los contadores del tick (y la cantidad
+ * de evacuados por cada salida) a una cola circular de un productor y un
+ * consumidor. El hilo escritor les da formato en un búfer grande y lo
+ * vuelca al archivo cuando se llena. Si la cola se llena el productor cede
+ * el procesador hasta que haya lugar: la serie nunca pierde filas.
+ *
+ * Columnas: tick, tiempo, evacuados, activos, en ruta, bloqueados, en
+ * pánico, colisiones y, por cada salida, los evacuados por ella en ese tick.
+ */
+class ExportadorSerie {
+public:
+    static constexpr size_t CAPACIDAD = 8192;            // Filas en la cola (potencia de 2)
+    static constexpr size_t TAMANO_BUFFER = 1 << 20;     // Bytes de texto antes de escribir
+
+    ExportadorSerie();
+    ~ExportadorSerie();
+
+    ExportadorSerie(const ExportadorSerie&) = delete;
+    ExportadorSerie& operator=(const ExportadorSerie&) = delete;
+
+    /**
+     * @brief Crea el archivo, escribe el encabezado y arranca el hilo escritor
+     */
+    bool abrir(const std::string& ruta, const std::vector<Posicion>& salidas);
+
+    /**
+     * @brief Encola la fila del tick
+     * @param evacuadosPorSalida Evacuados acumulados por salida (en el orden de abrir())
+     */
+    void registrarTick(const ResumenEstadisticas& resumen, const std::vector<int>& evacuadosPorSalida);
+
+    /**
+     * @brief Escribe lo pendiente, detiene el hilo y cierra el archivo
+     */
+    void cerrar();
+
+    bool estaAbierto() const { return archivo != nullptr; }
+    const std::vector<Posicion>& getSalidas() const { return salidas; }
+
+private:
+    struct Fila {
+        ResumenEstadisticas resumen;
+    };
+
+    std::FILE* archivo;
+    std::vector<Posicion> salidas;
+    std::vector<int> evacuadosAnteriores;  // Para escribir el flujo del tick
+
+    // Cola SPSC: filas y, en paralelo, salidas.size() flujos por fila
+    std::vector<Fila> filas;
+    std::vector<int32_t> flujos;
+    alignas(64) std::atomic<size_t> escritura;
+    alignas(64) std::atomic<size_t> lectura;
+
+    std::thread escritor;
+    std::mutex mutex;
+    std::condition_variable hayFilas;
+    bool detener;
+
+    std::vector<char> buffer;
+    size_t usados;
+
+    void bucleEscritor();
+    void formatear(const Fila& fila, const int32_t* flujosFila);
+    void volcar();
+};
+
+#endif // EXPORTADORSERIE_H
@@ -6,7 +6,9 @@
 #include "Rescatista.h"
 #include <memory>
 #include <map>
+#include <random>
 #include <string>
+#include <vector>
 
 /**
  * @brief Factory para crear y clonar agentes
@@ -51,6 +53,17 @@ public:
         int edadPromedio, 
         double radioDispersion
     );
+
+    /**
+     * @brief Igual que la anterior pero con un generador dado (resultados reproducibles)
+     */
+    std::vector<std::shared_ptr<Persona>> crearGrupoPersonas(
+        int cantidad,
+        Posicion posInicial,
+        int edadPromedio,
+        double radioDispersion,
+        std::mt19937& gen
+    );
     
     /**
      * @brief Obtiene el siguiente ID disponible
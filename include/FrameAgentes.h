@@ -0,0 +1,51 @@
+#ifndef FRAMEAGENTES_H
+#define FRAMEAGENTES_H
+
+#include <cstdint>
+#include <vector>
+#include "AgenteBase.h"
+
+/**
+ * @brief Clase visible de un agente (define su letra y color en la vista)
+ */
+enum class ClaseAgente : uint8_t {
+    PERSONA = 0,
+    PERSONA_MOVILIDAD_REDUCIDA = 1,
+    RESCATISTA = 2
+};
+
+/**
+ * @brief Estado de un agente en un instante, sin punteros al modelo
+ *
+ * Las coordenadas siguen la convención de Posicion (x = fila, y = columna)
+ * y se guardan como float para no atar el formato a la rejilla.
+ */
+struct InstantaneaAgente {
+    int32_t id;
+    float x;
+    float y;
+    EstadoAgente estado;
+    ClaseAgente clase;
+
+    bool operator==(const InstantaneaAgente& otro) const {
+        return id == otro.id && x == otro.x && y == otro.y &&
+               estado == otro.estado && clase == otro.clase;
+    }
+    bool operator!=(const InstantaneaAgente& otro) const { return !(*this == otro); }
+};
+
+/**
+ * @brief Conjunto de agentes de un tick de la simulación
+ */
+struct FrameAgentes {
+    uint32_t tick = 0;
+    double tiempo = 0.0;
+    std::vector<InstantaneaAgente> agentes;
+};
+
+/**
+ * @brief Captura el estado visible de un agente
+ */
+InstantaneaAgente capturarInstantanea(const AgenteBase& agente);
+
+#endif // FRAMEAGENTES_H
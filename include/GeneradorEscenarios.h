@@ -0,0 +1,102 @@
+#ifndef GENERADORESCENARIOS_H
+#define GENERADORESCENARIOS_H
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Escenario.h"
+#include "FactoriaAgentes.h"
+
+/**
+ * @brief Tipos de plano que sabe construir GeneradorEscenarios
+ */
+enum class TipoPlano {
+    EDIFICIO,   // Salas y pasillos por partición binaria del espacio (BSP)
+    SALON,      // Sala abierta con una grilla de pilares
+    ESTADIO,    // Cancha central rodeada de anillos de gradas con pasillos radiales
+    LABERINTO   // Laberinto perfecto (backtracking) con algunos ciclos abiertos
+};
+
+/**
+ * @brief Parámetros de un plano; cada tipo usa solo los suyos
+ */
+struct ParametrosPlano {
+    TipoPlano tipo = TipoPlano::EDIFICIO;
+    int salidas = 4;              // Salidas repartidas por el borde exterior
+    int anchoSalida = 2;          // Celdas de cada salida
+    int anchoPasillo = 2;         // EDIFICIO, ESTADIO y LABERINTO
+    int ladoMinimoSala = 8;       // EDIFICIO: una sala más chica no se parte
+    int ladoMinimoPasillo = 64;   // EDIFICIO: particiones de este lado o más dejan un pasillo
+    int separacionPilares = 8;    // SALON
+    int ladoPilar = 2;            // SALON
+    int gradas = 6;               // ESTADIO: anillos de gradas
+    int pasillosGrada = 12;       // ESTADIO: pasillos radiales
+    double ciclos = 0.05;         // LABERINTO: fracción de nodos con una pared extra abierta
+};
+
+/**
+ * @brief Generador de escenarios y poblaciones a partir de una semilla
+ *
+ * Arma el plano sobre una rejilla plana de bytes (con rellenos por fila) y
+ * lo copia de una vez al Escenario, así que un mapa de 10M celdas tarda
+ * decenas de milisegundos. Con la misma semilla y los mismos parámetros
+ * el resultado es idéntico.
+ *
+ * El borde exterior queda siempre como pared salvo en las salidas, y cada
+ * salida se conecta con un túnel hasta el primer piso que encuentra. Si
+ * hay salidas, todo el piso que queda tiene camino hasta alguna de ellas.
+ */
+class GeneradorEscenarios {
+public:
+    explicit GeneradorEscenarios(uint32_t semilla);
+
+    /**
+     * @brief Reemplaza el contenido del escenario (mismas dimensiones) por un plano
+     */
+    void generar(Escenario& escenario, const ParametrosPlano& parametros);
+
+    /**
+     * @brief Crea personas en celdas de piso distintas
+     *
+     * Se crean en grupos con FactoriaAgentes::crearGrupoPersonas alrededor
+     * de centros al azar; quien cae en una pared, una salida o una celda ya
+     * ocupada se mueve a una celda libre cualquiera.
+     *
+     * @param cantidad Se recorta a la cantidad de celdas de piso
+     */
+    std::vector<std::shared_ptr<Persona>> poblar(const Escenario& escenario,
+                                                 FactoriaAgentes& factoria,
+                                                 int cantidad,
+                                                 int tamanoGrupo = 40);
+
+    static const char* nombreTipo(TipoPlano tipo);
+    static bool tipoDesdeNombre(const std::string& nombre, TipoPlano& tipo);
+
+private:
+    std::mt19937 rng;
+
+    // Rejilla de trabajo (0 piso, 1 pared, 2 salida), índice fila * columnas + columna
+    std::vector<uint8_t> celdas;
+    int filas;
+    int columnas;
+
+    void generarEdificio(const ParametrosPlano& parametros);
+    void generarSalon(const ParametrosPlano& parametros);
+    void generarEstadio(const ParametrosPlano& parametros);
+    void generarLaberinto(const ParametrosPlano& parametros);
+    void abrirSalidas(int cantidad, int ancho);
+    // Vuelve pared el piso que no se conecta con ninguna salida
+    void cerrarInalcanzables();
+
+    // Abre una puerta en cada tramo de piso de un lado de la pared (fila o columna)
+    void abrirPuertas(bool horizontal, int linea, int desde, int hasta, int lado, int ancho);
+    void abrirPuerta(bool horizontal, int linea, int desde, int hasta, int ancho);
+
+    // Rectángulo [fila0, fila1) x [columna0, columna1)
+    void rellenar(int fila0, int columna0, int fila1, int columna1, uint8_t tipo);
+    uint8_t& celda(int fila, int columna) { return celdas[static_cast<size_t>(fila) * columnas + columna]; }
+};
+
+#endif // GENERADORESCENARIOS_H
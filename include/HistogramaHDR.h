@@ -0,0 +1,52 @@
+#ifndef HISTOGRAMAHDR_H
+#define HISTOGRAMAHDR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Histograma de rango dinámico alto para tiempos (en segundos)
+ *
+ * Guarda los valores en milisegundos en cubetas log-lineales: cada potencia
+ * de 2 se divide en SUBCUBETAS / 2 cubetas iguales, así que cualquier
+ * percentil sale con un error relativo menor a 2 / SUBCUBETAS (< 0.8 %) sin
+ * guardar los valores. Registrar es O(1); consultar un percentil recorre un
+ * arreglo de tamaño fijo, sin importar cuántos valores haya. Dos
+ * histogramas se combinan sumando cubetas (p. ej. réplicas de un ensamble).
+ * Mínimo, máximo y promedio son exactos.
+ */
+class HistogramaHDR {
+public:
+    static constexpr int BITS_SUBCUBETA = 8;
+    static constexpr uint64_t SUBCUBETAS = uint64_t(1) << BITS_SUBCUBETA;
+    static constexpr int BITS_MAXIMO = 36;  // Hasta 2^36 ms (~2 años)
+
+    HistogramaHDR();
+
+    void registrar(double segundos);
+    void combinar(const HistogramaHDR& otro);
+    void limpiar();
+
+    /**
+     * @brief Valor bajo el cual queda el porcentaje p (0-100) de los registros
+     */
+    double percentil(double p) const;
+
+    uint64_t getCantidad() const { return cantidad; }
+    double getMinimo() const { return cantidad > 0 ? minimo : 0.0; }
+    double getMaximo() const { return cantidad > 0 ? maximo : 0.0; }
+    double getPromedio() const { return cantidad > 0 ? suma / cantidad : 0.0; }
+
+private:
+    std::vector<uint64_t> cubetas;
+    uint64_t cantidad;
+    double suma;
+    double minimo;
+    double maximo;
+
+    static size_t indiceCubeta(uint64_t milisegundos);
+    static double valorCubeta(size_t indice);
+};
+
+#endif // HISTOGRAMAHDR_H
@@ -0,0 +1,74 @@
+#ifndef INDICEESPACIAL_H
+#define INDICEESPACIAL_H
+
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "AgenteBase.h"
+
+class Persona;
+
+/**
+ * @brief Índice en rejilla uniforme de las personas que necesitan ayuda
+ *
+ * El mapa se divide en cubetas de TAM_CUBETA x TAM_CUBETA celdas. El
+ * simulador lo mantiene al día cuando una persona cambia de celda o de
+ * estado (actualizar/quitar cuestan O(1)), y los rescatistas consultan solo
+ * las cubetas cercanas: el costo depende de la densidad local y no del
+ * total de agentes.
+ */
+class IndiceEspacial {
+public:
+    static constexpr int TAM_CUBETA = 8;
+
+    IndiceEspacial();
+
+    /**
+     * @brief Prepara el índice para un mapa (lo deja vacío)
+     */
+    void configurar(int filas, int columnas);
+    void limpiar();
+
+    /**
+     * @brief Inserta a la persona o la mueve a su posición actual
+     */
+    void actualizar(const std::shared_ptr<Persona>& persona);
+    void quitar(int id);
+    bool contiene(int id) const { return ubicaciones.count(id) > 0; }
+
+    /**
+     * @brief Las k personas más cercanas a distancia menor que 'radio', de la más cercana a la más lejana
+     */
+    void buscarMasCercanas(Posicion centro, double radio, size_t k,
+                           std::vector<std::pair<double, std::shared_ptr<Persona>>>& resultado) const;
+
+    size_t size() const { return ubicaciones.size(); }
+
+    // Ninguna distancia entre dos celdas del mapa llega a este valor
+    double getAlcance() const { return std::hypot(filas, columnas) + 1.0; }
+
+private:
+    struct Entrada {
+        std::shared_ptr<Persona> persona;
+        Posicion posicion;
+    };
+
+    struct Ubicacion {
+        int cubeta;
+        size_t indice;
+    };
+
+    int filas;
+    int columnas;
+    int cubetasFilas;
+    int cubetasColumnas;
+    std::vector<std::vector<Entrada>> cubetas;
+    std::unordered_map<int, Ubicacion> ubicaciones;  // id -> lugar en su cubeta
+
+    int cubetaDe(Posicion posicion) const;
+    void quitarDeCubeta(const Ubicacion& ubicacion);
+};
+
+#endif // INDICEESPACIAL_H
@@ -0,0 +1,141 @@
+#ifndef MOTORCAMPOPISO_H
+#define MOTORCAMPOPISO_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "AgenteBase.h"
+#include "CampoDistancias.h"
+#include "Escenario.h"
+#include "PoolHilos.h"
+
+/**
+ * @brief Autómata celular de campo de piso (Kirchner / Schadschneider)
+ *
+ * Un agente por celda y actualización paralela: en cada tick todos eligen a
+ * la vez una de sus 9 celdas (las 8 vecinas o quedarse) con probabilidad
+ *
+ *     p ∝ exp(kS·S + kD·D)·(1 - ocupada)·(1 - pared)
+ *
+ * - S (campo estático): distancia a la salida del CampoDistancias, con signo
+ *   cambiado; se usa relativa a la celda actual para no salirse del rango.
+ * - D (campo dinámico): rastro que deja cada agente al salir de una celda.
+ *   Se difunde (α) y se desvanece (δ) una vez por tick con un esténcil SIMD
+ *   sobre la rejilla plana.
+ *
+ * Los pesos de todos los agentes se calculan por lotes (una pasada de exp
+ * vectorizada). Si varios eligen la misma celda, con probabilidad μ ninguno
+ * se mueve (fricción) y si no gana uno al azar. Los números aleatorios salen
+ * de un hash de (semilla, tick, agente), así que el resultado no depende de
+ * cuántos hilos haya.
+ */
+class MotorCampoPiso {
+public:
+    // Parámetros del modelo
+    static constexpr float ACOPLAMIENTO_ESTATICO = 3.0f;   // kS
+    static constexpr float ACOPLAMIENTO_DINAMICO = 1.0f;   // kD
+    static constexpr float DIFUSION = 0.3f;                // α
+    static constexpr float DECAIMIENTO = 0.3f;             // δ
+    static constexpr float FRICCION = 0.2f;                // μ
+    static constexpr int NUM_OPCIONES = 9;                 // 8 vecinas + quedarse
+
+    struct Movimiento {
+        std::shared_ptr<AgenteBase> agente;
+        Posicion desde;
+        Posicion hasta;
+    };
+
+    explicit MotorCampoPiso(PoolHilos* pool);
+
+    /**
+     * @brief Toma el mapa y el campo estático; borra el campo dinámico
+     *
+     * Debe volver a llamarse si el mapa cambia; los agentes se conservan.
+     */
+    void configurar(const Escenario& escenario, const CampoDistancias* campo);
+    void limpiar();
+
+    void agregar(const std::shared_ptr<AgenteBase>& agente);
+
+    /**
+     * @brief Velocidad efectiva con la que un agente intenta moverse en todos los ticks
+     *
+     * Más lentos intentan moverse con probabilidad velocidad / referencia.
+     */
+    void setVelocidadReferencia(float velocidad) { velocidadReferencia = velocidad; }
+    void setSemilla(uint64_t valor) { semilla = valor; }
+
+    /**
+     * @brief Ejecuta un paso del autómata
+     *
+     * Los movimientos quedan en getMovimientos(); los que entraron en una
+     * salida, o ya estaban en una, salen del motor y quedan además en
+     * getEvacuados(); los que no tenían ninguna celda libre hacia donde ir,
+     * en getSinOpciones().
+     */
+    void avanzar();
+
+    const std::vector<Movimiento>& getMovimientos() const { return movimientos; }
+    const std::vector<std::shared_ptr<AgenteBase>>& getEvacuados() const { return evacuados; }
+    const std::vector<std::shared_ptr<AgenteBase>>& getSinOpciones() const { return sinOpciones; }
+
+    /**
+     * @brief Campo dinámico de una celda (para visualizarlo o analizarlo)
+     */
+    float getCampoDinamico(int fila, int col) const;
+
+    size_t size() const { return agentes.size(); }
+
+private:
+    PoolHilos* pool;
+    const CampoDistancias* campo;
+    float velocidadReferencia;
+    uint64_t semilla;
+    uint64_t paso;
+
+    // Mapa: 0 = piso, 1 = pared, 2 = salida
+    int filas;
+    int columnas;
+    std::vector<uint8_t> tipoCelda;     // fila * columnas + columna
+    std::vector<int32_t> ocupante;      // Índice del agente, -1 si está libre
+
+    // Campo dinámico en una rejilla con borde de una celda y filas de
+    // 'pasoFila' floats (múltiplo de ANCHO): el esténcil no necesita casos de borde
+    int pasoFila;
+    std::vector<float> dinamico;
+    std::vector<float> dinamicoSiguiente;
+    std::vector<float> mascaraPiso;     // 1 en piso y salidas, 0 en paredes y borde
+
+    // Estado por agente
+    std::vector<std::shared_ptr<AgenteBase>> agentes;
+    std::vector<int32_t> celda;                 // fila * columnas + columna
+    std::vector<float> probabilidadMovimiento;
+
+    // Lote de pesos: NUM_OPCIONES contiguos por agente (con relleno a ANCHO)
+    std::vector<float> pesos;
+    std::vector<uint16_t> opciones;             // Bit k: la opción k es admisible
+    std::vector<int32_t> objetivo;              // Celda elegida, -1 = quedarse
+    std::vector<uint32_t> prioridad;
+
+    // Resolución de conflictos (por celda, solo las tocadas)
+    std::vector<int32_t> ganador;
+    std::vector<uint32_t> mejorPrioridad;
+    std::vector<uint16_t> aspirantes;
+    std::vector<int32_t> celdasDisputadas;
+
+    std::vector<Movimiento> movimientos;
+    std::vector<std::shared_ptr<AgenteBase>> evacuados;
+    std::vector<std::shared_ptr<AgenteBase>> sinOpciones;
+
+    int indiceDinamico(int celdaPlana) const;
+    bool admisible(int desde, int df, int dc) const;
+    uint64_t aleatorio(size_t agente, uint64_t flujo) const;
+
+    void difundirCampoDinamico(size_t filaInicio, size_t filaFin);
+    void calcularPesos(size_t inicio, size_t fin);
+    void elegirObjetivos(size_t inicio, size_t fin);
+    void resolverConflictos();
+    void retirarEnSalidas();
+};
+
+#endif // MOTORCAMPOPISO_H
@@ -0,0 +1,157 @@
+#ifndef MOTORFUERZASOCIAL_H
+#define MOTORFUERZASOCIAL_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "AgenteBase.h"
+#include "CampoDistancias.h"
+#include "Escenario.h"
+#include "FrameAgentes.h"
+#include "PoolHilos.h"
+
+/**
+ * @brief Movimiento en espacio continuo con el modelo de fuerza social (Helbing)
+ *
+ * Cada agente tiene posición y velocidad reales (x = fila, y = columna, en
+ * celdas; el centro de la celda (f, c) está en (f, c)). La aceleración suma:
+ * - Impulso hacia la salida: (v0·e - v) / τ, con e tomado del CampoDistancias.
+ * - Repulsión entre agentes: A·exp((r_ij - d_ij)/B)·n, más fuerza de cuerpo
+ *   k·g(r_ij - d_ij)·n y fricción κ·g(r_ij - d_ij)·Δv_t·t al haber contacto.
+ * - Repulsión de las paredes cercanas con la misma forma.
+ *
+ * La integración es semi-implícita: la posición usa la velocidad nueva y los
+ * términos rígidos (relajación, rigidez normal linealizada y fricción) se
+ * evalúan con la velocidad del final del subpaso. Para cada par en contacto
+ * se resuelve la velocidad relativa respecto de la media de los dos, lo que
+ * es exacto para un par aislado; queda un sistema 2x2 por agente. Así un
+ * subpaso más largo que 1/κ o 1/√k no rebota ni se amplifica, y no hace
+ * falta recortar la rapidez. Lo que limita el subpaso es la precisión: las
+ * fuerzas se evalúan en las posiciones del comienzo, así que nadie debe
+ * moverse más que DESPLAZAMIENTO_MAXIMO (un cuarto del alcance B de la
+ * repulsión) en un subpaso. Con la rapidez de la multitud más rápida se
+ * calcula el subpaso, entre PASO_MINIMO y PASO_MAXIMO.
+ *
+ * Los datos se guardan como estructura de arreglos y se reordenan en cada
+ * subpaso por celda de un hash espacial uniforme (counting sort), de modo que
+ * los vecinos de un agente son tres rangos contiguos de memoria que el kernel
+ * recorre con SIMD (ver Simd.h). El cálculo por agente se reparte en un
+ * PoolHilos.
+ */
+class MotorFuerzaSocial {
+public:
+    struct CambioCelda {
+        std::shared_ptr<AgenteBase> agente;
+        Posicion desde;
+        Posicion hasta;
+    };
+
+    // Parámetros del modelo (1 celda = 0.5 m)
+    static constexpr float RADIO_AGENTE = 0.45f;           // celdas
+    static constexpr float TIEMPO_RELAJACION = 0.5f;       // s
+    static constexpr float FUERZA_REPULSION = 50.0f;       // celdas/s²  (A = 2000 N, 80 kg)
+    static constexpr float ALCANCE_REPULSION = 0.16f;      // celdas     (B = 0.08 m)
+    static constexpr float RIGIDEZ_CUERPO = 1500.0f;       // 1/s²       (k = 1.2e5 kg/s²)
+    static constexpr float FRICCION_DESLIZAMIENTO = 3000.0f; // 1/s      (κ = 2.4e5 kg/(m·s))
+    static constexpr float CORTE = 2.0f;                   // celdas: alcance de las fuerzas entre agentes
+    static constexpr float DESPLAZAMIENTO_MAXIMO = 0.25f * ALCANCE_REPULSION;  // celdas por subpaso
+    static constexpr float PASO_MAXIMO = 0.1f * TIEMPO_RELAJACION;  // s
+    static constexpr float PASO_MINIMO = 0.0025f;          // s: 0.1/√k; acota el costo si alguien sale disparado
+
+    explicit MotorFuerzaSocial(PoolHilos* pool);
+
+    /**
+     * @brief Toma el mapa (paredes y salidas) y el campo de direcciones
+     *
+     * Debe volver a llamarse si el mapa cambia; los agentes se conservan.
+     */
+    void configurar(const Escenario& escenario, const CampoDistancias* campo);
+    void limpiar();
+
+    /**
+     * @brief Incorpora un agente en el centro de su celda y en reposo
+     */
+    void agregar(const std::shared_ptr<AgenteBase>& agente);
+
+    /**
+     * @brief Celdas por segundo que corresponden a una unidad de calcularVelocidadEfectiva()
+     */
+    void setEscalaVelocidad(float celdasPorSegundo) { escalaVelocidad = celdasPorSegundo; }
+
+    /**
+     * @brief Avanza la simulación 'segundos' en subpasos adaptativos (ver calcularPaso)
+     *
+     * Los agentes que llegan a una salida salen del motor en ese subpaso y quedan
+     * en getEvacuados(); los que cambiaron de celda, en getCambiosCelda().
+     */
+    void avanzar(float segundos);
+
+    const std::vector<std::shared_ptr<AgenteBase>>& getEvacuados() const { return evacuados; }
+    const std::vector<CambioCelda>& getCambiosCelda() const { return cambiosCelda; }
+
+    /**
+     * @brief Mayor rapidez (celdas/s) al final del último avance
+     */
+    float getRapidezMaxima() const { return rapidezMaxima; }
+
+    /**
+     * @brief Agrega al destino el estado visible de cada agente, con posición real
+     */
+    void capturar(std::vector<InstantaneaAgente>& destino) const;
+
+    size_t size() const { return agentes.size(); }
+
+private:
+    PoolHilos* pool;
+    const CampoDistancias* campo;
+    float escalaVelocidad;
+
+    // Mapa: 0 = piso, 1 = pared, 2 = salida
+    int filas;
+    int columnas;
+    std::vector<uint8_t> tipoCelda;
+
+    // Hash espacial uniforme (celdas de lado CORTE)
+    int hashFilas;
+    int hashColumnas;
+    std::vector<uint32_t> inicioCelda;  // hashFilas * hashColumnas + 1
+    std::vector<uint32_t> celdaHash;
+    std::vector<uint32_t> orden;
+
+    // Estado por agente (estructura de arreglos, con ANCHO elementos de relleno)
+    std::vector<std::shared_ptr<AgenteBase>> agentes;
+    std::vector<float> px, py;
+    std::vector<float> vx, vy;
+    std::vector<float> radio;
+    std::vector<float> velocidadDeseada;
+    // Sistema de cada subpaso: M·v' = b, con M simétrica (mxx, mxy, myy) y b en (bx, by)
+    std::vector<float> bx, by;
+    std::vector<float> mxx, mxy, myy;
+    std::vector<int32_t> celdaFila, celdaColumna;  // Última celda informada
+
+    // Búferes para reordenar
+    std::vector<float> tmpFloat;
+    std::vector<int32_t> tmpEntero;
+    std::vector<std::shared_ptr<AgenteBase>> tmpAgentes;
+
+    std::vector<std::shared_ptr<AgenteBase>> evacuados;
+    std::vector<CambioCelda> cambiosCelda;
+    float rapidezMaxima;
+
+    bool esPared(int fila, int col) const;
+    int hashFila(float x) const;
+    int hashColumna(float y) const;
+
+    void ajustarRelleno();
+    float calcularPaso() const;  // Subpaso para que nadie avance más que DESPLAZAMIENTO_MAXIMO
+    void ordenarPorCeldas();
+    void calcularFuerzas(size_t inicio, size_t fin, float dt);
+    // Suma la fuerza de las paredes y su rigidez normal (n·nᵀ ponderada) en kxx, kxy, kyy
+    void fuerzaParedes(float x, float y, float r, float& fx, float& fy,
+                       float& kxx, float& kxy, float& kyy) const;
+    void integrar(size_t inicio, size_t fin, float dt);
+    void retirarEvacuados();
+    void recogerResultados();
+};
+
+#endif // MOTORFUERZASOCIAL_H
@@ -2,27 +2,24 @@
 #define OBSERVADOREVENTO_H
 
 #include <string>
-#include <memory>
-
-// Forward declaration
-class AgenteBase;
+#include "BusEventos.h"
 
 /**
  * @brief Interfaz para el Patrón Observer
  * 
  * Los objetos que implementen esta interfaz podrán recibir
- * notificaciones de eventos de los agentes.
+ * notificaciones de eventos de los agentes. Se suscriben en un BusEventos
+ * a los tipos que les interesan y reciben los eventos al despacharse el bus.
  */
 class ObservadorEvento {
 public:
     virtual ~ObservadorEvento() = default;
     
     /**
-     * @brief Método llamado cuando ocurre un evento
-     * @param agente Puntero al agente que generó el evento
-     * @param tipoEvento Descripción del evento
+     * @brief Método llamado cuando se despacha un evento
+     * @param evento Tipo, agente, celda y tick del evento
      */
-    virtual void onEventoAgente(AgenteBase* agente, const std::string& tipoEvento) = 0;
+    virtual void onEvento(const Evento& evento) = 0;
 };
 
 /**
@@ -40,10 +37,17 @@ private:
 public:
     GestorEventos();
     
+    /**
+     * @brief Se suscribe en el bus a los eventos que cuenta
+     *
+     * El gestor debe vivir al menos tanto como las suscripciones del bus.
+     */
+    void suscribirse(BusEventos& bus);
+
     /**
      * @brief Implementación del método de notificación
      */
-    void onEventoAgente(AgenteBase* agente, const std::string& tipoEvento) override;
+    void onEvento(const Evento& evento) override;
     
     /**
      * @brief Reinicia los contadores de eventos
@@ -3,12 +3,11 @@
 
 #include "Escenario.h"
 #include <list>
-#include <QPoint>
 
 class PathFinder {
 public:
     //retorna el siguiente punto al que debe moverse el agente
-    static QPoint calcularSiguientePaso(Escenario* mapa, QPoint inicio, QPoint fin);
+    static Posicion calcularSiguientePaso(Escenario* mapa, Posicion inicio, Posicion fin);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,114 @@
+#ifndef PERFILADORTICK_H
+#define PERFILADORTICK_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "HistogramaHDR.h"
+
+/**
+ * @brief 1 para medir las fases del tick; se fija con la opción SIMULADOR_PERFILADO de CMake
+ *
+ * Con 0 las mediciones no generan código: PERFILAR_FASE no declara nada y
+ * las llamadas al perfilador quedan dentro de if constexpr.
+ */
+#ifndef SIMULADOR_PERFILADO
+#define SIMULADOR_PERFILADO 0
+#endif
+
+/**
+ * @brief Partes del tick que se miden por separado
+ */
+enum class FaseTick : uint8_t {
+    BUSQUEDA_SALIDA,  // Salida más cercana de cada agente (rejilla)
+    BUSQUEDA_RUTA,    // Siguiente paso, o el campo de distancias si cambió el mapa
+    COLISIONES,       // Celda destino ocupada
+    MOTOR,            // Fuerza social o campo de piso
+    RESCATE,          // Asignación de rescatistas
+    ESTADISTICAS,     // Movimientos, evacuaciones, densidad y serie por tick
+    EVENTOS,          // Despacho del bus a los observadores
+    PUBLICACION,      // Frame para la GUI (fuera de avanzarTick)
+    TICK,             // avanzarTick completo
+    NUM_FASES
+};
+
+/**
+ * @brief Tiempo por fase de cada tick, resumido en histogramas
+ *
+ * Durante el tick las mediciones se suman por fase; cerrarTick() pasa esas
+ * sumas a un HistogramaHDR por fase, así que el costo y la memoria no
+ * dependen de cuántos ticks dure la corrida. Solo se usa desde el hilo de
+ * simulación.
+ */
+class PerfiladorTick {
+public:
+    static constexpr bool ACTIVO = SIMULADOR_PERFILADO != 0;
+    static constexpr size_t NUM_FASES = static_cast<size_t>(FaseTick::NUM_FASES);
+
+    PerfiladorTick();
+
+    static const char* nombreFase(FaseTick fase);
+
+    static uint64_t ahoraNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void acumular(FaseTick fase, uint64_t nanosegundos) {
+        const size_t i = static_cast<size_t>(fase);
+        acumulado[i] += nanosegundos;
+        medida[i] = true;
+    }
+
+    /**
+     * @brief Registra en los histogramas lo medido desde el cierre anterior
+     */
+    void cerrarTick();
+    void limpiar();
+
+    /**
+     * @brief Tabla con percentiles por fase (en microsegundos) y su parte del tick
+     */
+    std::string generarReporte() const;
+
+    const HistogramaHDR& getHistograma(FaseTick fase) const { return histogramas[static_cast<size_t>(fase)]; }
+
+private:
+    // Se registran microsegundos: el histograma guarda milésimas de la unidad
+    // que recibe, así que la resolución queda en nanosegundos
+    HistogramaHDR histogramas[NUM_FASES];
+    uint64_t acumulado[NUM_FASES];
+    bool medida[NUM_FASES];
+    uint64_t totalNs[NUM_FASES];
+};
+
+/**
+ * @brief Mide el tiempo hasta el final del bloque y lo suma a la fase
+ */
+class MedicionFase {
+public:
+    MedicionFase(PerfiladorTick& perfilador, FaseTick fase)
+        : perfilador(perfilador), fase(fase), inicio(PerfiladorTick::ahoraNs()) {}
+    ~MedicionFase() { perfilador.acumular(fase, PerfiladorTick::ahoraNs() - inicio); }
+
+    MedicionFase(const MedicionFase&) = delete;
+    MedicionFase& operator=(const MedicionFase&) = delete;
+
+private:
+    PerfiladorTick& perfilador;
+    FaseTick fase;
+    uint64_t inicio;
+};
+
+#define PERFILADO_CONCATENAR_(a, b) a##b
+#define PERFILADO_CONCATENAR(a, b) PERFILADO_CONCATENAR_(a, b)
+
+#if SIMULADOR_PERFILADO
+#define PERFILAR_FASE(perfilador, fase) \
+    MedicionFase PERFILADO_CONCATENAR(medicionFase_, __LINE__)((perfilador), (fase))
+#else
+#define PERFILAR_FASE(perfilador, fase) ((void)0)
+#endif
+
+#endif // PERFILADORTICK_H
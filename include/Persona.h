@@ -10,15 +10,19 @@
  * Hereda de AgenteBase e implementa comportamientos específicos
  * como pánico, movilidad reducida, etc.
  */
-class Persona : public AgenteBase {
+class Persona final : public AgenteBase {
 private:
     int edad;
     double nivelPanico;
     bool movilidadReducida;
     double factorVelocidadBase;
     Escenario* escenario;
+    bool asistida;  // Un rescatista ya la está ayudando
+    bool cargada;   // Va con el rescatista: no ocupa celda propia
     
 public:
+    static constexpr TipoAgente TIPO = TipoAgente::PERSONA;
+
     /**
      * @brief Constructor de Persona
      */
@@ -63,11 +67,20 @@ public:
      * @brief Verifica si la persona está en pánico
      */
     bool estEnPanico() const { return nivelPanico > 0.7; }
+
+    /**
+     * @brief Verifica si la persona necesita (y aún no recibe) la ayuda de un rescatista
+     */
+    bool necesitaAyuda() const;
     
     // Getters específicos
     int getEdad() const { return edad; }
     double getNivelPanico() const { return nivelPanico; }
     bool tieneMovilidadReducida() const { return movilidadReducida; }
+    bool estaAsistida() const { return asistida; }
+    void setAsistida(bool valor) { asistida = valor; }
+    bool estaCargada() const { return cargada; }
+    void setCargada(bool valor) { cargada = valor; }
     void setEscenario(Escenario* esc);
     bool verificarLlegadaSalida() const;
     bool estaCercaDeSalida() const;
@@ -0,0 +1,60 @@
+#ifndef POOLHILOS_H
+#define POOLHILOS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Grupo fijo de hilos para repartir bucles de datos independientes
+ *
+ * paraCadaRango() divide [0, n) en bloques contiguos, los reparte entre los
+ * hilos (el hilo que llama también trabaja) y vuelve cuando todos terminaron.
+ * Pensado para los kernels por agente: cada bloque escribe solo sus propios
+ * elementos, así que no hace falta sincronización dentro del cuerpo.
+ */
+class PoolHilos {
+public:
+    /**
+     * @param numHilos Hilos en total (0 = los núcleos disponibles)
+     */
+    explicit PoolHilos(unsigned int numHilos = 0);
+    ~PoolHilos();
+
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    /**
+     * @brief Ejecuta cuerpo(inicio, fin) sobre bloques de [0, n)
+     * @param minimoPorBloque Por debajo de este tamaño no se reparte
+     */
+    void paraCadaRango(size_t n, const std::function<void(size_t, size_t)>& cuerpo,
+                       size_t minimoPorBloque = 1024);
+
+    unsigned int getNumHilos() const { return static_cast<unsigned int>(trabajadores.size()) + 1; }
+
+private:
+    std::vector<std::thread> trabajadores;
+    std::mutex mutex;
+    std::condition_variable hayTrabajo;
+    std::condition_variable trabajoTerminado;
+
+    // Trabajo en curso (protegido por mutex)
+    const std::function<void(size_t, size_t)>* cuerpoActual;
+    size_t totalElementos;
+    size_t tamanoBloque;
+    size_t siguienteBloque;
+    size_t numBloques;
+    size_t bloquesPendientes;
+    unsigned long generacion;
+    bool detener;
+
+    void bucleTrabajador();
+    bool tomarBloque(const std::function<void(size_t, size_t)>*& cuerpo, size_t& inicio, size_t& fin);
+    void ejecutarBloques();
+};
+
+#endif // POOLHILOS_H
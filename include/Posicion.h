@@ -0,0 +1,73 @@
+#ifndef POSICION_H
+#define POSICION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+/**
+ * @brief Celda de la rejilla: x() es la fila e y() la columna
+ *
+ * Reemplaza a QPoint en el núcleo con la misma interfaz (x(), y(), ==)
+ * pero en 4 bytes y sin depender de Qt. Cada coordenada ocupa 16 bits, lo
+ * que alcanza para mapas de hasta Escenario::LADO_MAXIMO celdas de lado;
+ * una posición cabe entera en 32 bits (clave de hash o de orden).
+ *
+ * Para indexar arreglos por celda se usa indice(columnas), el índice
+ * denso fila * columnas + columna que ya usan los contadores por celda.
+ */
+struct Posicion {
+    int16_t fila;
+    int16_t columna;
+
+    constexpr Posicion() : fila(0), columna(0) {}
+    constexpr Posicion(int f, int c) : fila(static_cast<int16_t>(f)), columna(static_cast<int16_t>(c)) {}
+
+    constexpr int x() const { return fila; }
+    constexpr int y() const { return columna; }
+    void setX(int f) { fila = static_cast<int16_t>(f); }
+    void setY(int c) { columna = static_cast<int16_t>(c); }
+
+    /**
+     * @brief Índice denso en una rejilla de 'columnas' columnas (la posición debe estar dentro)
+     */
+    constexpr uint32_t indice(int columnas) const {
+        return static_cast<uint32_t>(fila) * static_cast<uint32_t>(columnas) + static_cast<uint32_t>(columna);
+    }
+    static constexpr Posicion desdeIndice(uint32_t indice, int columnas) {
+        return Posicion(static_cast<int>(indice / static_cast<uint32_t>(columnas)),
+                        static_cast<int>(indice % static_cast<uint32_t>(columnas)));
+    }
+
+    /**
+     * @brief Las dos coordenadas en 32 bits (fila en la mitad alta); vale también fuera del mapa
+     */
+    constexpr uint32_t empaquetar() const {
+        return (static_cast<uint32_t>(static_cast<uint16_t>(fila)) << 16) | static_cast<uint16_t>(columna);
+    }
+    static constexpr Posicion desempaquetar(uint32_t valor) {
+        return Posicion(static_cast<int16_t>(valor >> 16), static_cast<int16_t>(valor & 0xFFFF));
+    }
+
+    friend constexpr bool operator==(Posicion a, Posicion b) { return a.fila == b.fila && a.columna == b.columna; }
+    friend constexpr bool operator!=(Posicion a, Posicion b) { return !(a == b); }
+    friend constexpr bool operator<(Posicion a, Posicion b) {
+        return a.fila != b.fila ? a.fila < b.fila : a.columna < b.columna;
+    }
+};
+
+static_assert(sizeof(Posicion) == 4, "Posicion debe ocupar 32 bits");
+static_assert(std::is_trivially_copyable<Posicion>::value, "Posicion debe copiarse como bytes");
+
+namespace std {
+template <>
+struct hash<Posicion> {
+    size_t operator()(Posicion posicion) const noexcept {
+        // Mezcla multiplicativa: reparte bien aunque la tabla use potencias de dos
+        return static_cast<size_t>(posicion.empaquetar() * 0x9E3779B1u);
+    }
+};
+}
+
+#endif // POSICION_H
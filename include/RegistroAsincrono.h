@@ -0,0 +1,126 @@
+#ifndef REGISTROASINCRONO_H
+#define REGISTROASINCRONO_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+/**
+ * @brief Nivel mínimo que se compila (0 = traza ... 4 = error)
+ *
+ * Las llamadas con un nivel menor desaparecen en tiempo de compilación.
+ * Se fija con la opción SIMULADOR_NIVEL_REGISTRO de CMake.
+ */
+#ifndef REGISTRO_NIVEL_MINIMO
+#define REGISTRO_NIVEL_MINIMO 1
+#endif
+
+enum class NivelRegistro : uint8_t {
+    TRAZA = 0,
+    DEPURACION = 1,
+    INFO = 2,
+    ADVERTENCIA = 3,
+    ERROR = 4
+};
+
+/**
+ * @brief Mensajes que se pueden registrar; cada uno tiene una plantilla de texto fija
+ */
+enum class CodigoRegistro : uint16_t {
+    AGENTE_EVACUADO,             // agente, tiempo (s), pasos
+    AGENTE_SIN_SALIDA,           // agente
+    PERSONA_EVACUADA,            // agente
+    RESCATISTA_EVACUADO,         // agente
+    TOTAL_EVACUADOS,             // evacuados, total
+    SIMULACION_ESTANCADA,        // agentes restantes
+    SIMULACION_COMPLETA,         // tick
+    NUM_CODIGOS
+};
+
+/**
+ * @brief Registro binario de tamaño fijo (lo que copia el hilo que registra)
+ */
+struct EntradaRegistro {
+    uint64_t instanteNs;     // Reloj monótono
+    uint32_t tick;
+    NivelRegistro nivel;
+    CodigoRegistro codigo;
+    double argumentos[3];
+};
+
+/**
+ * @brief Registro estructurado asíncrono
+ *
+ * Registrar solo copia unos pocos valores en un búfer circular sin
+ * bloqueos (cola acotada de Vyukov, varios productores). Un hilo en segundo
+ * plano saca las entradas, les da formato con la plantilla de su código y
+ * las escribe en la salida. Si el búfer está lleno la entrada se descarta y
+ * se cuenta; quien registra nunca espera.
+ */
+class RegistroAsincrono {
+public:
+    static constexpr size_t CAPACIDAD = 1 << 14;  // Potencia de 2
+
+    static RegistroAsincrono& global();
+
+    explicit RegistroAsincrono(std::ostream& salida);
+    ~RegistroAsincrono();
+
+    RegistroAsincrono(const RegistroAsincrono&) = delete;
+    RegistroAsincrono& operator=(const RegistroAsincrono&) = delete;
+
+    /**
+     * @brief Tick que se anota en las entradas a partir de ahora
+     */
+    void setTick(uint32_t tick) { tickActual.store(tick, std::memory_order_relaxed); }
+
+    void escribir(NivelRegistro nivel, CodigoRegistro codigo, double a0, double a1, double a2);
+
+    /**
+     * @brief Espera a que el hilo escritor haya escrito todo lo registrado hasta ahora
+     */
+    void vaciar();
+
+    uint64_t getDescartadas() const { return descartadas.load(std::memory_order_relaxed); }
+
+private:
+    struct Celda {
+        std::atomic<size_t> secuencia;
+        EntradaRegistro entrada;
+    };
+
+    std::unique_ptr<Celda[]> celdas;
+    alignas(64) std::atomic<size_t> posicionEscritura;
+    alignas(64) size_t posicionLectura;  // Solo el hilo escritor
+    std::atomic<uint32_t> tickActual;
+    std::atomic<uint64_t> descartadas;
+    std::atomic<uint64_t> escritas;
+
+    std::ostream& salida;
+    std::thread escritor;
+    std::mutex mutex;
+    std::condition_variable cambio;
+    bool detener;
+
+    bool extraer(EntradaRegistro& entrada);
+    void formatear(const EntradaRegistro& entrada);
+    void bucleEscritor();
+};
+
+/**
+ * @brief Registra un mensaje; por debajo de REGISTRO_NIVEL_MINIMO no genera código
+ */
+template <NivelRegistro N>
+inline void registrar(CodigoRegistro codigo, double a0 = 0.0, double a1 = 0.0, double a2 = 0.0) {
+    if constexpr (static_cast<int>(N) >= REGISTRO_NIVEL_MINIMO) {
+        RegistroAsincrono::global().escribir(N, codigo, a0, a1, a2);
+    } else {
+        (void)codigo; (void)a0; (void)a1; (void)a2;
+    }
+}
+
+#endif // REGISTROASINCRONO_H
@@ -15,13 +15,23 @@ class Persona;
  * - No entran en pánico
  * - Pueden asistir a personas con movilidad reducida
  */
-class Rescatista : public AgenteBase {
+class Rescatista final : public AgenteBase {
+public:
+    enum class FaseRescate {
+        LIBRE,
+        EN_CAMINO,  // Asignado, va hacia la persona
+        CARGANDO    // Ya la alcanzó y la lleva a la salida
+    };
+
 private:
     std::weak_ptr<Persona> personaAsistida;
-    bool estaAsistiendo;
-    double capacidadCarga; // Factor que afecta velocidad al asistir
+    FaseRescate fase;
+    double capacidadCarga; // Factor que afecta velocidad al cargar
+    int personaInalcanzable; // Última persona hasta la que no hubo camino (-1 = ninguna)
     
 public:
+    static constexpr TipoAgente TIPO = TipoAgente::RESCATISTA;
+
     /**
      * @brief Constructor de Rescatista
      */
@@ -38,7 +48,7 @@ public:
     void actualizar(double deltaTime) override;
     
     /**
-     * @brief Calcula la velocidad efectiva (considerando si está asistiendo)
+     * @brief Calcula la velocidad efectiva (considerando si está cargando a alguien)
      */
     double calcularVelocidadEfectiva() const override;
     
@@ -53,22 +63,30 @@ public:
     std::shared_ptr<AgenteBase> clonar() const override;
     
     /**
-     * @brief Asigna una persona para asistir
+     * @brief Asigna una persona para asistir: el rescatista va hacia ella
      */
     void asistirPersona(std::shared_ptr<Persona> persona);
-    
+
     /**
-     * @brief Libera a la persona asistida
+     * @brief La alcanzó: desde ahora la lleva consigo (y avanza más lento)
      */
-    void liberarPersona();
+    void tomarPersona();
+
+    /**
+     * @brief No hay camino hasta la persona asignada: la suelta y no vuelve a pujar por ella
+     */
+    void descartarPersona();
     
     /**
-     * @brief Busca personas cercanas que necesiten asistencia
+     * @brief Libera a la persona asistida
      */
-    void buscarPersonasQueNecesitanAyuda(const std::vector<std::shared_ptr<AgenteBase>>& agentes);
+    void liberarPersona();
     
     // Getters
-    bool getEstaAsistiendo() const { return estaAsistiendo; }
+    FaseRescate getFase() const { return fase; }
+    bool getEstaAsistiendo() const { return fase != FaseRescate::LIBRE; }
+    bool getCargando() const { return fase == FaseRescate::CARGANDO; }
+    int getPersonaInalcanzable() const { return personaInalcanzable; }
     std::shared_ptr<Persona> getPersonaAsistida() const { return personaAsistida.lock(); }
 };
 
@@ -0,0 +1,32 @@
+#ifndef RESUMENESTADISTICAS_H
+#define RESUMENESTADISTICAS_H
+
+#include <cstdint>
+
+/**
+ * @brief Contadores de un tick, de tamaño fijo y sin contenedores
+ *
+ * EstadisticasSimulacion lo arma en O(1) a partir de contadores que se
+ * actualizan en cada cambio de estado; quien lo lee (la GUI a través del
+ * frame) recibe una copia y no toca mapas ni recorre agentes.
+ */
+struct ResumenEstadisticas {
+    uint32_t tick = 0;
+    double tiempo = 0.0;
+
+    int totalAgentes = 0;
+    int evacuados = 0;
+    int personasEvacuadas = 0;
+    int rescatistasEvacuados = 0;
+    int enProceso = 0;
+    int enRuta = 0;
+    int bloqueados = 0;
+    int conPanico = 0;
+    int movilidadReducida = 0;
+    int colisiones = 0;
+
+    double tasaEvacuacion = 0.0;          // Evacuados por segundo simulado
+    double tiempoPromedioEvacuacion = 0.0;
+};
+
+#endif // RESUMENESTADISTICAS_H
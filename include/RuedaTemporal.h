@@ -0,0 +1,70 @@
+#ifndef RUEDATEMPORAL_H
+#define RUEDATEMPORAL_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "AgenteBase.h"
+
+/**
+ * @brief Rueda temporal jerárquica para planificar a los agentes
+ *
+ * Cada agente se programa para el instante en que llega a su siguiente celda.
+ * El tiempo se mide en subticks (SUBTICKS_POR_TICK por tick) para que las
+ * diferencias de velocidad se acumulen sin redondear a ticks enteros.
+ *
+ * - Nivel 0: 256 ranuras de 1 tick.
+ * - Nivel 1: 256 ranuras de 256 ticks, que se reparten en el nivel 0 al
+ *   llegar a su bloque.
+ * - Desborde: eventos a más de 65536 ticks, revisados al girar el nivel 1.
+ *
+ * Programar y extraer cuestan O(1) amortizado por entrada; un tick sin
+ * agentes vencidos no recorre a nadie.
+ */
+class RuedaTemporal {
+public:
+    static constexpr uint64_t SUBTICKS_POR_TICK = 1u << 16;
+
+    struct Entrada {
+        std::shared_ptr<AgenteBase> agente;
+        uint64_t instante;  // En subticks
+    };
+
+    RuedaTemporal();
+
+    /**
+     * @brief Vacía la rueda y la posiciona en el tick indicado
+     */
+    void limpiar(uint64_t tickInicial);
+
+    /**
+     * @brief Programa un agente; instantes ya pasados se atienden en el tick actual
+     */
+    void programar(std::shared_ptr<AgenteBase> agente, uint64_t instante);
+
+    /**
+     * @brief Mueve a 'vencidas' las entradas del tick actual y avanza un tick
+     */
+    void extraerTick(std::vector<Entrada>& vencidas);
+
+    uint64_t getTick() const { return tickActual; }
+    size_t size() const { return cantidad; }
+    bool vacia() const { return cantidad == 0; }
+
+private:
+    static constexpr int BITS_NIVEL = 8;
+    static constexpr uint64_t RANURAS = 1u << BITS_NIVEL;
+    static constexpr uint64_t MASCARA = RANURAS - 1;
+
+    std::array<std::vector<Entrada>, RANURAS> nivel0;
+    std::array<std::vector<Entrada>, RANURAS> nivel1;
+    std::vector<Entrada> desborde;
+    uint64_t tickActual;
+    size_t cantidad;
+
+    void insertar(Entrada&& entrada);
+    void redistribuir(std::vector<Entrada>& origen);
+};
+
+#endif // RUEDATEMPORAL_H
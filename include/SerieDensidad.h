@@ -0,0 +1,82 @@
+#ifndef SERIEDENSIDAD_H
+#define SERIEDENSIDAD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Serie temporal comprimida de la cantidad de agentes por celda
+ *
+ * Cada muestra es un mapa de filas * columnas bytes (conteo saturado en 255).
+ * Se guarda como diferencia contra la muestra anterior, codificada en
+ * corridas: varint(celdas sin cambio), varint(celdas con cambio) y las
+ * diferencias de esas celdas. Como entre dos muestras cambia poco del mapa,
+ * una muestra cuesta unos pocos bytes por agente que se movió y no por
+ * celda. Cada KEYFRAME_CADA muestras la diferencia es contra un mapa vacío,
+ * así que para leer cualquier muestra basta con decodificar desde el
+ * keyframe anterior.
+ *
+ * Formato del archivo exportado (little-endian): "DENS", versión, filas,
+ * columnas, intervalo, keyframes, cantidad de muestras, la tabla de muestras
+ * (tick, offset) y los datos codificados.
+ */
+class SerieDensidad {
+public:
+    static constexpr uint32_t KEYFRAME_CADA = 64;
+    static constexpr uint32_t VERSION_FORMATO = 1;
+
+    SerieDensidad();
+
+    void configurar(int filas, int columnas, uint32_t intervalo);
+    void limpiar();
+
+    /**
+     * @brief Indica si en este tick corresponde tomar una muestra
+     */
+    bool tocaMuestra(uint32_t tick) const { return intervalo > 0 && tick % intervalo == 0; }
+
+    /**
+     * @brief Agrega una muestra (conteo debe tener filas * columnas bytes)
+     */
+    void agregarMuestra(uint32_t tick, const std::vector<uint8_t>& conteo);
+
+    /**
+     * @brief Reconstruye la muestra i
+     * @return false si no existe
+     */
+    bool decodificar(size_t indice, std::vector<uint8_t>& destino) const;
+
+    /**
+     * @brief Última muestra agregada, sin decodificar
+     */
+    const std::vector<uint8_t>& getUltimaMuestra() const { return anterior; }
+
+    bool exportar(const std::string& ruta) const;
+
+    size_t getCantidadMuestras() const { return muestras.size(); }
+    uint32_t getTickMuestra(size_t indice) const { return muestras[indice].tick; }
+    uint32_t getIntervalo() const { return intervalo; }
+    size_t getBytesComprimidos() const { return datos.size(); }
+    int getFilas() const { return filas; }
+    int getColumnas() const { return columnas; }
+
+private:
+    struct Muestra {
+        uint32_t tick;
+        uint64_t offset;
+    };
+
+    int filas;
+    int columnas;
+    uint32_t intervalo;
+    std::vector<Muestra> muestras;
+    std::vector<uint8_t> datos;
+    std::vector<uint8_t> anterior;  // Última muestra (base de la próxima diferencia)
+
+    void codificar(const std::vector<uint8_t>& base, const std::vector<uint8_t>& actual);
+    void aplicar(size_t indice, std::vector<uint8_t>& mapa) const;
+};
+
+#endif // SERIEDENSIDAD_H
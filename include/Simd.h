@@ -0,0 +1,158 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cmath>
+
+/**
+ * @brief Envoltorios mínimos sobre instrucciones SIMD para los kernels numéricos
+ *
+ * Se elige en tiempo de compilación el conjunto más ancho disponible:
+ * AVX2+FMA (8 floats), SSE2 (4 floats) o una versión escalar (1 float).
+ * Los kernels se escriben una sola vez contra estas funciones y avanzan de
+ * ANCHO en ANCHO elementos.
+ *
+ * Las máscaras son vectores con todos los bits a 1 en los carriles que
+ * cumplen la condición; seleccionar() deja en cero los demás carriles.
+ */
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_SSE2 1
+#endif
+
+namespace simd {
+
+#if defined(SIMD_AVX2)
+
+constexpr int ANCHO = 8;
+typedef __m256 VecF;
+
+inline VecF cargar(const float* p) { return _mm256_loadu_ps(p); }
+inline void guardar(float* p, VecF v) { _mm256_storeu_ps(p, v); }
+inline VecF repetir(float x) { return _mm256_set1_ps(x); }
+inline VecF indices() { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+
+inline VecF sumar(VecF a, VecF b) { return _mm256_add_ps(a, b); }
+inline VecF restar(VecF a, VecF b) { return _mm256_sub_ps(a, b); }
+inline VecF multiplicar(VecF a, VecF b) { return _mm256_mul_ps(a, b); }
+inline VecF dividir(VecF a, VecF b) { return _mm256_div_ps(a, b); }
+inline VecF multSumar(VecF a, VecF b, VecF c) { return _mm256_fmadd_ps(a, b, c); }
+inline VecF maximo(VecF a, VecF b) { return _mm256_max_ps(a, b); }
+inline VecF minimo(VecF a, VecF b) { return _mm256_min_ps(a, b); }
+inline VecF raiz(VecF a) { return _mm256_sqrt_ps(a); }
+
+inline VecF menorQue(VecF a, VecF b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+inline VecF yLogico(VecF a, VecF b) { return _mm256_and_ps(a, b); }
+inline VecF seleccionar(VecF mascara, VecF a) { return _mm256_and_ps(mascara, a); }
+
+inline float sumaHorizontal(VecF v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    return _mm_cvtss_f32(s);
+}
+
+inline VecF escalarPotencia2(VecF p, VecF n) {
+    __m256i e = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(p, _mm256_castsi256_ps(e));
+}
+
+inline VecF redondear(VecF a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+#elif defined(SIMD_SSE2)
+
+constexpr int ANCHO = 4;
+typedef __m128 VecF;
+
+inline VecF cargar(const float* p) { return _mm_loadu_ps(p); }
+inline void guardar(float* p, VecF v) { _mm_storeu_ps(p, v); }
+inline VecF repetir(float x) { return _mm_set1_ps(x); }
+inline VecF indices() { return _mm_setr_ps(0, 1, 2, 3); }
+
+inline VecF sumar(VecF a, VecF b) { return _mm_add_ps(a, b); }
+inline VecF restar(VecF a, VecF b) { return _mm_sub_ps(a, b); }
+inline VecF multiplicar(VecF a, VecF b) { return _mm_mul_ps(a, b); }
+inline VecF dividir(VecF a, VecF b) { return _mm_div_ps(a, b); }
+inline VecF multSumar(VecF a, VecF b, VecF c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+inline VecF maximo(VecF a, VecF b) { return _mm_max_ps(a, b); }
+inline VecF minimo(VecF a, VecF b) { return _mm_min_ps(a, b); }
+inline VecF raiz(VecF a) { return _mm_sqrt_ps(a); }
+
+inline VecF menorQue(VecF a, VecF b) { return _mm_cmplt_ps(a, b); }
+inline VecF yLogico(VecF a, VecF b) { return _mm_and_ps(a, b); }
+inline VecF seleccionar(VecF mascara, VecF a) { return _mm_and_ps(mascara, a); }
+
+inline float sumaHorizontal(VecF v) {
+    __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    return _mm_cvtss_f32(s);
+}
+
+inline VecF escalarPotencia2(VecF p, VecF n) {
+    __m128i e = _mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23);
+    return _mm_mul_ps(p, _mm_castsi128_ps(e));
+}
+
+inline VecF redondear(VecF a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+
+#else
+
+constexpr int ANCHO = 1;
+typedef float VecF;
+
+inline VecF cargar(const float* p) { return *p; }
+inline void guardar(float* p, VecF v) { *p = v; }
+inline VecF repetir(float x) { return x; }
+inline VecF indices() { return 0.0f; }
+
+inline VecF sumar(VecF a, VecF b) { return a + b; }
+inline VecF restar(VecF a, VecF b) { return a - b; }
+inline VecF multiplicar(VecF a, VecF b) { return a * b; }
+inline VecF dividir(VecF a, VecF b) { return a / b; }
+inline VecF multSumar(VecF a, VecF b, VecF c) { return a * b + c; }
+inline VecF maximo(VecF a, VecF b) { return a > b ? a : b; }
+inline VecF minimo(VecF a, VecF b) { return a < b ? a : b; }
+inline VecF raiz(VecF a) { return std::sqrt(a); }
+
+// En escalar la máscara es 1 (verdadero) o 0 (falso)
+inline VecF menorQue(VecF a, VecF b) { return a < b ? 1.0f : 0.0f; }
+inline VecF yLogico(VecF a, VecF b) { return a * b; }
+inline VecF seleccionar(VecF mascara, VecF a) { return mascara != 0.0f ? a : 0.0f; }
+
+inline float sumaHorizontal(VecF v) { return v; }
+
+inline VecF escalarPotencia2(VecF p, VecF n) { return std::ldexp(p, static_cast<int>(n)); }
+
+inline VecF redondear(VecF a) { return std::nearbyint(a); }
+
+#endif
+
+/**
+ * @brief exp(x) aproximada (error relativo ~1e-7 en [-87, 88])
+ *
+ * Reducción de rango x = n·ln2 + r con |r| <= ln2/2 y polinomio de grado 6
+ * (coeficientes de Cephes); 2^n se arma directamente en el exponente.
+ */
+inline VecF expAprox(VecF x) {
+    x = minimo(maximo(x, repetir(-87.0f)), repetir(88.0f));
+
+    VecF n = redondear(multiplicar(x, repetir(1.44269504088896341f)));
+    VecF r = restar(x, multiplicar(n, repetir(0.693359375f)));
+    r = restar(r, multiplicar(n, repetir(-2.12194440e-4f)));
+
+    VecF p = repetir(1.9875691500e-4f);
+    p = multSumar(p, r, repetir(1.3981999507e-3f));
+    p = multSumar(p, r, repetir(8.3334519073e-3f));
+    p = multSumar(p, r, repetir(4.1665795894e-2f));
+    p = multSumar(p, r, repetir(1.6666665459e-1f));
+    p = multSumar(p, r, repetir(5.0000001201e-1f));
+    p = multSumar(multiplicar(p, r), r, sumar(r, repetir(1.0f)));
+
+    return escalarPotencia2(p, n);
+}
+
+} // namespace simd
+
+#endif // SIMD_H
@@ -2,66 +2,254 @@
 #define SIMULADOR_H
 
 #include <QObject>
+#include <QThread>
 #include <QTimer>
 #include <QElapsedTimer>
+#include <functional>
+#include <string>
 #include <vector>
 #include "Escenario.h"
 #include "AgenteBase.h"
 #include "PathFinder.h"
 #include "EstadisticasSimulacion.h"
+#include "ArchivoTrayectorias.h"
+#include "ExportadorSerie.h"
+#include "RuedaTemporal.h"
+#include "BufferFrames.h"
+#include "CampoDistancias.h"
+#include "MotorFuerzaSocial.h"
+#include "MotorCampoPiso.h"
+#include "PoolHilos.h"
+#include "IndiceEspacial.h"
+#include "AsignadorRescates.h"
+#include "BusEventos.h"
+#include "ObservadorEvento.h"
+#include "PerfiladorTick.h"
+#include "TrazaEventos.h"
 #include <memory>
 
+class Persona;
+class Rescatista;
+
+/**
+ * @brief Cómo se mueven los agentes
+ */
+enum class ModoMovimiento {
+    REJILLA,    // Celda a celda con búsqueda de ruta (un agente por celda)
+    CONTINUO,   // Posiciones reales con el modelo de fuerza social
+    CAMPO_PISO  // Autómata celular de campo de piso (estático + dinámico)
+};
+
+/**
+ * @brief Motor de la simulación
+ *
+ * Los ticks se ejecutan en un hilo propio. El modelo (escenario, agentes,
+ * estadísticas) solo se modifica desde ese hilo: los métodos públicos que lo
+ * tocan se ejecutan allí entre dos ticks y esperan a que terminen. La GUI
+ * no lee el modelo; recibe un FrameSimulacion por tick a través de
+ * getBufferFrames().
+ */
 class Simulador : public QObject {
     Q_OBJECT
 
 public:
-    explicit Simulador(QObject *parent = nullptr);
+    /**
+     * @param numHilos Hilos de los motores continuo y de campo de piso (0 = los núcleos disponibles)
+     */
+    explicit Simulador(QObject *parent = nullptr, unsigned int numHilos = 0);
     ~Simulador();
 
     // Configuración
     void cargarEscenario(int filas, int cols);
     void agregarAgente(std::shared_ptr<AgenteBase> agente);
 
+    // Edición del mapa: se aplica en el hilo de simulación, también con la corrida en marcha
+    void editarCelda(int fila, int columna, int tipo);
+    void reemplazarCeldas(const std::vector<uint8_t>& celdas);
+
     // Control
     void iniciar();
     void pausar();
     void reiniciar();
+    void pasoUnico();  // Avanza un tick (solo con la simulación pausada y sin terminar)
+    bool estaTerminada();
+
+    // Velocidad: intervalo entre ticks, o tan rápido como sea posible
+    void setIntervaloTick(int ms);
+    void setMaximaVelocidad(bool activar);
+
+    // Modo de movimiento (solo antes de iniciar o tras reiniciar)
+    bool setModoMovimiento(ModoMovimiento modo);
+    ModoMovimiento getModoMovimiento() const;
     
     // Acceso para la GUI
     Escenario* getEscenario();
+    BufferFrames* getBufferFrames() { return frames; }
+
+    // Eventos de los agentes: se despachan una vez por tick, en el hilo de simulación
+    BusEventos* getBusEventos() { return bus; }
+
+    // Acceso directo al modelo (solo con la simulación pausada)
     const std::vector<std::shared_ptr<AgenteBase>>& getAgentes() const;
-    
-    // Estadísticas
     EstadisticasSimulacion* getEstadisticas();
+
+    // Estadísticas
     void exportarEstadisticas(const std::string& rutaArchivo);
+    std::string generarReporte();
     void mostrarEstadisticas();
 
+    // Tiempo por fase del tick (requiere compilar con SIMULADOR_PERFILADO)
+    std::string generarReportePerfil();
+    const PerfiladorTick& getPerfilador() const { return perfilador; }  // Solo con la simulación pausada
+
+    // Serie de densidad por celda (una muestra cada INTERVALO_DENSIDAD ticks)
+    bool exportarDensidad(const std::string& rutaArchivo);
+    bool obtenerUltimaDensidad(std::vector<uint8_t>& destino);
+
+    // Grabación de trayectorias (para reproducir la corrida sin re-simular)
+    bool iniciarGrabacion(const std::string& rutaArchivo);
+    void detenerGrabacion();
+    bool estaGrabando();
+
+    // Serie por tick en CSV (la escribe un hilo aparte mientras corre la simulación)
+    bool iniciarExportacionSerie(const std::string& rutaArchivo);
+    void detenerExportacionSerie();
+    bool estaExportandoSerie();
+
+    // Duración simulada de un tick (y el intervalo real por defecto)
+    static constexpr int INTERVALO_TICK_MS = 500;
+
+    // Velocidad efectiva con la que un agente avanza exactamente una celda por tick
+    static constexpr double VELOCIDAD_REFERENCIA = 1.5;
+
 signals:
-    void mundoActualizado();
     void simulacionTerminada();
-    void estadisticasActualizadas(QString resumen);
-
-private slots:
-    void loopPrincipal();
 
 private:
     Escenario* escenario;
     std::vector<std::shared_ptr<AgenteBase>> agentes;
-    QTimer* timer;
-    QElapsedTimer tiempoTranscurrido;
+    QThread* hilo;
+    QTimer* timer;  // Vive en 'hilo'
+    BufferFrames* frames;
+    BusEventos* bus;
+    GestorEventos* gestorEventos;
     bool esActivo;
+    bool preparada;  // Agentes programados y estadísticas iniciadas
+    bool terminada;  // La corrida acabó (todos evacuaron o se estancó); solo reiniciar la reanuda
+
+    // Control de velocidad
+    int intervaloTickMs;
+    bool maximaVelocidad;
+    static constexpr int PRESUPUESTO_LOTE_MS = 16;  // Un frame de pantalla
+
+    // Motores de movimiento en masa (continuo y campo de piso)
+    ModoMovimiento modoMovimiento;
+    CampoDistancias campo;
+    PoolHilos* pool;
+    MotorFuerzaSocial* motorFuerzaSocial;
+    MotorCampoPiso* motorCampoPiso;
+    static constexpr float RAPIDEZ_MINIMA_CONTINUO = 0.05f;  // celdas/s
+
+    std::vector<InstantaneaAgente> instantaneas;
     
     // Sistema de estadísticas
-    EstadisticasSimulacion* estadisticas;
-    std::map<int, int> pasosPorAgente;  // agenteId -> cantidad de pasos
-    std::map<int, QPoint> posicionAnterior;  // Para detectar movimientos
+    EstadisticasSimulacion* estadisticas;  // También lleva los pasos de cada agente
     double tiempoSimulacion;
+    uint32_t tickActual;
+
+    // Grabación de trayectorias
+    GrabadorTrayectorias* grabador;
+
+    // Serie por tick
+    ExportadorSerie* exportadorSerie;
+    std::vector<int> evacuadosPorSalida;  // Acumulados, en el orden de exportadorSerie->getSalidas()
     
     // Detección de estancamiento
     int ticksSinMovimiento;
     int maxTicksSinMovimiento;
-    
+
+    // Planificación por eventos: cada agente se atiende al llegar a su siguiente celda
+    RuedaTemporal rueda;
+    std::vector<RuedaTemporal::Entrada> llegadas;
+    std::vector<std::shared_ptr<AgenteBase>> agentesDetenidos;
+
+    // Agentes dormidos: los que no pudieron avanzar salen de la rueda y solo
+    // vuelven cuando cambia la ocupación cerca de ellos (tiles sucios) o el mapa
+    static constexpr int TAM_TILE = 8;
+    std::vector<int> ocupacion;  // Agentes por celda (fila * columnas + columna)
+    int tilesFilas;
+    int tilesColumnas;
+    std::vector<std::vector<std::shared_ptr<AgenteBase>>> durmientesPorTile;
+    std::vector<uint8_t> tileSucio;
+    std::vector<int> tilesSucios;
+    size_t numDurmientes;
+    unsigned int versionEscenario;
+
+    int agentesEvacuados;
+    ConteoEstados conteoEstados;  // Agentes activos por estado (los mantienen los agentes)
+    PerfiladorTick perfilador;
+
+    // Rescate: personas que necesitan ayuda, indexadas por posición
+    IndiceEspacial indiceAyuda;
+    std::vector<std::shared_ptr<Rescatista>> rescatistas;
+    AsignadorRescates asignador;
+
+    /**
+     * @brief Ejecuta la tarea en el hilo de simulación y espera a que termine
+     */
+    void ejecutarEnHilo(const std::function<void()>& tarea);
+
+    void agregarAgenteEnHilo(const std::shared_ptr<AgenteBase>& agente);
+    void iniciarEnHilo();
+    void prepararSimulacion();
+    void alVencerTimer();
+    bool avanzarTick();  // false cuando la simulación terminó
+    void avanzarRejilla();
+    void avanzarContinuo();
+    void avanzarCampoPiso();
+    void prepararMovimientoContinuo();
+    void prepararCampoPiso();
+    bool actualizarCampoDistancias();  // true si el mapa cambió
+    void registrarCambioCelda(const std::shared_ptr<AgenteBase>& agente, Posicion desde, Posicion hasta);
+    void retirarEvacuados(const std::vector<std::shared_ptr<AgenteBase>>& evacuadosMotor);
+    void capturarAgentes(std::vector<InstantaneaAgente>& destino) const;
+    void terminarSimulacion();
+    void reiniciarEnHilo();
+    bool iniciarGrabacionEnHilo(const std::string& rutaArchivo);
+    bool iniciarExportacionSerieEnHilo(const std::string& rutaArchivo);
+    void registrarSerie();
+    void publicarFrame();
+
+    enum class ResultadoPaso {
+        MOVIDO,
+        DETENIDO,
+        EVACUADO,
+        CARGADA     // Persona que lleva un rescatista: no se vuelve a programar
+    };
+
+    ResultadoPaso procesarAgente(const std::shared_ptr<AgenteBase>& agente);
+    bool comprobarColision(Posicion destino);  // true (y registra el choque) si el destino está ocupado
+    void recogerPersona(const std::shared_ptr<Rescatista>& rescatista, const std::shared_ptr<Persona>& persona);
+    void evacuarAgente(const std::shared_ptr<AgenteBase>& agente, Posicion salida);
+    uint64_t calcularIntervaloSubticks(const AgenteBase& agente) const;
+    void programarAgentes();
+
+    int indiceCelda(Posicion celda) const;
+    void liberarCelda(Posicion celda);
+    void ocuparCelda(Posicion celda);
+    int tileDe(Posicion celda) const;
+    void marcarTileSucio(int tile);
+    void dormirAgente(std::shared_ptr<AgenteBase> agente);
+    void despertarTilesSucios();
+    void despertarTodos();
+
+    void actualizarIndiceAyuda(const std::shared_ptr<AgenteBase>& agente);
+    void atenderRescatistas();
+
     void detectarEstancamiento();
+
+    // bench/simulador_bench.cpp mide pasos sueltos del tick sobre un simulador real
+    friend class AccesoBancoSimulador;
 };
 
 #endif
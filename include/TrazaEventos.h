@@ -0,0 +1,128 @@
+#ifndef TRAZAEVENTOS_H
+#define TRAZAEVENTOS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Traza de intervalos en el formato de eventos de Chrome (JSON)
+ *
+ * Cada hilo escribe en su propio búfer de tamaño fijo: anotar un intervalo
+ * no toma locks ni comparte líneas de caché con otros hilos. El mutex solo
+ * se usa la primera vez que un hilo anota algo (para tomar un búfer), al
+ * terminar el hilo (para devolverlo) y al exportar. Si un búfer se llena,
+ * los intervalos siguientes se descartan y se cuentan.
+ *
+ * Un búfer devuelto lo toma el próximo hilo que empiece a anotar y sigue
+ * escribiendo a continuación, en el mismo carril: la memoria depende de
+ * cuántos hilos anotan a la vez y no de cuántos se crearon.
+ *
+ * El archivo exportado se abre con chrome://tracing o ui.perfetto.dev: un
+ * carril por hilo (simulación, trabajadores del pool, GUI, escritores).
+ *
+ * Con la traza detenida, TRAZAR solo lee un flag atómico.
+ */
+class TrazaEventos {
+public:
+    static constexpr size_t CAPACIDAD_POR_HILO = 1 << 16;
+
+    static TrazaEventos& global();
+
+    /**
+     * @brief Descarta lo anotado y empieza a anotar (no en paralelo con exportar())
+     */
+    void iniciar();
+    void detener();
+    bool estaActiva() const { return activa.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Nombre del carril del hilo que llama
+     */
+    static void nombrarHilo(const char* nombre);
+
+    /**
+     * @brief Anota un intervalo del hilo que llama
+     * @param nombre y categoria deben ser literales (se guarda el puntero)
+     */
+    void anotar(const char* nombre, const char* categoria, uint64_t inicioNs, uint64_t finNs);
+
+    /**
+     * @brief Escribe todo lo anotado desde iniciar() (puede llamarse con la traza activa)
+     */
+    bool exportar(const std::string& ruta);
+
+    uint64_t getDescartados() const;
+
+    static uint64_t ahoraNs();
+
+private:
+    struct Intervalo {
+        const char* nombre;
+        const char* categoria;
+        uint64_t inicioNs;
+        uint64_t duracionNs;
+    };
+
+    struct BufferHilo {
+        std::unique_ptr<Intervalo[]> intervalos;
+        std::atomic<size_t> cantidad;     // Publicada con release por el dueño
+        std::atomic<uint32_t> generacion;  // Sesión a la que pertenecen los intervalos
+        std::atomic<uint64_t> descartados;
+        std::atomic<const char*> nombre;
+        uint32_t idHilo;
+    };
+
+    std::atomic<bool> activa;
+    std::atomic<uint32_t> generacion;
+    uint64_t origenNs;
+
+    // Devuelve el búfer del hilo a la lista de libres cuando el hilo termina
+    struct DuenoBuffer {
+        BufferHilo* buffer = nullptr;
+        ~DuenoBuffer();
+    };
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<BufferHilo>> buffers;
+    std::vector<BufferHilo*> libres;  // De hilos que ya terminaron
+    static thread_local BufferHilo* bufferHiloActual;
+    static thread_local DuenoBuffer duenoBufferHilo;
+
+    TrazaEventos();
+    BufferHilo* bufferDelHilo();
+    void devolverBuffer(BufferHilo* buffer);
+};
+
+/**
+ * @brief Anota el intervalo desde su construcción hasta el final del bloque
+ */
+class IntervaloTraza {
+public:
+    IntervaloTraza(const char* nombre, const char* categoria)
+        : nombre(nombre), categoria(categoria),
+          inicio(TrazaEventos::global().estaActiva() ? TrazaEventos::ahoraNs() : 0) {}
+    ~IntervaloTraza() {
+        if (inicio != 0 && TrazaEventos::global().estaActiva()) {
+            TrazaEventos::global().anotar(nombre, categoria, inicio, TrazaEventos::ahoraNs());
+        }
+    }
+
+    IntervaloTraza(const IntervaloTraza&) = delete;
+    IntervaloTraza& operator=(const IntervaloTraza&) = delete;
+
+private:
+    const char* nombre;
+    const char* categoria;
+    uint64_t inicio;
+};
+
+#define TRAZA_CONCATENAR_(a, b) a##b
+#define TRAZA_CONCATENAR(a, b) TRAZA_CONCATENAR_(a, b)
+#define TRAZAR(nombre, categoria) IntervaloTraza TRAZA_CONCATENAR(intervaloTraza_, __LINE__)((nombre), (categoria))
+
+#endif // TRAZAEVENTOS_H
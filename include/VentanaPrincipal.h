@@ -14,6 +14,7 @@
 #include <QHBoxLayout>
 #include <QGroupBox>
 #include <QSlider>
+#include <QCheckBox>
 #include "Simulador.h"
 #include "VistaEscenario.h"
 #include "FactoriaAgentes.h"
@@ -46,17 +47,32 @@ private slots:
     void iniciarSimulacion();
     void pausarSimulacion();
     void reiniciarSimulacion();
+    void avanzarUnTick();
     void actualizarVista();
     void onSimulacionTerminada();
 
     // Slots de herramientas
     void cambiarHerramienta(int index);
     void cambiarVelocidadSimulacion(int valor);
+    void cambiarMaximaVelocidad(bool activar);
+    void cambiarModoMovimiento(int index);
+    void cambiarMostrarDensidad(bool mostrar);
 
     // Slots de estadísticas
     void actualizarEstadisticas();
-    void actualizarEstadisticasTexto(QString resumen);
     void mostrarReporteCompleto();
+    void mostrarPerfil();
+    void exportarDensidad();
+    void exportarSerie(bool activar);
+    void grabarTraza(bool activar);
+
+    // Slots de grabación y reproducción de trayectorias
+    void grabarTrayectoria(bool activar);
+    void abrirTrayectoria();
+    void moverLineaTiempo(int tick);
+    void alternarReproduccion();
+    void avanzarReproduccion();
+    void salirReproduccion();
 
 private:
     // Métodos de inicialización
@@ -64,11 +80,14 @@ private:
     void crearBarraHerramientas();
     void crearPanelControl();
     void crearPanelEstadisticas();
+    void crearPanelReproduccion();
     void configurarLayout();
     void conectarSeñales();
 
     // Métodos auxiliares
     void actualizarEstadoBotones(bool simulacionActiva);
+    void actualizarDensidad(uint32_t tick);
+    bool validarInicioSimulacion();
     QString obtenerNombreHerramienta(int index) const;
 
     // Componentes principales
@@ -80,6 +99,9 @@ private:
     QMenu* menuArchivo;
     QMenu* menuSimulacion;
     QMenu* menuAyuda;
+    QAction* accionGrabarTrayectoria;
+    QAction* accionExportarSerie;
+    QAction* accionGrabarTraza;
 
     // Barra de herramientas
     QToolBar* barraHerramientas;
@@ -89,8 +111,12 @@ private:
     QPushButton* btnIniciar;
     QPushButton* btnPausar;
     QPushButton* btnReiniciar;
+    QPushButton* btnPaso;
     QSlider* sliderVelocidad;
     QLabel* lblVelocidad;
+    QCheckBox* chkMaximaVelocidad;
+    QComboBox* comboMovimiento;
+    QCheckBox* chkMostrarDensidad;
 
     // Panel de herramientas de dibujo
     QGroupBox* panelHerramientas;
@@ -114,10 +140,19 @@ private:
     QLabel* lblEstadisticasResumen;
     QPushButton* btnVerEstadisticas;
 
+    // Panel de reproducción de trayectorias
+    QGroupBox* panelReproduccion;
+    QSlider* sliderLineaTiempo;
+    QLabel* lblLineaTiempo;
+    QPushButton* btnReproducir;
+    QPushButton* btnSalirReproduccion;
+    QTimer* timerReproduccion;
+    std::shared_ptr<LectorTrayectorias> lectorTrayectorias;
+
     // Estado de la aplicación
     bool simulacionEnEjecucion;
-    int tiempoSimulacion;
     QString archivoActual;
+    int64_t muestraDensidadMostrada;  // -1 = ninguna
 };
 
 #endif // VENTANAPRINCIPAL_H
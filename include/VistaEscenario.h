@@ -5,9 +5,13 @@
 #include <QPainter>
 #include <QMouseEvent>
 #include <QPoint>
+#include <QTimer>
 #include "Escenario.h"
 #include "AgenteBase.h"
 #include "FactoriaAgentes.h"
+#include "FrameAgentes.h"
+#include "ArchivoTrayectorias.h"
+#include "BufferFrames.h"
 #include <memory>
 
 /**
@@ -22,6 +26,20 @@ enum class HerramientaDibujo {
     BORRAR
 };
 
+/**
+ * @brief Lo que el editor recuerda de un agente que colocó
+ *
+ * Es una copia tomada al crearlo: el agente pasa al simulador y desde ese
+ * momento solo lo toca el hilo de simulación.
+ */
+struct AgenteColocado {
+    int id;
+    Posicion celda;           // Donde se colocó (no donde está ahora)
+    TipoComportamiento tipo;
+    int edad;                 // Solo personas
+    bool movilidadReducida;   // Solo personas
+};
+
 /**
  * @brief Widget personalizado para visualizar y editar el escenario
  *
@@ -40,7 +58,7 @@ public:
 
     // Configuración del escenario
     void setEscenario(Escenario* esc);
-    void setAgentes(const std::vector<std::shared_ptr<AgenteBase>>* ags);
+    void setFuenteFrames(BufferFrames* buffer);
     void setFactoria(FactoriaAgentes* fact);
 
     // Configuración de herramientas
@@ -49,20 +67,32 @@ public:
     void setMovilidadReducida(bool reducida);
 
     // Limpieza
-    void limpiarEscenario();
     void limpiarAgentes();
 
-    // Tamaño del escenario
-    void redimensionarEscenario(int filas, int columnas);
+    // Reproducción de trayectorias grabadas
+    void iniciarReproduccion(std::shared_ptr<LectorTrayectorias> lector);
+    void detenerReproduccion();
+    bool enModoReproduccion() const { return lectorReproduccion != nullptr; }
+    void mostrarTick(uint32_t tick);
 
-    // Acceso a agentes creados
-    //const std::vector<AgenteBase*>& getAgentesCreados() const { return agentesCreados; }
-    const std::vector<std::shared_ptr<AgenteBase>>& getAgentesCreados() const { return agentesCreados; }
+    // Capa de densidad (agentes por celda, filas * columnas bytes)
+    void setMapaDensidad(const std::vector<uint8_t>& conteo);
+    void ocultarDensidad();
+
+    // Frames publicados por el simulador
+    bool sincronizarFrame();
+    const FrameSimulacion& getFrameActual() const;
+
+    // Agentes colocados con el editor (copias; los vivos los tiene el simulador)
+    const std::vector<AgenteColocado>& getAgentesColocados() const { return agentesColocados; }
 
 signals:
+    // La vista no escribe el mapa: pide cada cambio de celda a quien lo posee
+    void celdaEditada(int fila, int columna, int tipo);
     void escenarioModificado();
     void agenteAgregado(std::shared_ptr<AgenteBase> agente);
     void infoActualizada(const QString& info);
+    void frameActualizado();
 
 protected:
     void paintEvent(QPaintEvent *event) override;
@@ -77,8 +107,9 @@ private:
     void dibujarGrid(QPainter& painter);
     void dibujarCelda(QPainter& painter, int fila, int col);
     void dibujarAgentes(QPainter& painter);
-    void dibujarAgente(QPainter& painter, AgenteBase* agente);
+    void dibujarInstantanea(QPainter& painter, const InstantaneaAgente& agente);
     void dibujarGuias(QPainter& painter);
+    void dibujarDensidad(QPainter& painter);
 
     // Métodos de interacción
     void procesarClick(QPoint pos);
@@ -97,14 +128,25 @@ private:
     // Métodos auxiliares
     void calcularTamañoCelda();
     QColor obtenerColorCelda(int tipoCelda) const;
-    QColor obtenerColorAgente(AgenteBase* agente) const;
-    bool posicionOcupada(QPoint pos) const;
+    QColor obtenerColorAgente(const InstantaneaAgente& agente) const;
+    bool posicionOcupada(Posicion pos) const;
 
     // Datos
     Escenario* escenario;
-    const std::vector<std::shared_ptr<AgenteBase>>* agentes;
     FactoriaAgentes* factoria;
-    std::vector<std::shared_ptr<AgenteBase>> agentesCreados;
+    std::vector<AgenteColocado> agentesColocados;
+
+    // Reproducción: el escenario grabado reemplaza al de edición mientras dura
+    std::shared_ptr<LectorTrayectorias> lectorReproduccion;
+    std::unique_ptr<Escenario> escenarioReproduccion;
+    Escenario* escenarioEdicion;
+    FrameAgentes frameReproduccion;
+
+    // Simulación: la vista solo lee los frames publicados, nunca el modelo
+    BufferFrames* fuenteFrames;
+    FrameSimulacion frameVacio;
+    QTimer* timerRefresco;
+    std::vector<uint8_t> mapaDensidad;  // Vacío = capa oculta
 
     // Configuración de visualización
     int tamañoCelda;
@@ -126,6 +168,7 @@ private:
     static constexpr int TAMAÑO_CELDA_DEFAULT = 30;
     static constexpr int MARGEN = 20;
     static constexpr float ESCALA_ZOOM_FACTOR = 1.1f;
+    static constexpr int INTERVALO_REFRESCO_MS = 16;  // ~60 fps
 };
 
 #endif // VISTAESCENARIO_H
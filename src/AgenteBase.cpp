@@ -1,5 +1,4 @@
 #include "../include/AgenteBase.h"
-#include "../include/ObservadorEvento.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream> // Para debug si hace falta
@@ -7,14 +6,17 @@
 /**
  * Constructor de AgenteBase
  */
-AgenteBase::AgenteBase(int id, Posicion posInicial, double velocidad, TipoComportamiento tipo)
+AgenteBase::AgenteBase(int id, Posicion posInicial, double velocidad, TipoComportamiento tipo, TipoAgente tipoAgente)
     : id(id), 
       posicion(posInicial), 
       destino(posInicial),
       velocidad(velocidad), 
       estado(EstadoAgente::NORMAL),
       tipoComportamiento(tipo),
-      indiceRutaActual(0) {
+      tipoAgente(tipoAgente),
+      indiceRutaActual(0),
+      bus(nullptr),
+      conteoEstados(nullptr) {
 }
 
 /**
@@ -25,14 +27,14 @@ void AgenteBase::establecerRuta(const std::vector<Posicion>& nuevaRuta) {
     indiceRutaActual = 0;
     if (!ruta.empty()) {
         destino = ruta[0];
-        estado = EstadoAgente::EVACUANDO;
-        notificarEvento("INICIO_EVACUACION");
+        cambiarEstado(EstadoAgente::EVACUANDO);
+        notificarEvento(TipoEvento::INICIO_EVACUACION);
     }
 }
 
 /**
  * Mueve al agente hacia el siguiente punto de la ruta
- * ADAPTADO PARA QT (QPoint usa enteros)
+ * Posicion usa enteros (celdas de la rejilla)
  */
 void AgenteBase::moverSiguientePunto(double deltaTime) {
     if (ruta.empty() || indiceRutaActual >= (int)ruta.size()) {
@@ -55,8 +57,8 @@ void AgenteBase::moverSiguientePunto(double deltaTime) {
 
         indiceRutaActual++;
         if (indiceRutaActual >= (int)ruta.size()) {
-            estado = EstadoAgente::EVACUADO;
-            notificarEvento("EVACUADO");
+            cambiarEstado(EstadoAgente::EVACUADO);
+            notificarEvento(TipoEvento::EVACUADO);
             return;
         }
         // Recalcular para el nuevo objetivo
@@ -76,8 +78,8 @@ void AgenteBase::moverSiguientePunto(double deltaTime) {
         double velocidadEfectiva = calcularVelocidadEfectiva();
         double movimiento = velocidadEfectiva * deltaTime;
 
-        // --- ADAPTACIÓN CRÍTICA PARA QPOINT (ENTEROS) ---
-        // QPoint no guarda decimales. Si sumamos 0.2, se queda igual.
+        // --- ADAPTACIÓN CRÍTICA PARA POSICIONES ENTERAS ---
+        // Posicion no guarda decimales. Si sumamos 0.2, se queda igual.
         // Solución para Grid: Si el movimiento acumulado es suficiente, damos un paso.
         // O más simple para el deadline: Usar round() para saltar al siguiente pixel.
         
@@ -108,21 +110,21 @@ bool AgenteBase::haLlegadoDestino() const {
  */
 void AgenteBase::setEstado(EstadoAgente nuevoEstado) {
     if (estado != nuevoEstado) {
-        estado = nuevoEstado;
+        cambiarEstado(nuevoEstado);
         
         // Notificar cambio de estado
         switch (nuevoEstado) {
             case EstadoAgente::EVACUANDO:
-                notificarEvento("EVACUANDO");
+                notificarEvento(TipoEvento::EVACUANDO);
                 break;
             case EstadoAgente::PANICO:
-                notificarEvento("PANICO");
+                notificarEvento(TipoEvento::PANICO);
                 break;
             case EstadoAgente::EVACUADO:
-                notificarEvento("EVACUADO");
+                notificarEvento(TipoEvento::EVACUADO);
                 break;
             case EstadoAgente::BLOQUEADO:
-                notificarEvento("BLOQUEADO");
+                notificarEvento(TipoEvento::BLOQUEADO);
                 break;
             default:
                 break;
@@ -131,27 +133,31 @@ void AgenteBase::setEstado(EstadoAgente nuevoEstado) {
 }
 
 /**
- * Agrega un observador para recibir notificaciones
+ * Cambia el estado y mueve al agente entre los contadores por estado
  */
-void AgenteBase::agregarObservador(std::weak_ptr<ObservadorEvento> observador) {
-    observadores.push_back(observador);
+void AgenteBase::cambiarEstado(EstadoAgente nuevoEstado) {
+    if (conteoEstados && estado != nuevoEstado) {
+        conteoEstados->sumar(estado, -1);
+        conteoEstados->sumar(nuevoEstado, 1);
+    }
+    estado = nuevoEstado;
+}
+
+void AgenteBase::setConteoEstados(ConteoEstados* conteo) {
+    if (conteoEstados) {
+        conteoEstados->sumar(estado, -1);
+    }
+    conteoEstados = conteo;
+    if (conteoEstados) {
+        conteoEstados->sumar(estado, 1);
+    }
 }
 
 /**
- * Notifica a todos los observadores sobre un evento
+ * Publica un evento en el bus (si el agente está en un simulador)
  */
-void AgenteBase::notificarEvento(const std::string& evento) {
-    // Limpiar observadores expirados usando lambda
-    observadores.erase(
-        std::remove_if(observadores.begin(), observadores.end(),
-                       [](const std::weak_ptr<ObservadorEvento>& wp) { return wp.expired(); }),
-        observadores.end()
-    );
-    
-    // Notificar a todos los observadores válidos
-    for (auto& weakObs : observadores) {
-        if (auto obs = weakObs.lock()) {
-            obs->onEventoAgente(this, evento);
-        }
+void AgenteBase::notificarEvento(TipoEvento evento, int32_t dato) {
+    if (bus) {
+        bus->publicar(evento, id, posicion.x(), posicion.y(), dato);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,411 @@
+#include "../include/ArchivoColumnar.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char MAGIA_CABECERA[4] = {'C', 'O', 'L', 'S'};
+const char MAGIA_EPILOGO[4] = {'C', 'O', 'L', 'X'};
+const uint32_t VERSION_FORMATO = 1;
+
+const size_t ALINEACION = 8;
+const size_t TAM_ENTRADA_FRAGMENTO = 8 + 8;
+const size_t TAM_EPILOGO = 8 + 8 + 4 + 4;
+
+template <typename T>
+void anexar(std::vector<uint8_t>& buffer, T valor) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&valor);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T leerValor(const uchar* p) {
+    T valor;
+    std::memcpy(&valor, p, sizeof(T));
+    return valor;
+}
+
+void rellenar(std::vector<uint8_t>& buffer) {
+    buffer.resize((buffer.size() + ALINEACION - 1) / ALINEACION * ALINEACION, 0);
+}
+
+void escribirVarint(std::vector<uint8_t>& salida, uint64_t valor) {
+    while (valor >= 0x80) {
+        salida.push_back(static_cast<uint8_t>(valor | 0x80));
+        valor >>= 7;
+    }
+    salida.push_back(static_cast<uint8_t>(valor));
+}
+
+// Devuelve false si el varint se sale del fragmento
+bool leerVarint(const uchar*& p, const uchar* fin, uint64_t& valor) {
+    valor = 0;
+    for (int desplazamiento = 0; p < fin && desplazamiento < 64; desplazamiento += 7) {
+        const uchar byte = *p++;
+        valor |= static_cast<uint64_t>(byte & 0x7F) << desplazamiento;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t tamanoTipo(TipoColumna tipo) {
+    switch (tipo) {
+        case TipoColumna::ENTERO32: return sizeof(int32_t);
+        case TipoColumna::REAL64: return sizeof(double);
+        case TipoColumna::BYTE: return sizeof(uint8_t);
+    }
+    return 0;
+}
+
+template <typename T>
+void codificarRle(const uint8_t* crudos, size_t n, std::vector<uint8_t>& salida) {
+    size_t i = 0;
+    while (i < n) {
+        size_t j = i + 1;
+        while (j < n && std::memcmp(crudos + j * sizeof(T), crudos + i * sizeof(T), sizeof(T)) == 0) {
+            ++j;
+        }
+        escribirVarint(salida, j - i);
+        salida.insert(salida.end(), crudos + i * sizeof(T), crudos + (i + 1) * sizeof(T));
+        i = j;
+    }
+}
+
+void codificarDelta(const uint8_t* crudos, size_t n, std::vector<uint8_t>& salida) {
+    int64_t anterior = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const int64_t valor = leerValor<int32_t>(crudos + i * sizeof(int32_t));
+        const int64_t diferencia = valor - anterior;
+        escribirVarint(salida, static_cast<uint64_t>((diferencia << 1) ^ (diferencia >> 63)));
+        anterior = valor;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// EscritorColumnas
+// ============================================================================
+
+EscritorColumnas::EscritorColumnas(uint32_t filasPorGrupo)
+    : filasPorGrupo(std::max<uint32_t>(1, filasPorGrupo)), filasGrupo(0), totalFilas(0), posicion(0) {
+}
+
+EscritorColumnas::~EscritorColumnas() {
+    cerrar();
+}
+
+bool EscritorColumnas::abrir(const std::string& ruta, const std::vector<DefinicionColumna>& definicion) {
+    cerrar();
+
+    archivo.open(ruta, std::ios::binary | std::ios::trunc);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    esquema = definicion;
+    for (DefinicionColumna& columna : esquema) {
+        if (columna.compresion == CompresionColumna::DELTA && columna.tipo != TipoColumna::ENTERO32) {
+            columna.compresion = CompresionColumna::RLE;
+        }
+    }
+    valores.assign(esquema.size(), std::vector<uint8_t>());
+    filasPorGrupoEscrito.clear();
+    indice.clear();
+    filasGrupo = 0;
+    totalFilas = 0;
+    posicion = 0;
+
+    fragmento.clear();
+    fragmento.insert(fragmento.end(), MAGIA_CABECERA, MAGIA_CABECERA + 4);
+    anexar<uint32_t>(fragmento, VERSION_FORMATO);
+    anexar<uint32_t>(fragmento, static_cast<uint32_t>(esquema.size()));
+    for (const DefinicionColumna& columna : esquema) {
+        anexar<uint8_t>(fragmento, static_cast<uint8_t>(columna.tipo));
+        anexar<uint8_t>(fragmento, static_cast<uint8_t>(columna.compresion));
+        anexar<uint16_t>(fragmento, static_cast<uint16_t>(columna.nombre.size()));
+        fragmento.insert(fragmento.end(), columna.nombre.begin(), columna.nombre.end());
+    }
+    rellenar(fragmento);
+    escribir(fragmento);
+    return archivo.good();
+}
+
+void EscritorColumnas::terminarFila() {
+    if (!archivo.is_open()) return;
+
+    // Una columna sin valor en esta fila queda en cero
+    ++filasGrupo;
+    for (size_t c = 0; c < esquema.size(); ++c) {
+        valores[c].resize(filasGrupo * tamanoTipo(esquema[c].tipo), 0);
+    }
+    ++totalFilas;
+    if (filasGrupo == filasPorGrupo) {
+        escribirGrupo();
+    }
+}
+
+void EscritorColumnas::escribirGrupo() {
+    if (filasGrupo == 0) return;
+
+    for (size_t c = 0; c < esquema.size(); ++c) {
+        const uint8_t* crudos = valores[c].data();
+        fragmento.clear();
+        switch (esquema[c].compresion) {
+            case CompresionColumna::PLANA:
+                fragmento.assign(valores[c].begin(), valores[c].end());
+                break;
+            case CompresionColumna::DELTA:
+                codificarDelta(crudos, filasGrupo, fragmento);
+                break;
+            case CompresionColumna::RLE:
+                if (esquema[c].tipo == TipoColumna::ENTERO32) {
+                    codificarRle<int32_t>(crudos, filasGrupo, fragmento);
+                } else if (esquema[c].tipo == TipoColumna::REAL64) {
+                    codificarRle<double>(crudos, filasGrupo, fragmento);
+                } else {
+                    codificarRle<uint8_t>(crudos, filasGrupo, fragmento);
+                }
+                break;
+        }
+        indice.push_back(Fragmento{posicion, fragmento.size()});
+        rellenar(fragmento);
+        escribir(fragmento);
+        valores[c].clear();
+    }
+    filasPorGrupoEscrito.push_back(filasGrupo);
+    filasGrupo = 0;
+}
+
+void EscritorColumnas::escribir(const std::vector<uint8_t>& bytes) {
+    archivo.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    posicion += bytes.size();
+}
+
+bool EscritorColumnas::cerrar() {
+    if (!archivo.is_open()) return true;
+
+    escribirGrupo();
+
+    const uint64_t offsetIndice = posicion;
+    fragmento.clear();
+    for (size_t g = 0; g < filasPorGrupoEscrito.size(); ++g) {
+        anexar<uint32_t>(fragmento, filasPorGrupoEscrito[g]);
+        for (size_t c = 0; c < esquema.size(); ++c) {
+            const Fragmento& f = indice[g * esquema.size() + c];
+            anexar<uint64_t>(fragmento, f.offset);
+            anexar<uint64_t>(fragmento, f.bytes);
+        }
+    }
+    anexar<uint64_t>(fragmento, offsetIndice);
+    anexar<uint64_t>(fragmento, totalFilas);
+    anexar<uint32_t>(fragmento, static_cast<uint32_t>(filasPorGrupoEscrito.size()));
+    fragmento.insert(fragmento.end(), MAGIA_EPILOGO, MAGIA_EPILOGO + 4);
+    escribir(fragmento);
+
+    const bool ok = archivo.good();
+    archivo.close();
+    valores.clear();
+    indice.clear();
+    filasPorGrupoEscrito.clear();
+    return ok;
+}
+
+// ============================================================================
+// LectorColumnas
+// ============================================================================
+
+LectorColumnas::LectorColumnas() : datos(nullptr), tamano(0), numFilas(0) {
+}
+
+LectorColumnas::~LectorColumnas() {
+    cerrar();
+}
+
+bool LectorColumnas::abrir(const QString& ruta) {
+    cerrar();
+
+    archivo.setFileName(ruta);
+    if (!archivo.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    tamano = archivo.size();
+    if (tamano < static_cast<qint64>(12 + TAM_EPILOGO)) {
+        cerrar();
+        return false;
+    }
+
+    datos = archivo.map(0, tamano);
+    if (!datos || std::memcmp(datos, MAGIA_CABECERA, 4) != 0 ||
+        leerValor<uint32_t>(datos + 4) != VERSION_FORMATO) {
+        cerrar();
+        return false;
+    }
+
+    // Epílogo al final del archivo: ubica el índice
+    const uchar* epilogo = datos + tamano - TAM_EPILOGO;
+    if (std::memcmp(epilogo + 20, MAGIA_EPILOGO, 4) != 0) {
+        cerrar();  // Escritura interrumpida sin cerrar
+        return false;
+    }
+    const uint64_t offsetIndice = leerValor<uint64_t>(epilogo);
+    numFilas = leerValor<uint64_t>(epilogo + 8);
+    const uint32_t numGrupos = leerValor<uint32_t>(epilogo + 16);
+
+    // Los valores del epílogo no son confiables: se compara sin sumar para que nada dé la vuelta
+    const uint64_t finIndice = static_cast<uint64_t>(tamano) - TAM_EPILOGO;
+    if (offsetIndice > finIndice) {
+        cerrar();
+        return false;
+    }
+
+    // Esquema
+    const uint32_t numColumnas = leerValor<uint32_t>(datos + 8);
+    const uchar* p = datos + 12;
+    const uchar* finCabecera = datos + std::min<uint64_t>(offsetIndice, static_cast<uint64_t>(tamano));
+    for (uint32_t c = 0; c < numColumnas; ++c) {
+        if (p + 4 > finCabecera) {
+            cerrar();
+            return false;
+        }
+        DefinicionColumna columna;
+        columna.tipo = static_cast<TipoColumna>(p[0]);
+        columna.compresion = static_cast<CompresionColumna>(p[1]);
+        const uint16_t largo = leerValor<uint16_t>(p + 2);
+        p += 4;
+        if (p + largo > finCabecera || tamanoTipo(columna.tipo) == 0) {
+            cerrar();
+            return false;
+        }
+        columna.nombre.assign(reinterpret_cast<const char*>(p), largo);
+        p += largo;
+        columnas.push_back(std::move(columna));
+    }
+
+    // El índice ocupa exactamente lo que hay entre su offset y el epílogo
+    const uint64_t tamanoEntrada = 4 + static_cast<uint64_t>(numColumnas) * TAM_ENTRADA_FRAGMENTO;
+    const uint64_t tamanoIndice = finIndice - offsetIndice;
+    if (tamanoIndice % tamanoEntrada != 0 || tamanoIndice / tamanoEntrada != numGrupos) {
+        cerrar();
+        return false;
+    }
+
+    // Índice de fragmentos
+    p = datos + offsetIndice;
+    uint64_t filasLeidas = 0;
+    for (uint32_t g = 0; g < numGrupos; ++g) {
+        filasGrupo.push_back(leerValor<uint32_t>(p));
+        filasLeidas += filasGrupo.back();
+        p += 4;
+        for (uint32_t c = 0; c < numColumnas; ++c) {
+            Fragmento f{leerValor<uint64_t>(p), leerValor<uint64_t>(p + 8)};
+            p += TAM_ENTRADA_FRAGMENTO;
+            const uint64_t minimo = columnas[c].compresion == CompresionColumna::PLANA
+                ? static_cast<uint64_t>(filasGrupo.back()) * tamanoTipo(columnas[c].tipo) : 0;
+            if (f.offset % ALINEACION != 0 || f.bytes < minimo || f.offset > offsetIndice ||
+                f.bytes > offsetIndice - f.offset) {
+                cerrar();
+                return false;
+            }
+            indice.push_back(f);
+        }
+    }
+    if (filasLeidas != numFilas) {
+        cerrar();
+        return false;
+    }
+    return true;
+}
+
+void LectorColumnas::cerrar() {
+    if (datos) {
+        archivo.unmap(const_cast<uchar*>(datos));
+        datos = nullptr;
+    }
+    if (archivo.isOpen()) {
+        archivo.close();
+    }
+    tamano = 0;
+    numFilas = 0;
+    columnas.clear();
+    filasGrupo.clear();
+    indice.clear();
+}
+
+int LectorColumnas::buscarColumna(const std::string& nombre) const {
+    for (size_t c = 0; c < columnas.size(); ++c) {
+        if (columnas[c].nombre == nombre) {
+            return static_cast<int>(c);
+        }
+    }
+    return -1;
+}
+
+bool LectorColumnas::leer(size_t columna, size_t grupo, std::vector<int32_t>& destino) const {
+    return decodificar(columna, grupo, destino);
+}
+
+bool LectorColumnas::leer(size_t columna, size_t grupo, std::vector<double>& destino) const {
+    return decodificar(columna, grupo, destino);
+}
+
+bool LectorColumnas::leer(size_t columna, size_t grupo, std::vector<uint8_t>& destino) const {
+    return decodificar(columna, grupo, destino);
+}
+
+template <typename T>
+bool LectorColumnas::decodificar(size_t columna, size_t grupo, std::vector<T>& destino) const {
+    destino.clear();
+    if (!datos || columna >= columnas.size() || grupo >= filasGrupo.size() ||
+        columnas[columna].tipo != TipoColumnaDe<T>::valor) {
+        return false;
+    }
+
+    const size_t n = filasGrupo[grupo];
+    const Fragmento& f = fragmento(columna, grupo);
+    const uchar* p = datos + f.offset;
+    const uchar* fin = p + f.bytes;
+    destino.resize(n);
+
+    switch (columnas[columna].compresion) {
+        case CompresionColumna::PLANA:
+            std::memcpy(destino.data(), p, n * sizeof(T));
+            return true;
+
+        case CompresionColumna::DELTA: {
+            int64_t valor = 0;
+            for (size_t i = 0; i < n; ++i) {
+                uint64_t zigzag;
+                if (!leerVarint(p, fin, zigzag)) {
+                    destino.clear();
+                    return false;
+                }
+                valor += static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+                destino[i] = static_cast<T>(valor);
+            }
+            return true;
+        }
+
+        case CompresionColumna::RLE: {
+            size_t i = 0;
+            while (i < n) {
+                uint64_t repeticiones;
+                if (!leerVarint(p, fin, repeticiones) || repeticiones == 0 || repeticiones > n - i ||
+                    p + sizeof(T) > fin) {
+                    destino.clear();
+                    return false;
+                }
+                const T valor = leerValor<T>(p);
+                p += sizeof(T);
+                std::fill(destino.begin() + i, destino.begin() + i + repeticiones, valor);
+                i += repeticiones;
+            }
+            return true;
+        }
+    }
+    destino.clear();
+    return false;
+}
@@ -0,0 +1,377 @@
+#include "../include/ArchivoTrayectorias.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char MAGIA_CABECERA[4] = {'T', 'R', 'A', 'Y'};
+const char MAGIA_EPILOGO[4] = {'T', 'R', 'I', 'X'};
+const uint32_t VERSION_FORMATO = 1;
+
+const uint8_t BLOQUE_KEYFRAME = 0;
+const uint8_t BLOQUE_DELTA = 1;
+
+// Un registro con esta clase indica que el agente salió de la simulación
+const uint8_t CLASE_ELIMINADO = 0xFF;
+
+const size_t TAM_CABECERA = 4 + 4 + 4 + 4 + 4 + 8;
+const size_t TAM_CABECERA_BLOQUE = 4 + 1 + 4;
+const size_t TAM_REGISTRO = 4 + 4 + 4 + 1 + 1;
+const size_t TAM_ENTRADA_INDICE = 4 + 8;
+const size_t TAM_EPILOGO = 8 + 4 + 4 + 4 + 4;
+
+template <typename T>
+void anexar(std::vector<char>& buffer, T valor) {
+    const char* bytes = reinterpret_cast<const char*>(&valor);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T leer(const uchar* p) {
+    T valor;
+    std::memcpy(&valor, p, sizeof(T));
+    return valor;
+}
+
+void anexarRegistro(std::vector<char>& buffer, const InstantaneaAgente& r, uint8_t clase) {
+    anexar<int32_t>(buffer, r.id);
+    anexar<float>(buffer, r.x);
+    anexar<float>(buffer, r.y);
+    anexar<uint8_t>(buffer, static_cast<uint8_t>(r.estado));
+    anexar<uint8_t>(buffer, clase);
+}
+
+} // namespace
+
+// ============================================================================
+// GrabadorTrayectorias
+// ============================================================================
+
+GrabadorTrayectorias::GrabadorTrayectorias(uint32_t intervaloKeyframe)
+    : intervaloKeyframe(std::max<uint32_t>(1, intervaloKeyframe)),
+      ticksDesdeKeyframe(0),
+      primerTick(0),
+      ultimoTick(0),
+      hayTicks(false) {
+}
+
+GrabadorTrayectorias::~GrabadorTrayectorias() {
+    cerrar();
+}
+
+bool GrabadorTrayectorias::abrir(const std::string& ruta, const Escenario& escenario,
+                                 double segundosPorTick) {
+    cerrar();
+
+    archivo.open(ruta, std::ios::binary | std::ios::trunc);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    indiceKeyframes.clear();
+    ultimosRegistros.clear();
+    ticksDesdeKeyframe = 0;
+    hayTicks = false;
+
+    buffer.clear();
+    buffer.insert(buffer.end(), MAGIA_CABECERA, MAGIA_CABECERA + 4);
+    anexar<uint32_t>(buffer, VERSION_FORMATO);
+    anexar<int32_t>(buffer, escenario.filas);
+    anexar<int32_t>(buffer, escenario.columnas);
+    anexar<uint32_t>(buffer, intervaloKeyframe);
+    anexar<double>(buffer, segundosPorTick);
+    for (int i = 0; i < escenario.filas; ++i) {
+        for (int j = 0; j < escenario.columnas; ++j) {
+            buffer.push_back(static_cast<char>(escenario.grid[i][j]));
+        }
+    }
+    archivo.write(buffer.data(), buffer.size());
+    return archivo.good();
+}
+
+void GrabadorTrayectorias::registrarTick(uint32_t tick, const std::vector<InstantaneaAgente>& agentes) {
+    if (!archivo.is_open()) return;
+    if (hayTicks && tick <= ultimoTick) return; // Los ticks deben ser crecientes
+
+    bool esKeyframe = !hayTicks || ticksDesdeKeyframe + 1 >= intervaloKeyframe;
+    registros.clear();
+
+    for (const InstantaneaAgente& actual : agentes) {
+        auto it = ultimosRegistros.find(actual.id);
+
+        if (it == ultimosRegistros.end()) {
+            ultimosRegistros.emplace(actual.id, UltimoRegistro{actual, tick});
+            registros.push_back(actual);
+        } else {
+            if (esKeyframe || it->second.instantanea != actual) {
+                registros.push_back(actual);
+            }
+            it->second.instantanea = actual;
+            it->second.tickVisto = tick;
+        }
+    }
+
+    // Agentes que ya no están en la simulación (evacuados y eliminados)
+    eliminados.clear();
+    for (auto it = ultimosRegistros.begin(); it != ultimosRegistros.end(); ) {
+        if (it->second.tickVisto != tick) {
+            eliminados.push_back(it->second.instantanea);
+            it = ultimosRegistros.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (esKeyframe) {
+        eliminados.clear(); // Un keyframe ya describe el conjunto completo
+        indiceKeyframes.emplace_back(tick, static_cast<uint64_t>(archivo.tellp()));
+        ticksDesdeKeyframe = 0;
+    } else {
+        ticksDesdeKeyframe++;
+    }
+
+    buffer.clear();
+    anexar<uint32_t>(buffer, tick);
+    anexar<uint8_t>(buffer, esKeyframe ? BLOQUE_KEYFRAME : BLOQUE_DELTA);
+    anexar<uint32_t>(buffer, static_cast<uint32_t>(registros.size() + eliminados.size()));
+    for (const auto& r : registros) {
+        anexarRegistro(buffer, r, static_cast<uint8_t>(r.clase));
+    }
+    for (const auto& r : eliminados) {
+        anexarRegistro(buffer, r, CLASE_ELIMINADO);
+    }
+    archivo.write(buffer.data(), buffer.size());
+
+    if (!hayTicks) {
+        primerTick = tick;
+        hayTicks = true;
+    }
+    ultimoTick = tick;
+}
+
+void GrabadorTrayectorias::cerrar() {
+    if (!archivo.is_open()) return;
+
+    uint64_t offsetIndice = static_cast<uint64_t>(archivo.tellp());
+
+    buffer.clear();
+    for (const auto& entrada : indiceKeyframes) {
+        anexar<uint32_t>(buffer, entrada.first);
+        anexar<uint64_t>(buffer, entrada.second);
+    }
+    anexar<uint64_t>(buffer, offsetIndice);
+    anexar<uint32_t>(buffer, static_cast<uint32_t>(indiceKeyframes.size()));
+    anexar<uint32_t>(buffer, primerTick);
+    anexar<uint32_t>(buffer, ultimoTick);
+    buffer.insert(buffer.end(), MAGIA_EPILOGO, MAGIA_EPILOGO + 4);
+
+    archivo.write(buffer.data(), buffer.size());
+    archivo.close();
+
+    indiceKeyframes.clear();
+    ultimosRegistros.clear();
+    hayTicks = false;
+}
+
+// ============================================================================
+// LectorTrayectorias
+// ============================================================================
+
+LectorTrayectorias::LectorTrayectorias()
+    : datos(nullptr), tamano(0), filas(0), columnas(0), segundosPorTick(0.0),
+      offsetGrid(0), offsetBloques(0), offsetIndice(0), numKeyframes(0),
+      primerTick(0), ultimoTick(0), offsetSiguiente(0), tickDecodificado(0),
+      keyframeDecodificado(0), hayEstado(false) {
+}
+
+LectorTrayectorias::~LectorTrayectorias() {
+    cerrar();
+}
+
+bool LectorTrayectorias::abrir(const QString& ruta) {
+    cerrar();
+
+    archivo.setFileName(ruta);
+    if (!archivo.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    tamano = archivo.size();
+    if (tamano < static_cast<qint64>(TAM_CABECERA + TAM_EPILOGO)) {
+        cerrar();
+        return false;
+    }
+
+    datos = archivo.map(0, tamano);
+    if (!datos || std::memcmp(datos, MAGIA_CABECERA, 4) != 0 ||
+        leer<uint32_t>(datos + 4) != VERSION_FORMATO) {
+        cerrar();
+        return false;
+    }
+
+    filas = leer<int32_t>(datos + 8);
+    columnas = leer<int32_t>(datos + 12);
+    segundosPorTick = leer<double>(datos + 20);
+    if (filas <= 0 || columnas <= 0 || filas > Escenario::LADO_MAXIMO || columnas > Escenario::LADO_MAXIMO) {
+        cerrar();
+        return false;
+    }
+    offsetGrid = TAM_CABECERA;
+    offsetBloques = offsetGrid + static_cast<uint64_t>(filas) * columnas;
+
+    // Epílogo al final del archivo: ubica el índice de keyframes
+    const uchar* epilogo = datos + tamano - TAM_EPILOGO;
+    if (std::memcmp(epilogo + 20, MAGIA_EPILOGO, 4) != 0) {
+        cerrar(); // Grabación interrumpida sin cerrar
+        return false;
+    }
+    offsetIndice = leer<uint64_t>(epilogo);
+    numKeyframes = leer<uint32_t>(epilogo + 8);
+    primerTick = leer<uint32_t>(epilogo + 12);
+    ultimoTick = leer<uint32_t>(epilogo + 16);
+
+    // Índice entre los bloques y el epílogo (comparando sin sumas que desborden)
+    const uint64_t finIndice = static_cast<uint64_t>(tamano) - TAM_EPILOGO;
+    if (offsetIndice < offsetBloques || offsetIndice > finIndice ||
+        (finIndice - offsetIndice) / TAM_ENTRADA_INDICE != numKeyframes ||
+        (finIndice - offsetIndice) % TAM_ENTRADA_INDICE != 0) {
+        cerrar();
+        return false;
+    }
+
+    // Cada keyframe debe apuntar a un bloque keyframe dentro de la zona de
+    // bloques, en orden; así la búsqueda binaria y el primer bloque son seguros
+    for (uint32_t i = 0; i < numKeyframes; ++i) {
+        const uint64_t offset = offsetKeyframe(i);
+        if (offset < offsetBloques || offset > offsetIndice ||
+            offsetIndice - offset < TAM_CABECERA_BLOQUE ||
+            leer<uint8_t>(datos + offset + 4) != BLOQUE_KEYFRAME ||
+            leer<uint32_t>(datos + offset) != tickKeyframe(i) ||
+            (i > 0 && (offset <= offsetKeyframe(i - 1) || tickKeyframe(i) <= tickKeyframe(i - 1)))) {
+            cerrar();
+            return false;
+        }
+    }
+    return true;
+}
+
+void LectorTrayectorias::cerrar() {
+    if (datos) {
+        archivo.unmap(const_cast<uchar*>(datos));
+        datos = nullptr;
+    }
+    if (archivo.isOpen()) {
+        archivo.close();
+    }
+    tamano = 0;
+    numKeyframes = 0;
+    estadoActual.clear();
+    hayEstado = false;
+}
+
+std::unique_ptr<Escenario> LectorTrayectorias::crearEscenario() const {
+    auto escenario = std::make_unique<Escenario>(filas, columnas);
+    if (!datos) return escenario;
+
+    const uchar* grid = datos + offsetGrid;
+    for (int i = 0; i < filas; ++i) {
+        for (int j = 0; j < columnas; ++j) {
+            escenario->grid[i][j] = grid[static_cast<size_t>(i) * columnas + j];
+        }
+    }
+    return escenario;
+}
+
+uint32_t LectorTrayectorias::tickKeyframe(uint32_t i) const {
+    return leer<uint32_t>(datos + offsetIndice + i * TAM_ENTRADA_INDICE);
+}
+
+uint64_t LectorTrayectorias::offsetKeyframe(uint32_t i) const {
+    return leer<uint64_t>(datos + offsetIndice + i * TAM_ENTRADA_INDICE + 4);
+}
+
+bool LectorTrayectorias::aplicarBloque(uint64_t offset, uint64_t& siguiente) {
+    // El bloque completo (cabecera y registros) debe caber antes del índice
+    if (offset < offsetBloques || offset > offsetIndice || offsetIndice - offset < TAM_CABECERA_BLOQUE) {
+        return false;
+    }
+    const uchar* p = datos + offset;
+    uint8_t tipo = leer<uint8_t>(p + 4);
+    uint32_t cantidad = leer<uint32_t>(p + 5);
+    if ((offsetIndice - offset - TAM_CABECERA_BLOQUE) / TAM_REGISTRO < cantidad) {
+        return false;
+    }
+    p += TAM_CABECERA_BLOQUE;
+
+    if (tipo == BLOQUE_KEYFRAME) {
+        estadoActual.clear();
+    }
+
+    for (uint32_t i = 0; i < cantidad; ++i, p += TAM_REGISTRO) {
+        InstantaneaAgente r;
+        r.id = leer<int32_t>(p);
+        uint8_t clase = leer<uint8_t>(p + 13);
+        if (clase == CLASE_ELIMINADO) {
+            estadoActual.erase(r.id);
+            continue;
+        }
+        r.x = leer<float>(p + 4);
+        r.y = leer<float>(p + 8);
+        r.estado = static_cast<EstadoAgente>(leer<uint8_t>(p + 12));
+        r.clase = static_cast<ClaseAgente>(clase);
+        estadoActual[r.id] = r;
+    }
+
+    siguiente = offset + TAM_CABECERA_BLOQUE + static_cast<uint64_t>(cantidad) * TAM_REGISTRO;
+    return true;
+}
+
+bool LectorTrayectorias::decodificarFrame(uint32_t tick, FrameAgentes& frame) {
+    if (!datos || numKeyframes == 0 || tick < primerTick || tick > ultimoTick) {
+        return false;
+    }
+
+    // Búsqueda binaria del último keyframe con tick <= tick pedido
+    uint32_t bajo = 0, alto = numKeyframes;
+    while (alto - bajo > 1) {
+        uint32_t medio = (bajo + alto) / 2;
+        if (tickKeyframe(medio) <= tick) bajo = medio;
+        else alto = medio;
+    }
+
+    // Si el estado en caché pertenece al mismo tramo y no lo supera, se sigue
+    // decodificando desde ahí (caso típico al reproducir hacia adelante)
+    bool reutilizar = hayEstado && keyframeDecodificado == bajo && tickDecodificado <= tick;
+    if (!reutilizar) {
+        hayEstado = false;
+        if (!aplicarBloque(offsetKeyframe(bajo), offsetSiguiente)) {
+            estadoActual.clear();
+            return false; // Bloque truncado o corrupto
+        }
+        tickDecodificado = tickKeyframe(bajo);
+        keyframeDecodificado = bajo;
+        hayEstado = true;
+    }
+
+    while (offsetIndice - offsetSiguiente >= TAM_CABECERA_BLOQUE) {
+        uint32_t tickBloque = leer<uint32_t>(datos + offsetSiguiente);
+        uint8_t tipoBloque = leer<uint8_t>(datos + offsetSiguiente + 4);
+        if (tickBloque > tick || tipoBloque == BLOQUE_KEYFRAME) break;
+        if (!aplicarBloque(offsetSiguiente, offsetSiguiente)) {
+            estadoActual.clear();
+            hayEstado = false;
+            return false;
+        }
+        tickDecodificado = tickBloque;
+    }
+
+    frame.tick = tick;
+    frame.tiempo = tick * segundosPorTick;
+    frame.agentes.clear();
+    frame.agentes.reserve(estadoActual.size());
+    for (const auto& par : estadoActual) {
+        frame.agentes.push_back(par.second);
+    }
+    std::sort(frame.agentes.begin(), frame.agentes.end(),
+              [](const InstantaneaAgente& a, const InstantaneaAgente& b) { return a.id < b.id; });
+    return true;
+}
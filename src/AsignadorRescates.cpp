@@ -0,0 +1,136 @@
+#include "../include/AsignadorRescates.h"
+#include "../include/Persona.h"
+#include "../include/Rescatista.h"
+#include <chrono>
+
+namespace {
+// Cada cuántas pujas se mira el reloj
+const size_t PUJAS_POR_CONTROL = 64;
+}
+
+AsignadorRescates::AsignadorRescates() : completa(true), pujas(0) {
+}
+
+void AsignadorRescates::limpiar() {
+    preciosPendientes.clear();
+    asignaciones.clear();
+    completa = true;
+    pujas = 0;
+}
+
+const std::vector<AsignadorRescates::Asignacion>& AsignadorRescates::asignar(
+    const std::vector<std::shared_ptr<Rescatista>>& rescatistas, const IndiceEspacial& indice) {
+    // El presupuesto incluye la consulta de candidatos
+    const auto limite = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(static_cast<long long>(PRESUPUESTO_MS * 1000.0));
+    asignaciones.clear();
+    pujas = 0;
+    construirCandidatos(rescatistas, indice);
+    if (objetos.empty()) {
+        completa = true;
+        return asignaciones;
+    }
+
+    duenos.assign(objetos.size(), -1);
+    completa = subastar(limite);
+
+    for (size_t j = 0; j < objetos.size(); ++j) {
+        if (duenos[j] >= 0) {
+            asignaciones.push_back(Asignacion{postores[duenos[j]], objetos[j]});
+        }
+    }
+
+    // Si se cortó, la próxima llamada parte de estos precios
+    preciosPendientes.clear();
+    if (!completa) {
+        for (size_t j = 0; j < objetos.size(); ++j) {
+            preciosPendientes[objetos[j]->getId()] = precios[j];
+        }
+    }
+    return asignaciones;
+}
+
+void AsignadorRescates::construirCandidatos(const std::vector<std::shared_ptr<Rescatista>>& rescatistas,
+                                            const IndiceEspacial& indice) {
+    postores.clear();
+    inicioCandidatos.assign(1, 0);
+    candidatos.clear();
+    objetos.clear();
+    precios.clear();
+    objetoPorPersona.clear();
+
+    // Sin radio de búsqueda: quien está lejos de todos también recibe pujas
+    const double alcance = indice.getAlcance();
+
+    for (const auto& rescatista : rescatistas) {
+        if (rescatista->getEstaAsistiendo() || rescatista->getEstado() == EstadoAgente::EVACUADO) {
+            continue;
+        }
+        indice.buscarMasCercanas(rescatista->getPosicion(), alcance, CANDIDATOS_POR_RESCATISTA, cercanas);
+
+        const size_t inicio = candidatos.size();
+        for (const auto& cercana : cercanas) {
+            const int id = cercana.second->getId();
+            if (id == rescatista->getPersonaInalcanzable()) {
+                continue;
+            }
+            auto it = objetoPorPersona.find(id);
+            if (it == objetoPorPersona.end()) {
+                it = objetoPorPersona.emplace(id, static_cast<int>(objetos.size())).first;
+                objetos.push_back(cercana.second);
+                auto pendiente = preciosPendientes.find(id);
+                precios.push_back(pendiente != preciosPendientes.end() ? pendiente->second : 0.0);
+            }
+            candidatos.push_back(Candidato{it->second, alcance - cercana.first});
+        }
+        if (candidatos.size() == inicio) {
+            continue;
+        }
+        postores.push_back(rescatista);
+        inicioCandidatos.push_back(candidatos.size());
+    }
+}
+
+bool AsignadorRescates::subastar(std::chrono::steady_clock::time_point limite) {
+    // Postores sin objeto que todavía pueden pujar
+    std::vector<int> pendientes;
+    pendientes.reserve(postores.size());
+    for (size_t i = postores.size(); i > 0; --i) {
+        pendientes.push_back(static_cast<int>(i - 1));
+    }
+
+    while (!pendientes.empty()) {
+        if (++pujas % PUJAS_POR_CONTROL == 0 && std::chrono::steady_clock::now() > limite) {
+            return false;
+        }
+
+        const int postor = pendientes.back();
+        pendientes.pop_back();
+
+        // Mejor y segundo mejor beneficio; quedarse sin asignar vale 0
+        double mejor = 0.0;
+        double segundo = 0.0;
+        int objetoMejor = -1;
+        for (size_t c = inicioCandidatos[postor]; c < inicioCandidatos[postor + 1]; ++c) {
+            const double beneficio = candidatos[c].valor - precios[candidatos[c].objeto];
+            if (beneficio > mejor) {
+                segundo = mejor;
+                mejor = beneficio;
+                objetoMejor = candidatos[c].objeto;
+            } else if (beneficio > segundo) {
+                segundo = beneficio;
+            }
+        }
+        if (objetoMejor < 0) {
+            continue;  // Ninguna persona le conviene a este precio
+        }
+
+        precios[objetoMejor] += mejor - segundo + EPSILON;
+        const int anterior = duenos[objetoMejor];
+        duenos[objetoMejor] = postor;
+        if (anterior >= 0) {
+            pendientes.push_back(anterior);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,18 @@
+#include "../include/BufferFrames.h"
+
+BufferFrames::BufferFrames() : intermedio(1), indiceEscritura(0), indiceLectura(2) {
+}
+
+void BufferFrames::publicar() {
+    uint8_t anterior = intermedio.exchange(indiceEscritura | BIT_NUEVO, std::memory_order_acq_rel);
+    indiceEscritura = anterior & MASCARA_INDICE;
+}
+
+bool BufferFrames::leer() {
+    if (!(intermedio.load(std::memory_order_relaxed) & BIT_NUEVO)) {
+        return false;
+    }
+    uint8_t anterior = intermedio.exchange(indiceLectura, std::memory_order_acq_rel);
+    indiceLectura = anterior & MASCARA_INDICE;
+    return true;
+}
@@ -0,0 +1,96 @@
+#include "../include/BusEventos.h"
+
+namespace {
+std::atomic<uint64_t> siguienteIdentificador(1);
+
+// Último bus usado por este hilo y su búfer: el caso común no toma el mutex.
+// Los identificadores no se reutilizan, así que una caché vieja nunca coincide.
+struct CacheHilo {
+    uint64_t bus = 0;
+    void* buffer = nullptr;
+};
+thread_local CacheHilo cacheHilo;
+}
+
+const char* nombreEvento(TipoEvento tipo) {
+    switch (tipo) {
+        case TipoEvento::INICIO_EVACUACION: return "INICIO_EVACUACION";
+        case TipoEvento::EVACUANDO: return "EVACUANDO";
+        case TipoEvento::PANICO: return "PANICO";
+        case TipoEvento::EVACUADO: return "EVACUADO";
+        case TipoEvento::BLOQUEADO: return "BLOQUEADO";
+        case TipoEvento::EVACUACION_EXITOSA: return "EVACUACION_EXITOSA";
+        case TipoEvento::OBSTACULO_ENCONTRADO: return "OBSTACULO_ENCONTRADO";
+        case TipoEvento::RESCATISTA_OBSTACULO: return "RESCATISTA_OBSTACULO";
+        case TipoEvento::ASISTIENDO_PERSONA: return "ASISTIENDO_PERSONA";
+        case TipoEvento::PERSONA_LIBERADA: return "PERSONA_LIBERADA";
+        default: return "DESCONOCIDO";
+    }
+}
+
+BusEventos::BusEventos()
+    : identificador(siguienteIdentificador.fetch_add(1)), tickActual(0) {
+}
+
+void BusEventos::suscribir(TipoEvento tipo, Suscriptor suscriptor) {
+    suscriptores[static_cast<size_t>(tipo)].push_back(std::move(suscriptor));
+}
+
+void BusEventos::limpiarSuscripciones() {
+    for (auto& lista : suscriptores) {
+        lista.clear();
+    }
+}
+
+BusEventos::BufferHilo& BusEventos::bufferDelHilo() {
+    if (cacheHilo.bus == identificador) {
+        return *static_cast<BufferHilo*>(cacheHilo.buffer);
+    }
+
+    // El hilo alterna entre buses o es la primera vez que publica en este
+    const std::thread::id hilo = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(mutexBuferes);
+    BufferHilo* buffer = nullptr;
+    for (const auto& existente : buferes) {
+        if (existente->hilo == hilo) {
+            buffer = existente.get();
+            break;
+        }
+    }
+    if (!buffer) {
+        buferes.push_back(std::unique_ptr<BufferHilo>(new BufferHilo()));
+        buffer = buferes.back().get();
+        buffer->hilo = hilo;
+        buffer->eventos.reserve(CAPACIDAD_INICIAL);
+    }
+    cacheHilo.bus = identificador;
+    cacheHilo.buffer = buffer;
+    return *buffer;
+}
+
+void BusEventos::publicar(TipoEvento tipo, int32_t agenteId, int32_t fila, int32_t columna, int32_t dato) {
+    bufferDelHilo().eventos.push_back(
+        Evento{tipo, tickActual.load(std::memory_order_relaxed), agenteId, fila, columna, dato});
+}
+
+size_t BusEventos::despachar() {
+    std::lock_guard<std::mutex> lock(mutexBuferes);
+    size_t entregados = 0;
+    for (auto& buffer : buferes) {
+        for (const Evento& evento : buffer->eventos) {
+            for (const auto& suscriptor : suscriptores[static_cast<size_t>(evento.tipo)]) {
+                suscriptor(evento);
+            }
+        }
+        entregados += buffer->eventos.size();
+        buffer->eventos.clear();
+    }
+    return entregados;
+}
+
+void BusEventos::descartar() {
+    std::lock_guard<std::mutex> lock(mutexBuferes);
+    for (auto& buffer : buferes) {
+        buffer->eventos.clear();
+    }
+}
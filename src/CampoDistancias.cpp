@@ -0,0 +1,145 @@
+#include "../include/CampoDistancias.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace {
+const int VECINOS_FILA[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+const int VECINOS_COLUMNA[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+const float RAIZ_DOS = 1.41421356f;
+}
+
+CampoDistancias::CampoDistancias() : filas(0), columnas(0) {
+}
+
+void CampoDistancias::limpiar() {
+    filas = columnas = 0;
+    distancias.clear();
+    direccionesFila.clear();
+    direccionesColumna.clear();
+}
+
+void CampoDistancias::calcular(const Escenario& escenario) {
+    filas = escenario.filas;
+    columnas = escenario.columnas;
+    const size_t total = static_cast<size_t>(filas) * columnas;
+    distancias.assign(total, INALCANZABLE);
+    direccionesFila.assign(total, 0.0f);
+    direccionesColumna.assign(total, 0.0f);
+
+    auto transitable = [&](int f, int c) {
+        return f >= 0 && f < filas && c >= 0 && c < columnas && escenario.grid[f][c] != 1;
+    };
+
+    // Dijkstra multi-origen: todas las salidas empiezan en distancia 0
+    typedef std::pair<float, int> Nodo;
+    std::priority_queue<Nodo, std::vector<Nodo>, std::greater<Nodo>> cola;
+    for (int f = 0; f < filas; ++f) {
+        for (int c = 0; c < columnas; ++c) {
+            if (escenario.grid[f][c] == 2) {
+                distancias[f * columnas + c] = 0.0f;
+                cola.emplace(0.0f, f * columnas + c);
+            }
+        }
+    }
+
+    while (!cola.empty()) {
+        Nodo nodo = cola.top();
+        cola.pop();
+        if (nodo.first > distancias[nodo.second]) continue;
+
+        int f = nodo.second / columnas;
+        int c = nodo.second % columnas;
+        for (int v = 0; v < 8; ++v) {
+            int nf = f + VECINOS_FILA[v];
+            int nc = c + VECINOS_COLUMNA[v];
+            if (!transitable(nf, nc)) continue;
+
+            bool diagonal = v >= 4;
+            // Sin cortar esquinas: ambas celdas ortogonales deben ser transitables
+            if (diagonal && (!transitable(f, nc) || !transitable(nf, c))) continue;
+
+            float nueva = nodo.first + (diagonal ? RAIZ_DOS : 1.0f);
+            int indice = nf * columnas + nc;
+            if (nueva < distancias[indice]) {
+                distancias[indice] = nueva;
+                cola.emplace(nueva, indice);
+            }
+        }
+    }
+
+    // Dirección de cada celda: hacia el vecino alcanzable más cercano a la salida
+    for (int f = 0; f < filas; ++f) {
+        for (int c = 0; c < columnas; ++c) {
+            int indice = f * columnas + c;
+            float actual = distancias[indice];
+            if (actual == INALCANZABLE || actual == 0.0f) continue;
+
+            float mejor = actual;
+            int mejorVecino = -1;
+            for (int v = 0; v < 8; ++v) {
+                int nf = f + VECINOS_FILA[v];
+                int nc = c + VECINOS_COLUMNA[v];
+                if (!transitable(nf, nc)) continue;
+                if (v >= 4 && (!transitable(f, nc) || !transitable(nf, c))) continue;
+
+                float d = distancias[nf * columnas + nc];
+                if (d < mejor) {
+                    mejor = d;
+                    mejorVecino = v;
+                }
+            }
+            if (mejorVecino >= 0) {
+                float norma = mejorVecino >= 4 ? RAIZ_DOS : 1.0f;
+                direccionesFila[indice] = VECINOS_FILA[mejorVecino] / norma;
+                direccionesColumna[indice] = VECINOS_COLUMNA[mejorVecino] / norma;
+            }
+        }
+    }
+}
+
+float CampoDistancias::getDistancia(int fila, int col) const {
+    if (fila < 0 || fila >= filas || col < 0 || col >= columnas) return INALCANZABLE;
+    return distancias[fila * columnas + col];
+}
+
+void CampoDistancias::getDireccion(int fila, int col, float& dirFila, float& dirColumna) const {
+    if (fila < 0 || fila >= filas || col < 0 || col >= columnas) {
+        dirFila = dirColumna = 0.0f;
+        return;
+    }
+    dirFila = direccionesFila[fila * columnas + col];
+    dirColumna = direccionesColumna[fila * columnas + col];
+}
+
+void CampoDistancias::getDireccionInterpolada(float x, float y, float& dirFila, float& dirColumna) const {
+    // Los centros de celda están en coordenadas enteras
+    int f0 = static_cast<int>(std::floor(x));
+    int c0 = static_cast<int>(std::floor(y));
+    float tf = x - f0;
+    float tc = y - c0;
+
+    float sumaFila = 0.0f;
+    float sumaColumna = 0.0f;
+    for (int df = 0; df <= 1; ++df) {
+        for (int dc = 0; dc <= 1; ++dc) {
+            int f = f0 + df;
+            int c = c0 + dc;
+            if (getDistancia(f, c) == INALCANZABLE) continue;
+            float peso = (df ? tf : 1.0f - tf) * (dc ? tc : 1.0f - tc);
+            sumaFila += peso * direccionesFila[f * columnas + c];
+            sumaColumna += peso * direccionesColumna[f * columnas + c];
+        }
+    }
+
+    float norma = std::hypot(sumaFila, sumaColumna);
+    if (norma < 1e-6f) {
+        // Interpolación degenerada (p. ej. direcciones opuestas): usar la celda propia
+        getDireccion(static_cast<int>(std::lround(x)), static_cast<int>(std::lround(y)), dirFila, dirColumna);
+        return;
+    }
+    dirFila = sumaFila / norma;
+    dirColumna = sumaColumna / norma;
+}
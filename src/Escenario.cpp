@@ -1,16 +1,30 @@
 #include "../include/Escenario.h"
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
-Escenario::Escenario(int f, int c) : filas(f), columnas(c) {
+Escenario::Escenario(int f, int c)
+    : filas(std::min(f, LADO_MAXIMO)), columnas(std::min(c, LADO_MAXIMO)), version(0) {
     //inicializa la grid con 0 (Piso)
     grid.resize(filas, std::vector<int>(columnas, 0));
 }
 
 void Escenario::setCelda(int x, int y, int tipo) {
     if (x >= 0 && x < filas && y >= 0 && y < columnas) {
-        grid[x][y] = tipo;
+        if (grid[x][y] != tipo) {
+            grid[x][y] = tipo;
+            version++;
+        }
+    }
+}
+
+void Escenario::reemplazarCeldas(const std::vector<uint8_t>& celdas) {
+    if (celdas.size() != static_cast<size_t>(filas) * columnas) return;
+    for (int i = 0; i < filas; ++i) {
+        const uint8_t* fila = celdas.data() + static_cast<size_t>(i) * columnas;
+        std::copy(fila, fila + columnas, grid[i].begin());
     }
+    version++;
 }
 
 bool Escenario::esTransitable(int x, int y) {
@@ -26,9 +40,9 @@ bool Escenario::esSalida(int x, int y) {
     return grid[x][y] == 2;
 }
 
-QPoint Escenario::getSalidaMasCercana(QPoint origen) {
+Posicion Escenario::getSalidaMasCercana(Posicion origen) {
     //logica simple: buscar la salida con menor distancia euclidiana
-    QPoint mejorSalida(-1, -1);
+    Posicion mejorSalida(-1, -1);
     double menorDistancia = std::numeric_limits<double>::max();
 
     for (int i = 0; i < filas; ++i) {
@@ -37,7 +51,7 @@ QPoint Escenario::getSalidaMasCercana(QPoint origen) {
                 double dist = std::hypot(origen.x() - i, origen.y() - j);
                 if (dist < menorDistancia) {
                     menorDistancia = dist;
-                    mejorSalida = QPoint(i, j);
+                    mejorSalida = Posicion(i, j);
                 }
             }
         }
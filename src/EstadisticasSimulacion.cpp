@@ -1,181 +1,267 @@
 #include "EstadisticasSimulacion.h"
 #include "Persona.h"
 #include "Rescatista.h"
+#include "RegistroAsincrono.h"
+#include "ArchivoColumnar.h"
 #include <sstream>
 #include <fstream>
 #include <cmath>
 #include <algorithm>
+#include <cctype>
 #include <iomanip>
 #include <QDebug>
 
+namespace {
+// Compara el final de la ruta sin distinguir mayúsculas
+bool terminaEn(const std::string& ruta, const std::string& extension) {
+    if (ruta.size() < extension.size()) {
+        return false;
+    }
+    return std::equal(extension.begin(), extension.end(), ruta.end() - extension.size(),
+                      [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) ==
+                                                  std::tolower(static_cast<unsigned char>(b)); });
+}
+}
+
+void AcumuladorTrayectoria::iniciar(Posicion origen, uint32_t tick) {
+    ultima = origen;
+    tickLlegada = tick;
+    distancia = 0.0;
+    pasos = 0;
+    filaMin = filaMax = origen.x();
+    columnaMin = columnaMax = origen.y();
+}
+
+void AcumuladorTrayectoria::agregar(Posicion hasta) {
+    const int df = hasta.x() - ultima.x();
+    const int dc = hasta.y() - ultima.y();
+    distancia += std::sqrt(static_cast<double>(df * df + dc * dc));
+    pasos++;
+    ultima = hasta;
+    filaMin = std::min(filaMin, hasta.x());
+    filaMax = std::max(filaMax, hasta.x());
+    columnaMin = std::min(columnaMin, hasta.y());
+    columnaMax = std::max(columnaMax, hasta.y());
+}
+
 EstadisticasSimulacion::EstadisticasSimulacion() 
-    : tiempoActual(0.0), filas(0), columnas(0), simulacionIniciada(false) {
+    : distanciaTotalEvacuados(0.0), movilidadReducidaActivos(0), tickActual(0), tiempoActual(0.0),
+      filas(0), columnas(0), simulacionIniciada(false) {
     reiniciar();
 }
 
 EstadisticasSimulacion::~EstadisticasSimulacion() {
 }
 
-void EstadisticasSimulacion::iniciar(int totalAgentes, int f, int c) {
+void EstadisticasSimulacion::iniciar(int f, int c) {
     reiniciar();
-    estadisticas.totalAgentes = totalAgentes;
-    estadisticas.totalEnProceso = totalAgentes; // Inicialmente todos en proceso
     filas = f;
     columnas = c;
+    const size_t celdas = static_cast<size_t>(std::max(0, filas * columnas));
+    colisionesPorCelda.assign(celdas, 0);
+    ocupacionPorCelda.assign(celdas, 0);
+    flujoPorCelda.assign(celdas, 0);
+    evacuadosPorCelda.assign(celdas, 0);
+    tiempoEvacuacionPorCelda.assign(celdas, 0.0);
+    serieDensidad.configurar(filas, columnas, INTERVALO_DENSIDAD);
+    conteoDensidad.assign(celdas, 0);
     simulacionIniciada = true;
     tiempoActual = 0.0;
     
-    qDebug() << "📊 Estadísticas inicializadas:" << totalAgentes << "agentes";
+    qDebug() << "📊 Estadísticas inicializadas:" << filas << "x" << columnas;
 }
 
 void EstadisticasSimulacion::reiniciar() {
     estadisticas = EstadisticasGlobales();
     eventosEvacuacion.clear();
-    trayectoriasAgentes.clear();
-    contadorCuellosBottela.clear();
+    acumuladores.clear();
+    std::fill(colisionesPorCelda.begin(), colisionesPorCelda.end(), 0);
+    std::fill(ocupacionPorCelda.begin(), ocupacionPorCelda.end(), 0);
+    std::fill(flujoPorCelda.begin(), flujoPorCelda.end(), 0);
+    std::fill(evacuadosPorCelda.begin(), evacuadosPorCelda.end(), 0);
+    std::fill(tiempoEvacuacionPorCelda.begin(), tiempoEvacuacionPorCelda.end(), 0.0);
+    serieDensidad.limpiar();
+    tiemposEvacuacion.limpiar();
+    for (auto& histograma : tiemposPorTipo) {
+        histograma.limpiar();
+    }
+    tiemposPorSalida.clear();
+    resumen = ResumenEstadisticas();
+    distanciaTotalEvacuados = 0.0;
+    movilidadReducidaActivos = 0;
+    tickActual = 0;
     tiempoActual = 0.0;
     simulacionIniciada = false;
 }
 
-void EstadisticasSimulacion::registrarEvacuacion(std::shared_ptr<AgenteBase> agente, 
-                                                  QPoint salida, double tiempo, int pasos) {
+void EstadisticasSimulacion::registrarAgente(const std::shared_ptr<AgenteBase>& agente) {
+    estadisticas.totalAgentes++;
+    estadisticas.totalEnProceso++;
+    Persona* persona = comoAgente<Persona>(agente.get());
+    if (persona != nullptr && persona->tieneMovilidadReducida()) {
+        movilidadReducidaActivos++;
+    }
+    acumuladores[agente->getId()].iniciar(agente->getPosicion(), tickActual);
+}
+
+const EventoEvacuacion& EstadisticasSimulacion::registrarEvacuacion(std::shared_ptr<AgenteBase> agente,
+                                                                   Posicion salida, double tiempo) {
     EventoEvacuacion evento;
     evento.agenteId = agente->getId();
+    evento.tipoAgente = agente->getTipoAgente();
     evento.salida = salida;
     evento.tiempoEvacuacion = tiempo;
-    evento.pasosRealizados = pasos;
+    evento.pasosRealizados = 0;
+    evento.distanciaRecorrida = 0.0;
+    evento.zonaRecorrida = ZonaCeldas();
     
-    // Determinar el tipo de agente usando dynamic_cast
-    Persona* persona = dynamic_cast<Persona*>(agente.get());
-    Rescatista* rescatista = dynamic_cast<Rescatista*>(agente.get());
+    // Contadores por clase de agente
+    Persona* persona = comoAgente<Persona>(agente.get());
+    Rescatista* rescatista = comoAgente<Rescatista>(agente.get());
+    
+    if (persona != nullptr && persona->tieneMovilidadReducida()) {
+        movilidadReducidaActivos--;
+    }
     
     if (rescatista != nullptr) {
-        evento.tipoAgente = "Rescatista";
         estadisticas.rescatistasEvacuados++;
-        qDebug() << "📊 Rescatista" << agente->getId() << "evacuado";
+        registrar<NivelRegistro::TRAZA>(CodigoRegistro::RESCATISTA_EVACUADO, agente->getId());
     } else if (persona != nullptr) {
-        evento.tipoAgente = "Persona";
         estadisticas.personasEvacuadas++;
-        qDebug() << "📊 Persona" << agente->getId() << "evacuada";
-    } else {
-        evento.tipoAgente = "Desconocido";
+        registrar<NivelRegistro::TRAZA>(CodigoRegistro::PERSONA_EVACUADA, agente->getId());
     }
     
-    eventosEvacuacion.push_back(evento);
     estadisticas.totalEvacuados++;
     
     // Actualizar estadísticas por salida
-    std::string salidaKey = puntoToString(salida);
-    estadisticas.personasPorSalida[salidaKey]++;
-    
-    // Calcular distancia recorrida aproximada
-    if (trayectoriasAgentes.find(evento.agenteId) != trayectoriasAgentes.end()) {
-        double distancia = 0.0;
-        const auto& trayectoria = trayectoriasAgentes[evento.agenteId];
-        for (size_t i = 1; i < trayectoria.size(); i++) {
-            distancia += calcularDistancia(trayectoria[i-1], trayectoria[i]);
+    const int celdaSalida = indiceCelda(salida);
+    if (celdaSalida >= 0) {
+        evacuadosPorCelda[celdaSalida]++;
+        tiempoEvacuacionPorCelda[celdaSalida] += tiempo;
+        tiemposPorSalida[celdaSalida].registrar(tiempo);
+    }
+    tiemposEvacuacion.registrar(tiempo);
+    tiemposPorTipo[static_cast<size_t>(agente->getTipoAgente())].registrar(tiempo);
+    
+    // La trayectoria ya está resumida; el agente deja de seguirse
+    auto it = acumuladores.find(evento.agenteId);
+    if (it != acumuladores.end()) {
+        const AcumuladorTrayectoria& acumulador = it->second;
+        evento.pasosRealizados = acumulador.pasos;
+        evento.distanciaRecorrida = acumulador.distancia;
+        evento.zonaRecorrida = ZonaCeldas{acumulador.filaMin, acumulador.columnaMin,
+                                          acumulador.filaMax, acumulador.columnaMax};
+        distanciaTotalEvacuados += acumulador.distancia;
+        const int celda = indiceCelda(acumulador.ultima);
+        if (celda >= 0) {
+            ocupacionPorCelda[celda] += tickActual - acumulador.tickLlegada;
         }
-        estadisticas.distanciaPromedioRecorrida += distancia;
+        acumuladores.erase(it);
     }
+    eventosEvacuacion.push_back(evento);
     
-    qDebug() << "📊 Total evacuados:" << estadisticas.totalEvacuados << "/" << estadisticas.totalAgentes;
+    registrar<NivelRegistro::DEPURACION>(CodigoRegistro::TOTAL_EVACUADOS, estadisticas.totalEvacuados,
+                                         estadisticas.totalAgentes);
+    return eventosEvacuacion.back();
 }
 
-void EstadisticasSimulacion::registrarColision(QPoint posicion) {
+void EstadisticasSimulacion::registrarColision(Posicion posicion) {
     estadisticas.colisionesTotales++;
     registrarCuelloBotella(posicion);
 }
 
-void EstadisticasSimulacion::registrarCuelloBotella(QPoint posicion) {
-    std::string key = puntoToString(posicion);
-    contadorCuellosBottela[key]++;
-    
-    // Si una posición tiene muchas colisiones, es un cuello de botella
-    if (contadorCuellosBottela[key] > 5) {
-        // Verificar si ya está en la lista
-        auto it = std::find(estadisticas.cuellosBotellaDetectados.begin(), 
-                           estadisticas.cuellosBotellaDetectados.end(), posicion);
-        if (it == estadisticas.cuellosBotellaDetectados.end()) {
-            estadisticas.cuellosBotellaDetectados.push_back(posicion);
-        }
+void EstadisticasSimulacion::registrarCuelloBotella(Posicion posicion) {
+    // Los cuellos de botella se derivan del mapa en resumirMapas()
+    const int celda = indiceCelda(posicion);
+    if (celda >= 0) {
+        colisionesPorCelda[celda]++;
     }
 }
 
-void EstadisticasSimulacion::registrarMovimiento(std::shared_ptr<AgenteBase> agente, 
-                                                  QPoint /*desde*/, QPoint hasta) {
-    int id = agente->getId();
-    trayectoriasAgentes[id].push_back(hasta);
-}
+void EstadisticasSimulacion::registrarMovimiento(const std::shared_ptr<AgenteBase>& agente,
+                                                  Posicion desde, Posicion hasta) {
+    const int id = agente->getId();
+    auto resultado = acumuladores.try_emplace(id);
+    AcumuladorTrayectoria& acumulador = resultado.first->second;
+    if (resultado.second) {
+        acumulador.iniciar(desde, tickActual);
+    }
+
+    // La estadía en la celda anterior termina ahora
+    const int celdaDesde = indiceCelda(acumulador.ultima);
+    if (celdaDesde >= 0) {
+        ocupacionPorCelda[celdaDesde] += tickActual - acumulador.tickLlegada;
+    }
+    acumulador.tickLlegada = tickActual;
+    acumulador.agregar(hasta);
+
+    const int celda = indiceCelda(hasta);
+    if (celda >= 0) {
+        flujoPorCelda[celda]++;
+    }
 
-void EstadisticasSimulacion::registrarCambioPanico(int /*agenteId*/, bool entroPanico) {
-    if (entroPanico) {
-        estadisticas.personasConPanico++;
-        estadisticas.eventosRegistrados["panico"]++;
+    if (sumideroTrayectorias) {
+        sumideroTrayectorias(id, desde, hasta);
     }
 }
 
-void EstadisticasSimulacion::actualizarTiempoSimulacion(double tiempo) {
+void EstadisticasSimulacion::actualizarTiempoSimulacion(uint32_t tick, double tiempo) {
+    tickActual = tick;
     tiempoActual = tiempo;
     estadisticas.tiempoTotalSimulacion = tiempo;
 }
 
-void EstadisticasSimulacion::actualizarEstadoAgentes(const std::vector<std::shared_ptr<AgenteBase>>& agentes) {
-    estadisticas.totalEnProceso = 0;
-    estadisticas.personasConPanico = 0;
-    estadisticas.personasMovilidadReducida = 0;
-    
+void EstadisticasSimulacion::actualizarResumen(const ConteoEstados& conteo, int activos) {
+    estadisticas.totalEnProceso = activos;
+    estadisticas.personasConPanico = conteo.get(EstadoAgente::PANICO);
+    estadisticas.personasMovilidadReducida = movilidadReducidaActivos;
+
+    resumen.tick = tickActual;
+    resumen.tiempo = tiempoActual;
+    resumen.totalAgentes = activos + estadisticas.totalEvacuados;
+    resumen.evacuados = estadisticas.totalEvacuados;
+    resumen.personasEvacuadas = estadisticas.personasEvacuadas;
+    resumen.rescatistasEvacuados = estadisticas.rescatistasEvacuados;
+    resumen.enProceso = activos;
+    resumen.enRuta = conteo.get(EstadoAgente::EVACUANDO);
+    resumen.bloqueados = conteo.get(EstadoAgente::BLOQUEADO);
+    resumen.conPanico = estadisticas.personasConPanico;
+    resumen.movilidadReducida = movilidadReducidaActivos;
+    resumen.colisiones = estadisticas.colisionesTotales;
+    resumen.tasaEvacuacion = tiempoActual > 0 ? estadisticas.totalEvacuados / tiempoActual : 0.0;
+    resumen.tiempoPromedioEvacuacion = tiemposEvacuacion.getPromedio();
+}
+
+void EstadisticasSimulacion::muestrearDensidad(uint32_t tick,
+                                               const std::vector<std::shared_ptr<AgenteBase>>& agentes) {
+    if (conteoDensidad.empty() || !serieDensidad.tocaMuestra(tick)) {
+        return;
+    }
+    std::fill(conteoDensidad.begin(), conteoDensidad.end(), 0);
     for (const auto& agente : agentes) {
-        // Contar agentes en proceso (no evacuados)
-        if (agente->getEstado() != EstadoAgente::EVACUADO) {
-            estadisticas.totalEnProceso++;
-        }
-        
-        // Verificar atributos específicos de Persona
-        Persona* persona = dynamic_cast<Persona*>(agente.get());
-        if (persona != nullptr) {
-            if (persona->estEnPanico()) {
-                estadisticas.personasConPanico++;
-            }
-            if (persona->tieneMovilidadReducida()) {
-                estadisticas.personasMovilidadReducida++;
-            }
+        const int celda = indiceCelda(agente->getPosicion());
+        if (celda >= 0 && conteoDensidad[celda] < 255) {
+            conteoDensidad[celda]++;
         }
     }
+    serieDensidad.agregarMuestra(tick, conteoDensidad);
 }
 
 void EstadisticasSimulacion::calcularEstadisticas() {
-    if (eventosEvacuacion.empty()) {
+    cerrarEstadias();
+    resumirMapas();
+
+    if (tiemposEvacuacion.getCantidad() == 0) {
         return;
     }
     
-    // Calcular tiempos de evacuación
-    double sumaTimpos = 0.0;
-    estadisticas.tiempoMinimoEvacuacion = eventosEvacuacion[0].tiempoEvacuacion;
-    estadisticas.tiempoMaximoEvacuacion = eventosEvacuacion[0].tiempoEvacuacion;
-    
-    for (const auto& evento : eventosEvacuacion) {
-        sumaTimpos += evento.tiempoEvacuacion;
-        estadisticas.tiempoMinimoEvacuacion = std::min(estadisticas.tiempoMinimoEvacuacion, 
-                                                       evento.tiempoEvacuacion);
-        estadisticas.tiempoMaximoEvacuacion = std::max(estadisticas.tiempoMaximoEvacuacion, 
-                                                       evento.tiempoEvacuacion);
-    }
-    
-    estadisticas.tiempoPromedioEvacuacion = sumaTimpos / eventosEvacuacion.size();
-    
-    // Calcular tiempo promedio por salida
-    std::map<std::string, double> sumaTiemposSalida;
-    std::map<std::string, int> conteoSalida;
-    
-    for (const auto& evento : eventosEvacuacion) {
-        std::string key = puntoToString(evento.salida);
-        sumaTiemposSalida[key] += evento.tiempoEvacuacion;
-        conteoSalida[key]++;
-    }
-    
-    for (const auto& par : sumaTiemposSalida) {
-        estadisticas.tiempoPromedioSalida[par.first] = par.second / conteoSalida[par.first];
-    }
+    // Tiempos de evacuación: salen del histograma, sin recorrer los eventos
+    estadisticas.tiempoMinimoEvacuacion = tiemposEvacuacion.getMinimo();
+    estadisticas.tiempoMaximoEvacuacion = tiemposEvacuacion.getMaximo();
+    estadisticas.tiempoPromedioEvacuacion = tiemposEvacuacion.getPromedio();
+    estadisticas.tiempoP50Evacuacion = tiemposEvacuacion.percentil(50.0);
+    estadisticas.tiempoP95Evacuacion = tiemposEvacuacion.percentil(95.0);
+    estadisticas.tiempoP99Evacuacion = tiemposEvacuacion.percentil(99.0);
     
     // Calcular tasa de evacuación
     if (estadisticas.tiempoTotalSimulacion > 0) {
@@ -183,9 +269,9 @@ void EstadisticasSimulacion::calcularEstadisticas() {
                                       estadisticas.tiempoTotalSimulacion;
     }
     
-    // Calcular distancia promedio
+    // Calcular distancia promedio (se puede llamar varias veces durante la corrida)
     if (estadisticas.totalEvacuados > 0) {
-        estadisticas.distanciaPromedioRecorrida /= estadisticas.totalEvacuados;
+        estadisticas.distanciaPromedioRecorrida = distanciaTotalEvacuados / estadisticas.totalEvacuados;
     }
     
     // Calcular densidad promedio
@@ -196,7 +282,7 @@ void EstadisticasSimulacion::calcularEstadisticas() {
     }
 }
 
-EstadisticasGlobales EstadisticasSimulacion::getEstadisticas() const {
+const EstadisticasGlobales& EstadisticasSimulacion::getEstadisticas() const {
     return estadisticas;
 }
 
@@ -236,6 +322,17 @@ std::string EstadisticasSimulacion::generarReporte() const {
         ss << "Tiempo promedio evacuación:  " << formatearTiempo(estadisticas.tiempoPromedioEvacuacion) << "\n";
         ss << "Tiempo mínimo evacuación:    " << formatearTiempo(estadisticas.tiempoMinimoEvacuacion) << "\n";
         ss << "Tiempo máximo evacuación:    " << formatearTiempo(estadisticas.tiempoMaximoEvacuacion) << "\n";
+        ss << "Percentiles P50/P95/P99:     " << formatearTiempo(estadisticas.tiempoP50Evacuacion) << " / "
+           << formatearTiempo(estadisticas.tiempoP95Evacuacion) << " / "
+           << formatearTiempo(estadisticas.tiempoP99Evacuacion) << "\n";
+        const char* nombresTipo[] = {"  - Personas:                ", "  - Rescatistas:             "};
+        for (size_t t = 0; t < 2; t++) {
+            const HistogramaHDR& histograma = tiemposPorTipo[t];
+            if (histograma.getCantidad() == 0) continue;
+            ss << nombresTipo[t] << formatearTiempo(histograma.percentil(50.0)) << " / "
+               << formatearTiempo(histograma.percentil(95.0)) << " / "
+               << formatearTiempo(histograma.percentil(99.0)) << "\n";
+        }
         ss << "Tasa de evacuación:          " << std::fixed << std::setprecision(2) 
            << estadisticas.tasaEvacuacion << " personas/segundo\n\n";
     } else {
@@ -252,7 +349,12 @@ std::string EstadisticasSimulacion::generarReporte() const {
             if (estadisticas.tiempoPromedioSalida.find(par.first) != 
                 estadisticas.tiempoPromedioSalida.end()) {
                 ss << " (tiempo promedio: " 
-                   << formatearTiempo(estadisticas.tiempoPromedioSalida.at(par.first)) << ")";
+                   << formatearTiempo(estadisticas.tiempoPromedioSalida.at(par.first));
+                auto p95 = estadisticas.tiempoP95Salida.find(par.first);
+                if (p95 != estadisticas.tiempoP95Salida.end()) {
+                    ss << ", P95: " << formatearTiempo(p95->second);
+                }
+                ss << ")";
             }
             ss << "\n";
         }
@@ -322,6 +424,9 @@ std::string EstadisticasSimulacion::generarReporteCSV() const {
     ss << "Tiempo Promedio Evacuación (s)," << estadisticas.tiempoPromedioEvacuacion << "\n";
     ss << "Tiempo Mínimo (s)," << estadisticas.tiempoMinimoEvacuacion << "\n";
     ss << "Tiempo Máximo (s)," << estadisticas.tiempoMaximoEvacuacion << "\n";
+    ss << "Tiempo P50 (s)," << estadisticas.tiempoP50Evacuacion << "\n";
+    ss << "Tiempo P95 (s)," << estadisticas.tiempoP95Evacuacion << "\n";
+    ss << "Tiempo P99 (s)," << estadisticas.tiempoP99Evacuacion << "\n";
     ss << "Tasa Evacuación (p/s)," << estadisticas.tasaEvacuacion << "\n";
     ss << "Personas con Pánico," << estadisticas.personasConPanico << "\n";
     ss << "Movilidad Reducida," << estadisticas.personasMovilidadReducida << "\n";
@@ -330,13 +435,17 @@ std::string EstadisticasSimulacion::generarReporteCSV() const {
     ss << "Densidad Promedio," << estadisticas.densidadPromedio << "\n";
     ss << "Cuellos de Botella," << estadisticas.cuellosBotellaDetectados.size() << "\n";
     
-    ss << "\nSalida,Personas,Tiempo Promedio (s)\n";
+    ss << "\nSalida,Personas,Tiempo Promedio (s),Tiempo P95 (s)\n";
     for (const auto& par : estadisticas.personasPorSalida) {
         ss << par.first << "," << par.second << ",";
         if (estadisticas.tiempoPromedioSalida.find(par.first) != 
             estadisticas.tiempoPromedioSalida.end()) {
             ss << estadisticas.tiempoPromedioSalida.at(par.first);
         }
+        ss << ",";
+        if (estadisticas.tiempoP95Salida.find(par.first) != estadisticas.tiempoP95Salida.end()) {
+            ss << estadisticas.tiempoP95Salida.at(par.first);
+        }
         ss << "\n";
     }
     
@@ -359,6 +468,9 @@ std::string EstadisticasSimulacion::generarReporteJSON() const {
     ss << "    \"promedioEvacuacion\": " << estadisticas.tiempoPromedioEvacuacion << ",\n";
     ss << "    \"minimo\": " << estadisticas.tiempoMinimoEvacuacion << ",\n";
     ss << "    \"maximo\": " << estadisticas.tiempoMaximoEvacuacion << ",\n";
+    ss << "    \"p50\": " << estadisticas.tiempoP50Evacuacion << ",\n";
+    ss << "    \"p95\": " << estadisticas.tiempoP95Evacuacion << ",\n";
+    ss << "    \"p99\": " << estadisticas.tiempoP99Evacuacion << ",\n";
     ss << "    \"tasaEvacuacion\": " << estadisticas.tasaEvacuacion << "\n";
     ss << "  },\n";
     ss << "  \"comportamiento\": {\n";
@@ -398,15 +510,19 @@ std::string EstadisticasSimulacion::generarReporteJSON() const {
 }
 
 bool EstadisticasSimulacion::exportarReporte(const std::string& rutaArchivo) const {
+    if (terminaEn(rutaArchivo, ".cols")) {
+        return exportarEventos(rutaArchivo);
+    }
+
     std::ofstream archivo(rutaArchivo);
     if (!archivo.is_open()) {
         return false;
     }
     
-    // Determinar el formato por la extensión
-    if (rutaArchivo.find(".csv") != std::string::npos) {
+    // Determinar el formato por la extensión (no por ".csv" en cualquier parte de la ruta)
+    if (terminaEn(rutaArchivo, ".csv")) {
         archivo << generarReporteCSV();
-    } else if (rutaArchivo.find(".json") != std::string::npos) {
+    } else if (terminaEn(rutaArchivo, ".json")) {
         archivo << generarReporteJSON();
     } else {
         archivo << generarReporte();
@@ -416,24 +532,75 @@ bool EstadisticasSimulacion::exportarReporte(const std::string& rutaArchivo) con
     return true;
 }
 
-int EstadisticasSimulacion::getPersonasEvacuadasPorSalida(QPoint salida) const {
-    std::string key = puntoToString(salida);
-    auto it = estadisticas.personasPorSalida.find(key);
-    return (it != estadisticas.personasPorSalida.end()) ? it->second : 0;
+bool EstadisticasSimulacion::exportarEventos(const std::string& rutaArchivo) const {
+    enum Columna { AGENTE, TIPO, SALIDA_FILA, SALIDA_COLUMNA, TIEMPO, PASOS, DISTANCIA };
+    const std::vector<DefinicionColumna> esquema = {
+        {"agente", TipoColumna::ENTERO32, CompresionColumna::DELTA},
+        {"tipo", TipoColumna::BYTE, CompresionColumna::RLE},
+        {"salida_fila", TipoColumna::ENTERO32, CompresionColumna::RLE},
+        {"salida_columna", TipoColumna::ENTERO32, CompresionColumna::RLE},
+        {"tiempo", TipoColumna::REAL64, CompresionColumna::PLANA},
+        {"pasos", TipoColumna::ENTERO32, CompresionColumna::DELTA},
+        {"distancia", TipoColumna::REAL64, CompresionColumna::PLANA},
+    };
+
+    EscritorColumnas escritor;
+    if (!escritor.abrir(rutaArchivo, esquema)) {
+        return false;
+    }
+    for (const auto& evento : eventosEvacuacion) {
+        escritor.agregarEntero(AGENTE, evento.agenteId);
+        escritor.agregarByte(TIPO, static_cast<uint8_t>(evento.tipoAgente));
+        escritor.agregarEntero(SALIDA_FILA, evento.salida.x());
+        escritor.agregarEntero(SALIDA_COLUMNA, evento.salida.y());
+        escritor.agregarReal(TIEMPO, evento.tiempoEvacuacion);
+        escritor.agregarEntero(PASOS, evento.pasosRealizados);
+        escritor.agregarReal(DISTANCIA, evento.distanciaRecorrida);
+        escritor.terminarFila();
+    }
+    return escritor.cerrar();
+}
+
+int EstadisticasSimulacion::getPersonasEvacuadasPorSalida(Posicion salida) const {
+    const int celda = indiceCelda(salida);
+    return celda >= 0 ? static_cast<int>(evacuadosPorCelda[celda]) : 0;
 }
 
-double EstadisticasSimulacion::getTiempoPromedioSalida(QPoint salida) const {
-    std::string key = puntoToString(salida);
-    auto it = estadisticas.tiempoPromedioSalida.find(key);
-    return (it != estadisticas.tiempoPromedioSalida.end()) ? it->second : 0.0;
+double EstadisticasSimulacion::getTiempoPromedioSalida(Posicion salida) const {
+    const int celda = indiceCelda(salida);
+    if (celda < 0 || evacuadosPorCelda[celda] == 0) {
+        return 0.0;
+    }
+    return tiempoEvacuacionPorCelda[celda] / evacuadosPorCelda[celda];
 }
 
 std::vector<EventoEvacuacion> EstadisticasSimulacion::getEventosEvacuacion() const {
     return eventosEvacuacion;
 }
 
-std::vector<QPoint> EstadisticasSimulacion::getCuellosBotellaDetectados() const {
-    return estadisticas.cuellosBotellaDetectados;
+std::vector<Posicion> EstadisticasSimulacion::getCuellosBotellaDetectados() const {
+    // Al momento, sin esperar a calcularEstadisticas()
+    std::vector<Posicion> cuellos;
+    for (size_t celda = 0; celda < colisionesPorCelda.size(); celda++) {
+        if (colisionesPorCelda[celda] > UMBRAL_CUELLO_BOTELLA) {
+            cuellos.push_back(Posicion(static_cast<int>(celda) / columnas, static_cast<int>(celda) % columnas));
+        }
+    }
+    return cuellos;
+}
+
+const HistogramaHDR& EstadisticasSimulacion::getHistogramaTiempos(TipoAgente tipo) const {
+    return tiemposPorTipo[static_cast<size_t>(tipo)];
+}
+
+const HistogramaHDR* EstadisticasSimulacion::getHistogramaSalida(Posicion salida) const {
+    auto it = tiemposPorSalida.find(indiceCelda(salida));
+    return it != tiemposPorSalida.end() ? &it->second : nullptr;
+}
+
+const AcumuladorTrayectoria* EstadisticasSimulacion::getAcumulador(int agenteId) const {
+    auto it = acumuladores.find(agenteId);
+    return it != acumuladores.end() ? &it->second : nullptr;
 }
 
 std::map<std::string, double> EstadisticasSimulacion::getMetricasResumen() const {
@@ -449,37 +616,81 @@ std::map<std::string, double> EstadisticasSimulacion::getMetricasResumen() const
 }
 
 std::string EstadisticasSimulacion::getResumenRapido() const {
+    return formatearResumen(resumen);
+}
+
+std::string EstadisticasSimulacion::formatearResumen(const ResumenEstadisticas& resumen) {
     std::stringstream ss;
-    ss << "Evacuados: " << estadisticas.totalEvacuados << "/" << estadisticas.totalAgentes;
-    ss << " | Tiempo: " << formatearTiempo(estadisticas.tiempoTotalSimulacion);
+    ss << "Evacuados: " << resumen.evacuados << "/" << resumen.totalAgentes;
+    ss << " | Tiempo: " << formatearTiempo(resumen.tiempo);
     
-    if (estadisticas.totalEvacuados > 0) {
-        ss << " | Tasa: " << std::fixed << std::setprecision(1) << estadisticas.tasaEvacuacion << " p/s";
+    if (resumen.evacuados > 0) {
+        ss << " | Tasa: " << std::fixed << std::setprecision(1) << resumen.tasaEvacuacion << " p/s";
     } else {
         ss << " | Sin evacuaciones";
     }
     
-    ss << " | Colisiones: " << estadisticas.colisionesTotales;
+    ss << " | Colisiones: " << resumen.colisiones;
     
-    if (estadisticas.totalEnProceso > 0) {
-        ss << " | En proceso: " << estadisticas.totalEnProceso;
+    if (resumen.enProceso > 0) {
+        ss << " | En proceso: " << resumen.enProceso;
     }
     
     return ss.str();
 }
 
 // Métodos auxiliares privados
-std::string EstadisticasSimulacion::puntoToString(QPoint punto) const {
+std::string EstadisticasSimulacion::puntoToString(Posicion punto) const {
     return std::to_string(punto.x()) + "," + std::to_string(punto.y());
 }
 
-double EstadisticasSimulacion::calcularDistancia(QPoint p1, QPoint p2) const {
-    int dx = p2.x() - p1.x();
-    int dy = p2.y() - p1.y();
-    return std::sqrt(dx*dx + dy*dy);
+int EstadisticasSimulacion::indiceCelda(Posicion punto) const {
+    if (punto.x() < 0 || punto.x() >= filas || punto.y() < 0 || punto.y() >= columnas ||
+        colisionesPorCelda.empty()) {
+        return -1;
+    }
+    return punto.x() * columnas + punto.y();
+}
+
+void EstadisticasSimulacion::cerrarEstadias() {
+    // Suma la estadía en curso de los agentes activos (se puede llamar varias veces)
+    for (auto& par : acumuladores) {
+        AcumuladorTrayectoria& acumulador = par.second;
+        const int celda = indiceCelda(acumulador.ultima);
+        if (celda >= 0) {
+            ocupacionPorCelda[celda] += tickActual - acumulador.tickLlegada;
+        }
+        acumulador.tickLlegada = tickActual;
+    }
+}
+
+void EstadisticasSimulacion::resumirMapas() {
+    // Una sola pasada: cuellos de botella por umbral y métricas por salida
+    estadisticas.cuellosBotellaDetectados.clear();
+    estadisticas.personasPorSalida.clear();
+    estadisticas.tiempoPromedioSalida.clear();
+    estadisticas.tiempoP95Salida.clear();
+    if (colisionesPorCelda.empty()) {
+        return;
+    }
+
+    for (int f = 0; f < filas; f++) {
+        for (int c = 0; c < columnas; c++) {
+            const size_t celda = static_cast<size_t>(f) * columnas + c;
+            if (colisionesPorCelda[celda] > UMBRAL_CUELLO_BOTELLA) {
+                estadisticas.cuellosBotellaDetectados.push_back(Posicion(f, c));
+            }
+            if (evacuadosPorCelda[celda] > 0) {
+                const std::string key = puntoToString(Posicion(f, c));
+                estadisticas.personasPorSalida[key] = static_cast<int>(evacuadosPorCelda[celda]);
+                estadisticas.tiempoPromedioSalida[key] = tiempoEvacuacionPorCelda[celda] / evacuadosPorCelda[celda];
+                estadisticas.tiempoP95Salida[key] = tiemposPorSalida[static_cast<int>(celda)].percentil(95.0);
+            }
+        }
+    }
 }
 
-std::string EstadisticasSimulacion::formatearTiempo(double segundos) const {
+std::string EstadisticasSimulacion::formatearTiempo(double segundos) {
     int mins = static_cast<int>(segundos) / 60;
     double secs = segundos - (mins * 60);
     
@@ -0,0 +1,136 @@
+#include "../include/ExportadorSerie.h"
+#include "../include/TrazaEventos.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+// El escritor despierta solo cada tanto: no se le avisa en cada fila
+const auto INTERVALO_ESCRITOR = std::chrono::milliseconds(20);
+
+// Longitud máxima de una fila sin contar las salidas
+const size_t MAXIMO_FILA = 256;
+const size_t MAXIMO_POR_SALIDA = 12;
+}
+
+ExportadorSerie::ExportadorSerie()
+    : archivo(nullptr), escritura(0), lectura(0), detener(false), usados(0) {
+}
+
+ExportadorSerie::~ExportadorSerie() {
+    cerrar();
+}
+
+bool ExportadorSerie::abrir(const std::string& ruta, const std::vector<Posicion>& salidasEscenario) {
+    cerrar();
+    archivo = std::fopen(ruta.c_str(), "wb");
+    if (!archivo) {
+        return false;
+    }
+
+    salidas = salidasEscenario;
+    evacuadosAnteriores.clear();  // Se toman de la primera fila
+    filas.resize(CAPACIDAD);
+    flujos.assign(CAPACIDAD * salidas.size(), 0);
+    escritura.store(0, std::memory_order_relaxed);
+    lectura.store(0, std::memory_order_relaxed);
+    buffer.resize(TAMANO_BUFFER);
+    usados = 0;
+    detener = false;
+
+    std::string encabezado = "tick,tiempo,evacuados,activos,en_ruta,bloqueados,panico,colisiones";
+    for (const Posicion& salida : salidas) {
+        encabezado += ",salida_" + std::to_string(salida.x()) + "_" + std::to_string(salida.y());
+    }
+    encabezado += "\n";
+    std::fwrite(encabezado.data(), 1, encabezado.size(), archivo);
+
+    escritor = std::thread(&ExportadorSerie::bucleEscritor, this);
+    return true;
+}
+
+void ExportadorSerie::registrarTick(const ResumenEstadisticas& resumen, const std::vector<int>& evacuadosPorSalida) {
+    if (!archivo) {
+        return;
+    }
+    const size_t posicion = escritura.load(std::memory_order_relaxed);
+    while (posicion - lectura.load(std::memory_order_acquire) >= CAPACIDAD) {
+        std::this_thread::yield();  // Cola llena: el escritor va atrasado
+    }
+
+    if (evacuadosAnteriores.empty()) {
+        evacuadosAnteriores = evacuadosPorSalida;
+        evacuadosAnteriores.resize(salidas.size(), 0);
+    }
+
+    const size_t slot = posicion & (CAPACIDAD - 1);
+    filas[slot].resumen = resumen;
+    int32_t* flujosFila = flujos.data() + slot * salidas.size();
+    for (size_t i = 0; i < salidas.size(); ++i) {
+        const int acumulado = i < evacuadosPorSalida.size() ? evacuadosPorSalida[i] : evacuadosAnteriores[i];
+        flujosFila[i] = acumulado - evacuadosAnteriores[i];
+        evacuadosAnteriores[i] = acumulado;
+    }
+    escritura.store(posicion + 1, std::memory_order_release);
+}
+
+void ExportadorSerie::cerrar() {
+    if (!archivo) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        detener = true;
+    }
+    hayFilas.notify_all();
+    escritor.join();
+
+    volcar();
+    std::fclose(archivo);
+    archivo = nullptr;
+}
+
+void ExportadorSerie::bucleEscritor() {
+    TrazaEventos::nombrarHilo("escritor de la serie");
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        const bool terminar = detener;
+        lock.unlock();
+
+        size_t posicion = lectura.load(std::memory_order_relaxed);
+        const size_t fin = escritura.load(std::memory_order_acquire);
+        for (; posicion < fin; ++posicion) {
+            const size_t slot = posicion & (CAPACIDAD - 1);
+            formatear(filas[slot], flujos.data() + slot * salidas.size());
+            lectura.store(posicion + 1, std::memory_order_release);
+        }
+
+        lock.lock();
+        if (terminar) {
+            break;
+        }
+        hayFilas.wait_for(lock, INTERVALO_ESCRITOR);
+    }
+}
+
+void ExportadorSerie::formatear(const Fila& fila, const int32_t* flujosFila) {
+    if (usados + MAXIMO_FILA + salidas.size() * MAXIMO_POR_SALIDA > buffer.size()) {
+        volcar();
+    }
+    const ResumenEstadisticas& r = fila.resumen;
+    char* p = buffer.data() + usados;
+    p += std::sprintf(p, "%u,%.3f,%d,%d,%d,%d,%d,%d", r.tick, r.tiempo, r.evacuados, r.enProceso,
+                      r.enRuta, r.bloqueados, r.conPanico, r.colisiones);
+    for (size_t i = 0; i < salidas.size(); ++i) {
+        p += std::sprintf(p, ",%d", flujosFila[i]);
+    }
+    *p++ = '\n';
+    usados = static_cast<size_t>(p - buffer.data());
+}
+
+void ExportadorSerie::volcar() {
+    if (usados > 0) {
+        TRAZAR("escribir serie", "io");
+        std::fwrite(buffer.data(), 1, usados, archivo);
+        usados = 0;
+    }
+}
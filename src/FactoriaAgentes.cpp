@@ -49,11 +49,21 @@ std::vector<std::shared_ptr<Persona>> FactoriaAgentes::crearGrupoPersonas(
     int edadPromedio, 
     double radioDispersion) {
     
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    return crearGrupoPersonas(cantidad, posInicial, edadPromedio, radioDispersion, gen);
+}
+
+std::vector<std::shared_ptr<Persona>> FactoriaAgentes::crearGrupoPersonas(
+    int cantidad,
+    Posicion posInicial,
+    int edadPromedio,
+    double radioDispersion,
+    std::mt19937& gen) {
+    
     std::vector<std::shared_ptr<Persona>> grupo;
     grupo.reserve(cantidad);
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_real_distribution<> disAngulo(0, 2 * 3.14159265359);
     std::uniform_real_distribution<> disRadio(0, radioDispersion);
     std::uniform_int_distribution<> disEdad(edadPromedio - 10, edadPromedio + 10);
@@ -63,7 +73,7 @@ std::vector<std::shared_ptr<Persona>> FactoriaAgentes::crearGrupoPersonas(
         double angulo = disAngulo(gen);
         double radio = disRadio(gen);
         
-        // CORRECCIÓN MATEMÁTICA: QPoint usa enteros.
+        // CORRECCIÓN MATEMÁTICA: Posicion usa enteros.
         // Convertimos el cálculo trigonométrico a entero para la grid.
         int nuevoX = static_cast<int>(posInicial.x() + radio * std::cos(angulo));
         int nuevoY = static_cast<int>(posInicial.y() + radio * std::sin(angulo));
@@ -0,0 +1,20 @@
+#include "../include/FrameAgentes.h"
+#include "../include/Persona.h"
+
+InstantaneaAgente capturarInstantanea(const AgenteBase& agente) {
+    InstantaneaAgente inst;
+    inst.id = agente.getId();
+    inst.x = static_cast<float>(agente.getPosicion().x());
+    inst.y = static_cast<float>(agente.getPosicion().y());
+    inst.estado = agente.getEstado();
+
+    if (agente.getTipoAgente() == TipoAgente::RESCATISTA) {
+        inst.clase = ClaseAgente::RESCATISTA;
+    } else if (auto persona = comoAgente<Persona>(&agente)) {
+        inst.clase = persona->tieneMovilidadReducida() ? ClaseAgente::PERSONA_MOVILIDAD_REDUCIDA
+                                                       : ClaseAgente::PERSONA;
+    } else {
+        inst.clase = ClaseAgente::PERSONA;
+    }
+    return inst;
+}
@@ -0,0 +1,533 @@
+#include "../include/GeneradorEscenarios.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// Partición del edificio: [fila0, fila1) x [columna0, columna1); la primera
+// fila y la primera columna son su pared, el interior es el resto
+struct Particion {
+    int fila0, columna0, fila1, columna1;
+};
+
+// Pared que separa dos particiones hermanas; las puertas se abren al final
+struct Division {
+    bool horizontal;  // La pared es una fila (si no, una columna)
+    int linea;
+    int desde, hasta;
+    int pasillo;      // 0 si no hay pasillo; si no, su ancho (piso tras la pared)
+};
+
+} // namespace
+
+GeneradorEscenarios::GeneradorEscenarios(uint32_t semilla)
+    : rng(semilla), filas(0), columnas(0) {}
+
+const char* GeneradorEscenarios::nombreTipo(TipoPlano tipo) {
+    switch (tipo) {
+        case TipoPlano::EDIFICIO: return "edificio";
+        case TipoPlano::SALON: return "salon";
+        case TipoPlano::ESTADIO: return "estadio";
+        case TipoPlano::LABERINTO: return "laberinto";
+    }
+    return "";
+}
+
+bool GeneradorEscenarios::tipoDesdeNombre(const std::string& nombre, TipoPlano& tipo) {
+    const TipoPlano tipos[] = {TipoPlano::EDIFICIO, TipoPlano::SALON, TipoPlano::ESTADIO, TipoPlano::LABERINTO};
+    for (TipoPlano candidato : tipos) {
+        if (nombre == nombreTipo(candidato)) {
+            tipo = candidato;
+            return true;
+        }
+    }
+    return false;
+}
+
+void GeneradorEscenarios::generar(Escenario& escenario, const ParametrosPlano& parametros) {
+    filas = escenario.filas;
+    columnas = escenario.columnas;
+    celdas.assign(static_cast<size_t>(filas) * columnas, 1);
+
+    if (filas < 5 || columnas < 5) {
+        // Demasiado chico para un plano: sala vacía
+        rellenar(1, 1, filas - 1, columnas - 1, 0);
+    } else {
+        switch (parametros.tipo) {
+            case TipoPlano::EDIFICIO: generarEdificio(parametros); break;
+            case TipoPlano::SALON: generarSalon(parametros); break;
+            case TipoPlano::ESTADIO: generarEstadio(parametros); break;
+            case TipoPlano::LABERINTO: generarLaberinto(parametros); break;
+        }
+    }
+    abrirSalidas(parametros.salidas, parametros.anchoSalida);
+    // Edificio, salón y laberinto quedan conectados por construcción; el
+    // relleno cuesta tanto como generarlos, así que solo se paga en el estadio
+    if (parametros.tipo == TipoPlano::ESTADIO && filas >= 5 && columnas >= 5) cerrarInalcanzables();
+
+    escenario.reemplazarCeldas(celdas);
+    std::vector<uint8_t>().swap(celdas);
+}
+
+void GeneradorEscenarios::rellenar(int fila0, int columna0, int fila1, int columna1, uint8_t tipo) {
+    fila0 = std::max(fila0, 0);
+    columna0 = std::max(columna0, 0);
+    fila1 = std::min(fila1, filas);
+    columna1 = std::min(columna1, columnas);
+    if (fila0 >= fila1 || columna0 >= columna1) return;
+    for (int f = fila0; f < fila1; ++f) {
+        std::memset(&celda(f, columna0), tipo, static_cast<size_t>(columna1 - columna0));
+    }
+}
+
+// ============================================================================
+// Edificio: partición binaria del espacio
+// ============================================================================
+
+void GeneradorEscenarios::generarEdificio(const ParametrosPlano& parametros) {
+    const int minimo = std::max(3, parametros.ladoMinimoSala);
+    const int pasillo = std::max(1, parametros.anchoPasillo);
+    std::bernoulli_distribution moneda(0.5);
+
+    std::vector<Particion> pendientes{{0, 0, filas - 1, columnas - 1}};
+    std::vector<Division> divisiones;
+
+    while (!pendientes.empty()) {
+        const Particion p = pendientes.back();
+        pendientes.pop_back();
+        const int alto = p.fila1 - p.fila0;
+        const int ancho = p.columna1 - p.columna0;
+
+        const bool partirFilas = alto >= 2 * minimo;
+        const bool partirColumnas = ancho >= 2 * minimo;
+        if (!partirFilas && !partirColumnas) {
+            rellenar(p.fila0 + 1, p.columna0 + 1, p.fila1, p.columna1, 0);  // Sala
+            continue;
+        }
+
+        // Se corta el lado largo; si es casi cuadrada, cualquiera
+        bool horizontal;
+        if (partirFilas && partirColumnas) {
+            horizontal = alto * 4 > ancho * 5 || (ancho * 4 <= alto * 5 && moneda(rng));
+        } else {
+            horizontal = partirFilas;
+        }
+        const int largo = horizontal ? alto : ancho;
+
+        // Las particiones grandes se separan con un pasillo en vez de una pared
+        int anchoPasillo = 0;
+        if (std::min(alto, ancho) >= parametros.ladoMinimoPasillo && largo >= 2 * minimo + pasillo + 1) {
+            anchoPasillo = pasillo;
+        }
+        const int extra = anchoPasillo > 0 ? anchoPasillo + 1 : 0;
+        std::uniform_int_distribution<int> corte(minimo, largo - minimo - extra);
+        const int linea = (horizontal ? p.fila0 : p.columna0) + corte(rng);
+
+        Particion a = p;
+        Particion b = p;
+        if (horizontal) {
+            a.fila1 = linea;
+            b.fila0 = linea + extra;
+            if (anchoPasillo > 0) {
+                rellenar(linea + 1, p.columna0 + 1, linea + 1 + anchoPasillo, p.columna1, 0);
+            }
+            divisiones.push_back(Division{true, linea, p.columna0 + 1, p.columna1, anchoPasillo});
+        } else {
+            a.columna1 = linea;
+            b.columna0 = linea + extra;
+            if (anchoPasillo > 0) {
+                rellenar(p.fila0 + 1, linea + 1, p.fila1, linea + 1 + anchoPasillo, 0);
+            }
+            divisiones.push_back(Division{false, linea, p.fila0 + 1, p.fila1, anchoPasillo});
+        }
+        pendientes.push_back(a);
+        pendientes.push_back(b);
+    }
+
+    // Con todas las salas talladas: una puerta entre hermanas, o una puerta
+    // al pasillo por cada sala (o pasillo menor) que da a él
+    const int anchoPuerta = std::min(pasillo, 2);
+    for (const Division& d : divisiones) {
+        if (d.pasillo == 0) {
+            abrirPuerta(d.horizontal, d.linea, d.desde, d.hasta, anchoPuerta);
+        } else {
+            abrirPuertas(d.horizontal, d.linea, d.desde, d.hasta, -1, anchoPuerta);
+            abrirPuertas(d.horizontal, d.linea + d.pasillo + 1, d.desde, d.hasta, +1, anchoPuerta);
+        }
+    }
+}
+
+void GeneradorEscenarios::abrirPuertas(bool horizontal, int linea, int desde, int hasta, int lado, int ancho) {
+    if (linea - 1 < 0 || linea + 1 >= (horizontal ? filas : columnas)) return;
+
+    auto pared = [&](int k) -> uint8_t& { return horizontal ? celda(linea, k) : celda(k, linea); };
+    auto vecina = [&](int k, int desplazamiento) -> uint8_t {
+        return horizontal ? celda(linea + desplazamiento, k) : celda(k, linea + desplazamiento);
+    };
+
+    int k = desde;
+    while (k < hasta) {
+        if (vecina(k, lado) != 0 || vecina(k, -lado) != 0) {
+            ++k;
+            continue;
+        }
+        int fin = k;
+        while (fin < hasta && vecina(fin, lado) == 0 && vecina(fin, -lado) == 0) ++fin;
+        const int anchoTramo = std::min(ancho, fin - k);
+        const int inicio = k + (fin - k - anchoTramo) / 2;
+        for (int j = inicio; j < inicio + anchoTramo; ++j) {
+            pared(j) = 0;
+        }
+        k = fin;
+    }
+}
+
+void GeneradorEscenarios::abrirPuerta(bool horizontal, int linea, int desde, int hasta, int ancho) {
+    if (desde >= hasta || linea - 1 < 0 || linea + 1 >= (horizontal ? filas : columnas)) return;
+
+    auto pared = [&](int k) -> uint8_t& { return horizontal ? celda(linea, k) : celda(k, linea); };
+    auto libre = [&](int k) {
+        return horizontal ? celda(linea - 1, k) == 0 && celda(linea + 1, k) == 0
+                          : celda(k, linea - 1) == 0 && celda(k, linea + 1) == 0;
+    };
+
+    // Desde un punto al azar, la primera posición con piso a ambos lados
+    const int largo = hasta - desde;
+    const int inicio = std::uniform_int_distribution<int>(0, largo - 1)(rng);
+    for (int i = 0; i < largo; ++i) {
+        const int k = desde + (inicio + i) % largo;
+        if (libre(k)) {
+            for (int j = k; j < hasta && j < k + ancho && libre(j); ++j) {
+                pared(j) = 0;
+            }
+            return;
+        }
+    }
+}
+
+// ============================================================================
+// Salón con pilares
+// ============================================================================
+
+void GeneradorEscenarios::generarSalon(const ParametrosPlano& parametros) {
+    rellenar(1, 1, filas - 1, columnas - 1, 0);
+
+    const int lado = std::max(1, parametros.ladoPilar);
+    const int paso = std::max(lado + 2, parametros.separacionPilares);
+    std::uniform_int_distribution<int> desvio(-1, 1);
+    for (int f = paso; f + lado + 2 < filas; f += paso) {
+        for (int c = paso; c + lado + 2 < columnas; c += paso) {
+            const int fila = f + desvio(rng);
+            const int columna = c + desvio(rng);
+            rellenar(fila, columna, fila + lado, columna + lado, 1);
+        }
+    }
+}
+
+// ============================================================================
+// Estadio: cancha elíptica, anillos de gradas y pasillos radiales
+// ============================================================================
+
+void GeneradorEscenarios::generarEstadio(const ParametrosPlano& parametros) {
+    const double centroFila = (filas - 1) / 2.0;
+    const double centroColumna = (columnas - 1) / 2.0;
+    const double semiejeFilas = (filas - 2) / 2.0;
+    const double semiejeColumnas = (columnas - 2) / 2.0;
+    const double escala = std::min(semiejeFilas, semiejeColumnas);  // Celdas por unidad de radio
+
+    const double radioCancha = 0.35;
+    const int gradas = std::max(1, parametros.gradas);
+    const double anchoAnillo = (1.0 - radioCancha) / gradas;
+    // Fracción del anillo ocupada por la baranda: una celda de grosor
+    const double grosor = std::min(0.5, 1.0 / (anchoAnillo * escala));
+    const double sector = 2.0 * PI / std::max(1, parametros.pasillosGrada);
+    const double medioPasillo = std::max(1, parametros.anchoPasillo) / 2.0;
+
+    for (int f = 1; f < filas - 1; ++f) {
+        const double u = (f - centroFila) / semiejeFilas;
+        const double u2 = u * u;
+        if (u2 >= 1.0) continue;
+        uint8_t* fila = &celda(f, 0);
+        for (int c = 1; c < columnas - 1; ++c) {
+            const double v = (c - centroColumna) / semiejeColumnas;
+            const double r2 = u2 + v * v;
+            if (r2 >= 1.0) continue;  // Fuera del estadio
+            const double r = std::sqrt(r2);
+            uint8_t tipo = 0;
+            if (r >= radioCancha) {
+                const double t = (r - radioCancha) / anchoAnillo;
+                if (t - std::floor(t) < grosor) {
+                    // Baranda, salvo donde la cruza un pasillo
+                    const double angulo = std::atan2(v, u) + PI;
+                    const double enSector = std::fmod(angulo, sector);
+                    const double distancia = std::min(enSector, sector - enSector) * r * escala;
+                    tipo = distancia < medioPasillo ? 0 : 1;
+                }
+            }
+            fila[c] = tipo;
+        }
+    }
+}
+
+// ============================================================================
+// Laberinto: backtracking iterativo sobre nodos de anchoPasillo celdas
+// ============================================================================
+
+void GeneradorEscenarios::generarLaberinto(const ParametrosPlano& parametros) {
+    const int ancho = std::max(1, parametros.anchoPasillo);
+    const int paso = ancho + 1;
+    const int nodosFila = (filas - 1) / paso;
+    const int nodosColumna = (columnas - 1) / paso;
+    if (nodosFila < 1 || nodosColumna < 1) {
+        rellenar(1, 1, filas - 1, columnas - 1, 0);
+        return;
+    }
+
+    const size_t totalNodos = static_cast<size_t>(nodosFila) * nodosColumna;
+    auto tallarNodo = [&](int i, int j) {
+        rellenar(1 + i * paso, 1 + j * paso, 1 + i * paso + ancho, 1 + j * paso + ancho, 0);
+    };
+    // Pared entre el nodo (i, j) y el de abajo o el de la derecha
+    auto abrirAbajo = [&](int i, int j) {
+        rellenar(1 + i * paso + ancho, 1 + j * paso, 2 + i * paso + ancho, 1 + j * paso + ancho, 0);
+    };
+    auto abrirDerecha = [&](int i, int j) {
+        rellenar(1 + i * paso, 1 + j * paso + ancho, 1 + i * paso + ancho, 2 + j * paso + ancho, 0);
+    };
+
+    std::vector<uint8_t> visitado(totalNodos, 0);
+    std::vector<uint32_t> pila;
+    const uint32_t inicio = std::uniform_int_distribution<uint32_t>(0, static_cast<uint32_t>(totalNodos - 1))(rng);
+    visitado[inicio] = 1;
+    tallarNodo(static_cast<int>(inicio / nodosColumna), static_cast<int>(inicio % nodosColumna));
+    pila.push_back(inicio);
+
+    while (!pila.empty()) {
+        const uint32_t nodo = pila.back();
+        const int i = static_cast<int>(nodo / nodosColumna);
+        const int j = static_cast<int>(nodo % nodosColumna);
+
+        uint32_t vecinos[4];
+        int direcciones[4];
+        int cantidad = 0;
+        if (i > 0 && !visitado[nodo - nodosColumna]) { vecinos[cantidad] = nodo - nodosColumna; direcciones[cantidad++] = 0; }
+        if (i + 1 < nodosFila && !visitado[nodo + nodosColumna]) { vecinos[cantidad] = nodo + nodosColumna; direcciones[cantidad++] = 1; }
+        if (j > 0 && !visitado[nodo - 1]) { vecinos[cantidad] = nodo - 1; direcciones[cantidad++] = 2; }
+        if (j + 1 < nodosColumna && !visitado[nodo + 1]) { vecinos[cantidad] = nodo + 1; direcciones[cantidad++] = 3; }
+        if (cantidad == 0) {
+            pila.pop_back();
+            continue;
+        }
+
+        const int elegido = std::uniform_int_distribution<int>(0, cantidad - 1)(rng);
+        switch (direcciones[elegido]) {
+            case 0: abrirAbajo(i - 1, j); break;
+            case 1: abrirAbajo(i, j); break;
+            case 2: abrirDerecha(i, j - 1); break;
+            case 3: abrirDerecha(i, j); break;
+        }
+        const uint32_t siguiente = vecinos[elegido];
+        visitado[siguiente] = 1;
+        tallarNodo(static_cast<int>(siguiente / nodosColumna), static_cast<int>(siguiente % nodosColumna));
+        pila.push_back(siguiente);
+    }
+
+    // Un laberinto perfecto tiene un solo camino entre dos puntos; los
+    // ciclos dan rutas alternativas cuando un pasillo se congestiona
+    const size_t extras = static_cast<size_t>(std::max(0.0, parametros.ciclos) * static_cast<double>(totalNodos));
+    std::uniform_int_distribution<int> filaAlAzar(0, nodosFila - 1);
+    std::uniform_int_distribution<int> columnaAlAzar(0, nodosColumna - 1);
+    std::bernoulli_distribution haciaAbajo(0.5);
+    for (size_t k = 0; k < extras; ++k) {
+        const int i = filaAlAzar(rng);
+        const int j = columnaAlAzar(rng);
+        if (haciaAbajo(rng)) {
+            if (i + 1 < nodosFila) abrirAbajo(i, j);
+        } else {
+            if (j + 1 < nodosColumna) abrirDerecha(i, j);
+        }
+    }
+}
+
+// ============================================================================
+// Salidas
+// ============================================================================
+
+void GeneradorEscenarios::abrirSalidas(int cantidad, int ancho) {
+    if (cantidad <= 0 || filas < 3 || columnas < 3) return;
+    ancho = std::max(1, ancho);
+
+    // Perímetro sin las esquinas, en sentido horario desde arriba a la izquierda
+    const int ladoHorizontal = columnas - 2;
+    const int ladoVertical = filas - 2;
+    const double perimetro = 2.0 * (ladoHorizontal + ladoVertical);
+    const double tramo = perimetro / cantidad;
+    std::uniform_real_distribution<double> desvio(-tramo / 4.0, tramo / 4.0);
+
+    for (int k = 0; k < cantidad; ++k) {
+        double posicion = std::fmod((k + 0.5) * tramo + desvio(rng) + perimetro, perimetro);
+
+        // Lado, origen, dirección a lo largo del borde y dirección hacia adentro
+        int largo, fila0, columna0, pasoFila, pasoColumna, adentroFila, adentroColumna;
+        if (posicion < ladoHorizontal) {
+            largo = ladoHorizontal; fila0 = 0; columna0 = 1;
+            pasoFila = 0; pasoColumna = 1; adentroFila = 1; adentroColumna = 0;
+        } else if ((posicion -= ladoHorizontal) < ladoVertical) {
+            largo = ladoVertical; fila0 = 1; columna0 = columnas - 1;
+            pasoFila = 1; pasoColumna = 0; adentroFila = 0; adentroColumna = -1;
+        } else if ((posicion -= ladoVertical) < ladoHorizontal) {
+            largo = ladoHorizontal; fila0 = filas - 1; columna0 = columnas - 2;
+            pasoFila = 0; pasoColumna = -1; adentroFila = -1; adentroColumna = 0;
+        } else {
+            posicion -= ladoHorizontal;
+            largo = ladoVertical; fila0 = filas - 2; columna0 = 0;
+            pasoFila = -1; pasoColumna = 0; adentroFila = 0; adentroColumna = 1;
+        }
+
+        const int anchoSalida = std::min(ancho, largo);
+        const int desplazamiento = std::clamp(static_cast<int>(posicion) - anchoSalida / 2, 0, largo - anchoSalida);
+        for (int w = 0; w < anchoSalida; ++w) {
+            int f = fila0 + pasoFila * (desplazamiento + w);
+            int c = columna0 + pasoColumna * (desplazamiento + w);
+            celda(f, c) = 2;
+
+            // Túnel hacia adentro hasta el primer piso
+            f += adentroFila;
+            c += adentroColumna;
+            while (f > 0 && f < filas - 1 && c > 0 && c < columnas - 1 && celda(f, c) == 1) {
+                celda(f, c) = 0;
+                f += adentroFila;
+                c += adentroColumna;
+            }
+        }
+    }
+}
+
+// El estadio puede dejar bolsones de piso encerrados entre una baranda y el
+// borde de la elipse (en mapas chicos, donde el pasillo no llega a cruzar la
+// baranda): quien quede ahí no puede evacuar, así que se vuelven pared. Basta con 4 vecinos porque
+// el campo de distancias no deja cortar esquinas en diagonal.
+void GeneradorEscenarios::cerrarInalcanzables() {
+    // Relleno por tramos de fila desde el piso junto a cada salida (todas
+    // están en el borde). El piso alcanzado se marca con 3 en la misma
+    // rejilla y al final vuelve a ser 0
+    std::vector<std::pair<int, int>> pendientes;
+    bool haySalidas = false;
+    auto sembrar = [&](int f, int c) {
+        if (celda(f, c) != 2) return;
+        haySalidas = true;
+        if (f > 0) pendientes.emplace_back(f - 1, c);
+        if (f + 1 < filas) pendientes.emplace_back(f + 1, c);
+        if (c > 0) pendientes.emplace_back(f, c - 1);
+        if (c + 1 < columnas) pendientes.emplace_back(f, c + 1);
+    };
+    for (int c = 0; c < columnas; ++c) {
+        sembrar(0, c);
+        sembrar(filas - 1, c);
+    }
+    for (int f = 1; f < filas - 1; ++f) {
+        sembrar(f, 0);
+        sembrar(f, columnas - 1);
+    }
+    if (!haySalidas) return;  // Sin salidas no hay a dónde llegar: el plano queda como está
+
+    // Deja pendiente el comienzo de cada corrida de piso sin marcar de la fila en [desde, hasta]
+    auto buscarTramos = [&](int f, int desde, int hasta) {
+        const uint8_t* fila = &celda(f, 0);
+        int c = desde;
+        while (c <= hasta) {
+            if (fila[c] != 0) {
+                ++c;
+                continue;
+            }
+            pendientes.emplace_back(f, c);
+            while (c <= hasta && fila[c] == 0) ++c;
+        }
+    };
+
+    while (!pendientes.empty()) {
+        const int f = pendientes.back().first;
+        const int c = pendientes.back().second;
+        pendientes.pop_back();
+        uint8_t* fila = &celda(f, 0);
+        if (fila[c] != 0) continue;
+
+        int izquierda = c;
+        int derecha = c;
+        while (izquierda > 0 && fila[izquierda - 1] == 0) --izquierda;
+        while (derecha + 1 < columnas && fila[derecha + 1] == 0) ++derecha;
+        std::memset(fila + izquierda, 3, static_cast<size_t>(derecha - izquierda + 1));
+
+        if (f > 0) buscarTramos(f - 1, izquierda, derecha);
+        if (f + 1 < filas) buscarTramos(f + 1, izquierda, derecha);
+    }
+
+    // 0 (no alcanzado) -> pared, 3 (alcanzado) -> piso; paredes y salidas quedan igual
+    static const uint8_t nuevoTipo[4] = {1, 1, 2, 0};
+    for (uint8_t& tipo : celdas) tipo = nuevoTipo[tipo];
+}
+
+// ============================================================================
+// Población
+// ============================================================================
+
+std::vector<std::shared_ptr<Persona>> GeneradorEscenarios::poblar(const Escenario& escenario,
+                                                                  FactoriaAgentes& factoria,
+                                                                  int cantidad,
+                                                                  int tamanoGrupo) {
+    const int filasMapa = escenario.filas;
+    const int columnasMapa = escenario.columnas;
+
+    std::vector<uint32_t> libres;
+    for (int f = 0; f < filasMapa; ++f) {
+        const std::vector<int>& fila = escenario.grid[f];
+        for (int c = 0; c < columnasMapa; ++c) {
+            if (fila[c] == 0) {
+                libres.push_back(static_cast<uint32_t>(f) * columnasMapa + c);
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<Persona>> personas;
+    cantidad = std::min(cantidad, static_cast<int>(libres.size()));
+    if (cantidad <= 0) return personas;
+    personas.reserve(cantidad);
+
+    // Las celdas ocupadas no salen de "libres" hasta que se sortean, así que
+    // siempre quedan ahí al menos cantidad - colocadas celdas sin ocupar
+    std::vector<uint8_t> ocupada(static_cast<size_t>(filasMapa) * columnasMapa, 0);
+    size_t disponibles = libres.size();
+    auto sortearLibre = [&]() {
+        while (true) {
+            const size_t k = std::uniform_int_distribution<size_t>(0, disponibles - 1)(rng);
+            const uint32_t indice = libres[k];
+            std::swap(libres[k], libres[--disponibles]);
+            if (!ocupada[indice]) return indice;
+        }
+    };
+
+    tamanoGrupo = std::max(1, tamanoGrupo);
+    while (static_cast<int>(personas.size()) < cantidad) {
+        const int enGrupo = std::min(tamanoGrupo, cantidad - static_cast<int>(personas.size()));
+        const uint32_t centro = libres[std::uniform_int_distribution<size_t>(0, disponibles - 1)(rng)];
+        const Posicion posCentro(static_cast<int>(centro / columnasMapa), static_cast<int>(centro % columnasMapa));
+        const double radio = 0.8 * std::sqrt(static_cast<double>(enGrupo)) + 1.0;
+
+        for (auto& persona : factoria.crearGrupoPersonas(enGrupo, posCentro, 35, radio, rng)) {
+            const Posicion pos = persona->getPosicion();
+            const bool dentro = pos.x() >= 0 && pos.x() < filasMapa && pos.y() >= 0 && pos.y() < columnasMapa;
+            uint32_t indice = dentro ? static_cast<uint32_t>(pos.x()) * columnasMapa + pos.y() : 0;
+            if (!dentro || escenario.grid[pos.x()][pos.y()] != 0 || ocupada[indice]) {
+                indice = sortearLibre();
+                persona->setPosicion(Posicion(static_cast<int>(indice / columnasMapa),
+                                              static_cast<int>(indice % columnasMapa)));
+            }
+            ocupada[indice] = 1;
+            personas.push_back(persona);
+        }
+    }
+    return personas;
+}
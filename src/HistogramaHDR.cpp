@@ -0,0 +1,95 @@
+#include "../include/HistogramaHDR.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const uint64_t MITAD = HistogramaHDR::SUBCUBETAS / 2;
+const uint64_t MAXIMO_MS = (uint64_t(1) << HistogramaHDR::BITS_MAXIMO) - 1;
+const size_t NUM_CUBETAS = (HistogramaHDR::BITS_MAXIMO - HistogramaHDR::BITS_SUBCUBETA + 2) * MITAD;
+
+int bitMasAlto(uint64_t v) {
+    int bit = 0;
+    while (v >>= 1) ++bit;
+    return bit;
+}
+}
+
+HistogramaHDR::HistogramaHDR() : cubetas(NUM_CUBETAS, 0) {
+    limpiar();
+}
+
+void HistogramaHDR::limpiar() {
+    std::fill(cubetas.begin(), cubetas.end(), 0);
+    cantidad = 0;
+    suma = 0.0;
+    minimo = 0.0;
+    maximo = 0.0;
+}
+
+size_t HistogramaHDR::indiceCubeta(uint64_t ms) {
+    if (ms < SUBCUBETAS) {
+        return static_cast<size_t>(ms);  // Rango lineal: una cubeta por milisegundo
+    }
+    // Cubetas de ancho 2^e dentro de [2^(BITS_SUBCUBETA + e - 1), 2^(BITS_SUBCUBETA + e))
+    const int e = bitMasAlto(ms) - BITS_SUBCUBETA + 1;
+    return static_cast<size_t>(e * MITAD + (ms >> e));
+}
+
+double HistogramaHDR::valorCubeta(size_t indice) {
+    if (indice < SUBCUBETAS) {
+        return indice / 1000.0;
+    }
+    // Centro de la cubeta
+    const int e = static_cast<int>(indice / MITAD) - 1;
+    const uint64_t inferior = (indice - e * MITAD) << e;
+    return (inferior + ((uint64_t(1) << e) - 1) / 2.0) / 1000.0;
+}
+
+void HistogramaHDR::registrar(double segundos) {
+    const double ms = std::max(0.0, std::round(segundos * 1000.0));
+    const uint64_t valor = static_cast<uint64_t>(std::min(ms, static_cast<double>(MAXIMO_MS)));
+    cubetas[indiceCubeta(valor)]++;
+
+    if (cantidad == 0) {
+        minimo = maximo = segundos;
+    } else {
+        minimo = std::min(minimo, segundos);
+        maximo = std::max(maximo, segundos);
+    }
+    cantidad++;
+    suma += segundos;
+}
+
+void HistogramaHDR::combinar(const HistogramaHDR& otro) {
+    if (otro.cantidad == 0) {
+        return;
+    }
+    for (size_t i = 0; i < cubetas.size(); ++i) {
+        cubetas[i] += otro.cubetas[i];
+    }
+    minimo = cantidad > 0 ? std::min(minimo, otro.minimo) : otro.minimo;
+    maximo = cantidad > 0 ? std::max(maximo, otro.maximo) : otro.maximo;
+    cantidad += otro.cantidad;
+    suma += otro.suma;
+}
+
+double HistogramaHDR::percentil(double p) const {
+    if (cantidad == 0) {
+        return 0.0;
+    }
+    // Rango del valor buscado (1..cantidad)
+    const double fraccion = std::min(100.0, std::max(0.0, p)) / 100.0;
+    const uint64_t objetivo = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraccion * cantidad)));
+    if (objetivo == 1) return minimo;
+    if (objetivo >= cantidad) return maximo;
+
+    uint64_t acumulado = 0;
+    for (size_t i = 0; i < cubetas.size(); ++i) {
+        acumulado += cubetas[i];
+        if (acumulado >= objetivo) {
+            // El centro de la cubeta puede quedar fuera de lo observado
+            return std::min(maximo, std::max(minimo, valorCubeta(i)));
+        }
+    }
+    return maximo;
+}
@@ -0,0 +1,122 @@
+#include "../include/IndiceEspacial.h"
+#include "../include/Persona.h"
+#include <algorithm>
+#include <cmath>
+
+IndiceEspacial::IndiceEspacial()
+    : filas(0), columnas(0), cubetasFilas(0), cubetasColumnas(0) {
+}
+
+void IndiceEspacial::configurar(int numFilas, int numColumnas) {
+    filas = numFilas;
+    columnas = numColumnas;
+    cubetasFilas = std::max(1, (filas + TAM_CUBETA - 1) / TAM_CUBETA);
+    cubetasColumnas = std::max(1, (columnas + TAM_CUBETA - 1) / TAM_CUBETA);
+    cubetas.assign(static_cast<size_t>(cubetasFilas) * cubetasColumnas, {});
+    ubicaciones.clear();
+}
+
+void IndiceEspacial::limpiar() {
+    for (auto& cubeta : cubetas) {
+        cubeta.clear();
+    }
+    ubicaciones.clear();
+}
+
+int IndiceEspacial::cubetaDe(Posicion posicion) const {
+    int f = std::min(std::max(posicion.x() / TAM_CUBETA, 0), cubetasFilas - 1);
+    int c = std::min(std::max(posicion.y() / TAM_CUBETA, 0), cubetasColumnas - 1);
+    return f * cubetasColumnas + c;
+}
+
+void IndiceEspacial::quitarDeCubeta(const Ubicacion& ubicacion) {
+    // Se cambia por la última entrada de la cubeta, que pasa a ocupar su lugar
+    auto& cubeta = cubetas[ubicacion.cubeta];
+    if (ubicacion.indice + 1 != cubeta.size()) {
+        cubeta[ubicacion.indice] = std::move(cubeta.back());
+        ubicaciones[cubeta[ubicacion.indice].persona->getId()].indice = ubicacion.indice;
+    }
+    cubeta.pop_back();
+}
+
+void IndiceEspacial::actualizar(const std::shared_ptr<Persona>& persona) {
+    if (cubetas.empty()) return;
+
+    const Posicion posicion = persona->getPosicion();
+    const int cubeta = cubetaDe(posicion);
+    auto it = ubicaciones.find(persona->getId());
+
+    if (it != ubicaciones.end()) {
+        if (it->second.cubeta == cubeta) {
+            cubetas[cubeta][it->second.indice].posicion = posicion;
+            return;
+        }
+        Ubicacion anterior = it->second;
+        quitarDeCubeta(anterior);
+        it = ubicaciones.find(persona->getId());
+        it->second = Ubicacion{cubeta, cubetas[cubeta].size()};
+    } else {
+        ubicaciones.emplace(persona->getId(), Ubicacion{cubeta, cubetas[cubeta].size()});
+    }
+    cubetas[cubeta].push_back(Entrada{persona, posicion});
+}
+
+void IndiceEspacial::quitar(int id) {
+    auto it = ubicaciones.find(id);
+    if (it == ubicaciones.end()) return;
+
+    Ubicacion ubicacion = it->second;
+    ubicaciones.erase(it);
+    quitarDeCubeta(ubicacion);
+}
+
+void IndiceEspacial::buscarMasCercanas(Posicion centro, double radio, size_t k,
+                                       std::vector<std::pair<double, std::shared_ptr<Persona>>>& resultado) const {
+    resultado.clear();
+    if (ubicaciones.empty() || k == 0) return;
+
+    const int cubetaFila = std::min(std::max(centro.x() / TAM_CUBETA, 0), cubetasFilas - 1);
+    const int cubetaColumna = std::min(std::max(centro.y() / TAM_CUBETA, 0), cubetasColumnas - 1);
+    const int maxAnillo = static_cast<int>(std::ceil(radio / TAM_CUBETA)) + 1;
+
+    // Montículo de máximos con las k mejores: en el frente está la peor de ellas
+    auto masCerca = [](const std::pair<double, std::shared_ptr<Persona>>& a,
+                       const std::pair<double, std::shared_ptr<Persona>>& b) {
+        if (a.first != b.first) return a.first < b.first;
+        return a.second->getId() < b.second->getId();
+    };
+
+    for (int anillo = 0; anillo <= maxAnillo; ++anillo) {
+        // Ya se encontró a todas: no hace falta recorrer el resto del mapa
+        if (resultado.size() == ubicaciones.size()) break;
+
+        const double cota = resultado.size() == k ? resultado.front().first : radio;
+        if (anillo > 0 && (anillo - 1) * TAM_CUBETA >= cota) break;
+
+        for (int f = cubetaFila - anillo; f <= cubetaFila + anillo; ++f) {
+            if (f < 0 || f >= cubetasFilas) continue;
+            const bool bordeFila = (f == cubetaFila - anillo || f == cubetaFila + anillo);
+            const int paso = bordeFila ? 1 : std::max(1, 2 * anillo);
+
+            for (int c = cubetaColumna - anillo; c <= cubetaColumna + anillo; c += paso) {
+                if (c < 0 || c >= cubetasColumnas) continue;
+                for (const auto& entrada : cubetas[f * cubetasColumnas + c]) {
+                    double dist = std::hypot(centro.x() - entrada.posicion.x(),
+                                             centro.y() - entrada.posicion.y());
+                    if (dist >= radio) continue;
+
+                    std::pair<double, std::shared_ptr<Persona>> candidato(dist, entrada.persona);
+                    if (resultado.size() < k) {
+                        resultado.push_back(std::move(candidato));
+                        std::push_heap(resultado.begin(), resultado.end(), masCerca);
+                    } else if (masCerca(candidato, resultado.front())) {
+                        std::pop_heap(resultado.begin(), resultado.end(), masCerca);
+                        resultado.back() = std::move(candidato);
+                        std::push_heap(resultado.begin(), resultado.end(), masCerca);
+                    }
+                }
+            }
+        }
+    }
+    std::sort_heap(resultado.begin(), resultado.end(), masCerca);
+}
@@ -0,0 +1,338 @@
+#include "../include/MotorCampoPiso.h"
+#include "../include/Simd.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Orden de las opciones; la 4 es quedarse en la celda
+const int DESPLAZAMIENTO_FILA[MotorCampoPiso::NUM_OPCIONES] = {-1, -1, -1, 0, 0, 0, 1, 1, 1};
+const int DESPLAZAMIENTO_COLUMNA[MotorCampoPiso::NUM_OPCIONES] = {-1, 0, 1, -1, 0, 1, -1, 0, 1};
+const int OPCION_QUEDARSE = 4;
+const uint16_t SOLO_QUEDARSE = 1u << OPCION_QUEDARSE;
+
+// Logit de las opciones no admisibles (su peso se descarta por máscara)
+const float LOGIT_DESCARTADO = -80.0f;
+
+uint64_t mezclar(uint64_t x) {
+    // splitmix64
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+float uniforme(uint64_t x) {
+    return static_cast<float>(x >> 40) * (1.0f / 16777216.0f);  // [0, 1)
+}
+}
+
+MotorCampoPiso::MotorCampoPiso(PoolHilos* pool)
+    : pool(pool), campo(nullptr), velocidadReferencia(1.0f), semilla(0x5EED), paso(0),
+    filas(0), columnas(0), pasoFila(0) {
+}
+
+void MotorCampoPiso::configurar(const Escenario& escenario, const CampoDistancias* campoDistancias) {
+    campo = campoDistancias;
+    filas = escenario.filas;
+    columnas = escenario.columnas;
+
+    const size_t numCeldas = static_cast<size_t>(filas) * columnas;
+    tipoCelda.resize(numCeldas);
+    for (int f = 0; f < filas; ++f) {
+        for (int c = 0; c < columnas; ++c) {
+            tipoCelda[f * columnas + c] = static_cast<uint8_t>(escenario.grid[f][c]);
+        }
+    }
+
+    // Borde de una celda alrededor y margen para que el último vector de la
+    // fila pueda leer su vecina derecha
+    pasoFila = ((columnas + 2 + simd::ANCHO + simd::ANCHO - 1) / simd::ANCHO) * simd::ANCHO;
+    const size_t tamDinamico = static_cast<size_t>(filas + 2) * pasoFila;
+    dinamico.assign(tamDinamico, 0.0f);
+    dinamicoSiguiente.assign(tamDinamico, 0.0f);
+    mascaraPiso.assign(tamDinamico, 0.0f);
+    for (int f = 0; f < filas; ++f) {
+        for (int c = 0; c < columnas; ++c) {
+            if (tipoCelda[f * columnas + c] != 1) {
+                mascaraPiso[(f + 1) * pasoFila + c + 1] = 1.0f;
+            }
+        }
+    }
+
+    ocupante.assign(numCeldas, -1);
+    for (size_t i = 0; i < agentes.size(); ++i) {
+        ocupante[celda[i]] = static_cast<int32_t>(i);
+    }
+
+    ganador.assign(numCeldas, -1);
+    mejorPrioridad.assign(numCeldas, 0);
+    aspirantes.assign(numCeldas, 0);
+    celdasDisputadas.clear();
+}
+
+void MotorCampoPiso::limpiar() {
+    agentes.clear();
+    celda.clear();
+    probabilidadMovimiento.clear();
+    std::fill(ocupante.begin(), ocupante.end(), -1);
+    std::fill(dinamico.begin(), dinamico.end(), 0.0f);
+    movimientos.clear();
+    evacuados.clear();
+    sinOpciones.clear();
+    paso = 0;
+}
+
+void MotorCampoPiso::agregar(const std::shared_ptr<AgenteBase>& agente) {
+    Posicion posicion = agente->getPosicion();
+    int32_t indice = posicion.x() * columnas + posicion.y();
+
+    ocupante[indice] = static_cast<int32_t>(agentes.size());
+    agentes.push_back(agente);
+    celda.push_back(indice);
+    probabilidadMovimiento.push_back(1.0f);
+}
+
+float MotorCampoPiso::getCampoDinamico(int fila, int col) const {
+    if (fila < 0 || fila >= filas || col < 0 || col >= columnas) return 0.0f;
+    return dinamico[(fila + 1) * pasoFila + col + 1];
+}
+
+int MotorCampoPiso::indiceDinamico(int celdaPlana) const {
+    return (celdaPlana / columnas + 1) * pasoFila + celdaPlana % columnas + 1;
+}
+
+bool MotorCampoPiso::admisible(int desde, int df, int dc) const {
+    const int f = desde / columnas + df;
+    const int c = desde % columnas + dc;
+    if (f < 0 || f >= filas || c < 0 || c >= columnas) return false;
+
+    const int destino = f * columnas + c;
+    if (tipoCelda[destino] == 1 || ocupante[destino] >= 0) return false;
+
+    // En diagonal no se atraviesan esquinas de pared
+    if (df != 0 && dc != 0) {
+        if (tipoCelda[desde + df * columnas] == 1 || tipoCelda[desde + dc] == 1) return false;
+    }
+    return true;
+}
+
+uint64_t MotorCampoPiso::aleatorio(size_t agente, uint64_t flujo) const {
+    uint64_t clave = semilla ^ mezclar(paso * 4 + flujo);
+    return mezclar(clave ^ static_cast<uint64_t>(agentes[agente]->getId()));
+}
+
+void MotorCampoPiso::avanzar() {
+    movimientos.clear();
+    evacuados.clear();
+    sinOpciones.clear();
+    if (agentes.empty() || !campo) return;
+
+    // Quien ya está en una salida (colocado allí o por una edición del mapa)
+    // sale sin moverse
+    retirarEnSalidas();
+    const size_t n = agentes.size();
+    if (n == 0) return;
+
+    // La velocidad cambia con el pánico: los lentos intentan moverse menos veces
+    for (size_t i = 0; i < n; ++i) {
+        float velocidad = static_cast<float>(agentes[i]->calcularVelocidadEfectiva());
+        probabilidadMovimiento[i] = std::min(1.0f, velocidad / velocidadReferencia);
+    }
+
+    // 1. Logits de las 9 opciones de cada agente, contiguos por agente
+    const size_t numPesos = n * NUM_OPCIONES;
+    const size_t numVectores = (numPesos + simd::ANCHO - 1) / simd::ANCHO;
+    pesos.resize(numVectores * simd::ANCHO);
+    opciones.resize(n);
+    objetivo.resize(n);
+    prioridad.resize(n);
+    pool->paraCadaRango(n, [this](size_t inicio, size_t fin) { calcularPesos(inicio, fin); }, 512);
+
+    // 2. exp() de todo el lote de una vez
+    pool->paraCadaRango(numVectores, [this](size_t inicio, size_t fin) {
+        float* datos = pesos.data();
+        for (size_t v = inicio; v < fin; ++v) {
+            float* p = datos + v * simd::ANCHO;
+            simd::guardar(p, simd::expAprox(simd::cargar(p)));
+        }
+    }, 1024);
+
+    // 3. Cada agente elige su celda objetivo
+    pool->paraCadaRango(n, [this](size_t inicio, size_t fin) { elegirObjetivos(inicio, fin); }, 1024);
+
+    // 4. Conflictos y movimientos
+    resolverConflictos();
+
+    // 5. Difusión y decaimiento del campo dinámico
+    pool->paraCadaRango(static_cast<size_t>(filas), [this](size_t inicio, size_t fin) {
+        difundirCampoDinamico(inicio, fin);
+    }, 32);
+    dinamico.swap(dinamicoSiguiente);
+
+    paso++;
+}
+
+void MotorCampoPiso::calcularPesos(size_t inicio, size_t fin) {
+    const std::vector<float>& distancias = campo->getDistancias();
+
+    for (size_t i = inicio; i < fin; ++i) {
+        const int actual = celda[i];
+        const float distanciaActual = distancias[actual];
+        float* logits = &pesos[i * NUM_OPCIONES];
+        uint16_t admisibles = SOLO_QUEDARSE;
+
+        for (int k = 0; k < NUM_OPCIONES; ++k) {
+            const int df = DESPLAZAMIENTO_FILA[k];
+            const int dc = DESPLAZAMIENTO_COLUMNA[k];
+            const int destino = actual + df * columnas + dc;
+
+            if (k == OPCION_QUEDARSE) {
+                logits[k] = ACOPLAMIENTO_DINAMICO * dinamico[indiceDinamico(actual)];
+                continue;
+            }
+            // Sin camino a la salida el agente no tiene hacia dónde ir
+            if (distanciaActual == CampoDistancias::INALCANZABLE || !admisible(actual, df, dc) ||
+                distancias[destino] == CampoDistancias::INALCANZABLE) {
+                logits[k] = LOGIT_DESCARTADO;
+                continue;
+            }
+            // S relativo a la celda actual: acotado por √2, exp no se desborda
+            logits[k] = ACOPLAMIENTO_ESTATICO * (distanciaActual - distancias[destino]) +
+                        ACOPLAMIENTO_DINAMICO * dinamico[indiceDinamico(destino)];
+            admisibles = static_cast<uint16_t>(admisibles | (1u << k));
+        }
+        opciones[i] = admisibles;
+    }
+}
+
+void MotorCampoPiso::elegirObjetivos(size_t inicio, size_t fin) {
+    for (size_t i = inicio; i < fin; ++i) {
+        const uint16_t admisibles = opciones[i];
+        const float* w = &pesos[i * NUM_OPCIONES];
+        objetivo[i] = -1;
+        prioridad[i] = static_cast<uint32_t>(aleatorio(i, 2));
+
+        if (admisibles == SOLO_QUEDARSE) {
+            continue;
+        }
+        if (uniforme(aleatorio(i, 0)) >= probabilidadMovimiento[i]) {
+            continue;
+        }
+
+        float total = 0.0f;
+        for (int k = 0; k < NUM_OPCIONES; ++k) {
+            if (admisibles & (1u << k)) total += w[k];
+        }
+        float u = uniforme(aleatorio(i, 1)) * total;
+        int elegida = OPCION_QUEDARSE;
+        for (int k = 0; k < NUM_OPCIONES; ++k) {
+            if (!(admisibles & (1u << k))) continue;
+            elegida = k;
+            u -= w[k];
+            if (u < 0.0f) break;
+        }
+
+        if (elegida != OPCION_QUEDARSE) {
+            objetivo[i] = celda[i] + DESPLAZAMIENTO_FILA[elegida] * columnas + DESPLAZAMIENTO_COLUMNA[elegida];
+        }
+    }
+}
+
+void MotorCampoPiso::resolverConflictos() {
+    const size_t n = agentes.size();
+
+    for (size_t i = 0; i < n; ++i) {
+        const int32_t t = objetivo[i];
+        if (t < 0) {
+            // Sin ninguna celda libre alrededor (distinto de elegir quedarse)
+            if (opciones[i] == SOLO_QUEDARSE) sinOpciones.push_back(agentes[i]);
+            continue;
+        }
+        if (aspirantes[t] == 0) {
+            celdasDisputadas.push_back(t);
+            ganador[t] = static_cast<int32_t>(i);
+            mejorPrioridad[t] = prioridad[i];
+        } else if (prioridad[i] > mejorPrioridad[t]) {
+            ganador[t] = static_cast<int32_t>(i);
+            mejorPrioridad[t] = prioridad[i];
+        }
+        aspirantes[t]++;
+    }
+
+    bool hayEvacuados = false;
+    for (int32_t t : celdasDisputadas) {
+        const int32_t i = ganador[t];
+        const bool friccion = aspirantes[t] > 1 &&
+                              uniforme(mezclar(semilla ^ mezclar(paso) ^ static_cast<uint64_t>(t))) < FRICCION;
+        aspirantes[t] = 0;
+        if (friccion) continue;
+
+        const int32_t desde = celda[i];
+        ocupante[desde] = -1;
+        dinamico[indiceDinamico(desde)] += 1.0f;  // Rastro en la celda que deja
+        movimientos.push_back(Movimiento{agentes[i],
+                                         Posicion(desde / columnas, desde % columnas),
+                                         Posicion(t / columnas, t % columnas)});
+        celda[i] = t;
+
+        if (tipoCelda[t] == 2) {
+            hayEvacuados = true;
+        } else {
+            ocupante[t] = i;
+        }
+    }
+    celdasDisputadas.clear();
+
+    if (hayEvacuados) retirarEnSalidas();
+}
+
+void MotorCampoPiso::retirarEnSalidas() {
+    // Compactar quitando a quienes están en una salida (la salida no queda
+    // ocupada); todos quedan en 'evacuados'
+    const size_t n = agentes.size();
+    size_t destino = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (tipoCelda[celda[i]] == 2) {
+            if (ocupante[celda[i]] == static_cast<int32_t>(i)) ocupante[celda[i]] = -1;
+            evacuados.push_back(std::move(agentes[i]));
+            continue;
+        }
+        if (destino != i) {
+            agentes[destino] = std::move(agentes[i]);
+            celda[destino] = celda[i];
+            probabilidadMovimiento[destino] = probabilidadMovimiento[i];
+            ocupante[celda[destino]] = static_cast<int32_t>(destino);
+        }
+        destino++;
+    }
+    agentes.resize(destino);
+    celda.resize(destino);
+    probabilidadMovimiento.resize(destino);
+}
+
+void MotorCampoPiso::difundirCampoDinamico(size_t filaInicio, size_t filaFin) {
+    using namespace simd;
+
+    // D' = (1 - δ)·((1 - α)·D + α/8·Σ vecinas), solo sobre piso
+    const VecF vCentro = repetir((1.0f - DECAIMIENTO) * (1.0f - DIFUSION));
+    const VecF vVecina = repetir((1.0f - DECAIMIENTO) * DIFUSION / 8.0f);
+    const float* d = dinamico.data();
+    const float* m = mascaraPiso.data();
+    float* salida = dinamicoSiguiente.data();
+
+    for (size_t f = filaInicio; f < filaFin; ++f) {
+        const size_t fila = (f + 1) * pasoFila;
+        for (int c = 1; c <= columnas; c += ANCHO) {
+            const float* arriba = d + fila - pasoFila + c;
+            const float* medio = d + fila + c;
+            const float* abajo = d + fila + pasoFila + c;
+
+            VecF vecinas = sumar(sumar(cargar(arriba - 1), cargar(arriba)), cargar(arriba + 1));
+            vecinas = sumar(vecinas, sumar(cargar(medio - 1), cargar(medio + 1)));
+            vecinas = sumar(vecinas, sumar(sumar(cargar(abajo - 1), cargar(abajo)), cargar(abajo + 1)));
+
+            VecF nuevo = multSumar(cargar(medio), vCentro, multiplicar(vecinas, vVecina));
+            guardar(salida + fila + c, multiplicar(nuevo, cargar(m + fila + c)));
+        }
+    }
+}
@@ -0,0 +1,436 @@
+#include "../include/MotorFuerzaSocial.h"
+#include "../include/Simd.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Posición de relleno: lejos de todo, nunca entra en el corte
+const float POSICION_RELLENO = 1.0e6f;
+const float EPSILON_DISTANCIA = 1.0e-6f;
+
+template <typename T>
+void reordenar(std::vector<T>& datos, const std::vector<uint32_t>& orden, std::vector<T>& tmp) {
+    const size_t n = orden.size();
+    tmp.resize(datos.size());
+    for (size_t i = 0; i < n; ++i) {
+        tmp[i] = std::move(datos[orden[i]]);
+    }
+    for (size_t i = n; i < datos.size(); ++i) {
+        tmp[i] = std::move(datos[i]);  // Relleno
+    }
+    datos.swap(tmp);
+}
+}
+
+MotorFuerzaSocial::MotorFuerzaSocial(PoolHilos* pool)
+    : pool(pool), campo(nullptr), escalaVelocidad(1.0f), filas(0), columnas(0),
+    hashFilas(0), hashColumnas(0), rapidezMaxima(0.0f) {
+}
+
+void MotorFuerzaSocial::configurar(const Escenario& escenario, const CampoDistancias* campoDistancias) {
+    campo = campoDistancias;
+    filas = escenario.filas;
+    columnas = escenario.columnas;
+
+    tipoCelda.resize(static_cast<size_t>(filas) * columnas);
+    for (int f = 0; f < filas; ++f) {
+        for (int c = 0; c < columnas; ++c) {
+            tipoCelda[f * columnas + c] = static_cast<uint8_t>(escenario.grid[f][c]);
+        }
+    }
+
+    // Las posiciones van de -0.5 a filas - 0.5
+    hashFilas = std::max(1, static_cast<int>(std::ceil(filas / CORTE)));
+    hashColumnas = std::max(1, static_cast<int>(std::ceil(columnas / CORTE)));
+    inicioCelda.assign(static_cast<size_t>(hashFilas) * hashColumnas + 1, 0);
+}
+
+void MotorFuerzaSocial::limpiar() {
+    agentes.clear();
+    px.clear(); py.clear();
+    vx.clear(); vy.clear();
+    radio.clear();
+    velocidadDeseada.clear();
+    bx.clear(); by.clear();
+    mxx.clear(); mxy.clear(); myy.clear();
+    celdaFila.clear(); celdaColumna.clear();
+    evacuados.clear();
+    cambiosCelda.clear();
+    rapidezMaxima = 0.0f;
+}
+
+void MotorFuerzaSocial::agregar(const std::shared_ptr<AgenteBase>& agente) {
+    const size_t n = agentes.size();
+    Posicion celda = agente->getPosicion();
+
+    agentes.push_back(agente);
+    // Los arreglos tienen relleno al final: se inserta en la posición n
+    px.resize(n); py.resize(n);
+    vx.resize(n); vy.resize(n);
+    radio.resize(n);
+    velocidadDeseada.resize(n);
+    px.push_back(static_cast<float>(celda.x()));
+    py.push_back(static_cast<float>(celda.y()));
+    vx.push_back(0.0f);
+    vy.push_back(0.0f);
+    radio.push_back(RADIO_AGENTE);
+    velocidadDeseada.push_back(static_cast<float>(agente->calcularVelocidadEfectiva()) * escalaVelocidad);
+    celdaFila.push_back(celda.x());
+    celdaColumna.push_back(celda.y());
+
+    ajustarRelleno();
+}
+
+void MotorFuerzaSocial::ajustarRelleno() {
+    // ANCHO elementos extra para que el kernel pueda leer un vector completo
+    // al final de cualquier rango; quedan fuera del corte y se enmascaran.
+    const size_t n = agentes.size();
+    const size_t conRelleno = n + simd::ANCHO;
+    px.resize(n); py.resize(n); vx.resize(n); vy.resize(n); radio.resize(n);
+    px.resize(conRelleno, POSICION_RELLENO);
+    py.resize(conRelleno, POSICION_RELLENO);
+    vx.resize(conRelleno, 0.0f);
+    vy.resize(conRelleno, 0.0f);
+    radio.resize(conRelleno, 0.0f);
+    velocidadDeseada.resize(n);
+    bx.resize(n); by.resize(n);
+    mxx.resize(n); mxy.resize(n); myy.resize(n);
+}
+
+bool MotorFuerzaSocial::esPared(int fila, int col) const {
+    if (fila < 0 || fila >= filas || col < 0 || col >= columnas) return true;
+    return tipoCelda[fila * columnas + col] == 1;
+}
+
+int MotorFuerzaSocial::hashFila(float x) const {
+    int h = static_cast<int>((x + 0.5f) / CORTE);
+    return std::min(std::max(h, 0), hashFilas - 1);
+}
+
+int MotorFuerzaSocial::hashColumna(float y) const {
+    int h = static_cast<int>((y + 0.5f) / CORTE);
+    return std::min(std::max(h, 0), hashColumnas - 1);
+}
+
+void MotorFuerzaSocial::avanzar(float segundos) {
+    evacuados.clear();
+    cambiosCelda.clear();
+    if (agentes.empty() || !campo) return;
+
+    // La velocidad deseada cambia con el pánico
+    for (size_t i = 0; i < agentes.size(); ++i) {
+        velocidadDeseada[i] = static_cast<float>(agentes[i]->calcularVelocidadEfectiva()) * escalaVelocidad;
+    }
+
+    float restante = segundos;
+    while (restante > 0.0f && !agentes.empty()) {
+        // Lo que falta se reparte en subpasos iguales para no terminar con un resto diminuto
+        const float paso = calcularPaso();
+        const float dt = restante / std::ceil(restante / paso);
+        const size_t n = agentes.size();
+        ordenarPorCeldas();
+        pool->paraCadaRango(n, [this, dt](size_t inicio, size_t fin) { calcularFuerzas(inicio, fin, dt); }, 256);
+        pool->paraCadaRango(n, [this, dt](size_t inicio, size_t fin) { integrar(inicio, fin, dt); }, 1024);
+        retirarEvacuados();  // Quien llegó a la salida deja de ocuparla en el mismo subpaso
+        restante -= dt;
+        if (restante < 1e-3f * segundos) break;  // Error de redondeo del último subpaso
+    }
+
+    recogerResultados();
+}
+
+float MotorFuerzaSocial::calcularPaso() const {
+    // Nadie avanza más que DESPLAZAMIENTO_MAXIMO por subpaso, ni con la
+    // velocidad actual ni con la deseada (a la que tiende la relajación)
+    float rapidez = 0.0f;
+    for (size_t i = 0; i < agentes.size(); ++i) {
+        rapidez = std::max(rapidez, std::max(vx[i] * vx[i] + vy[i] * vy[i],
+                                             velocidadDeseada[i] * velocidadDeseada[i]));
+    }
+    rapidez = std::sqrt(rapidez);
+    if (rapidez <= 0.0f) return PASO_MAXIMO;
+    return std::min(PASO_MAXIMO, std::max(PASO_MINIMO, DESPLAZAMIENTO_MAXIMO / rapidez));
+}
+
+void MotorFuerzaSocial::ordenarPorCeldas() {
+    const size_t n = agentes.size();
+    const size_t numCeldas = static_cast<size_t>(hashFilas) * hashColumnas;
+
+    // Counting sort por celda del hash: agentes de una misma fila del hash
+    // quedan contiguos, así los vecinos son tres rangos de memoria.
+    celdaHash.resize(n);
+    std::fill(inicioCelda.begin(), inicioCelda.end(), 0);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t celda = static_cast<uint32_t>(hashFila(px[i]) * hashColumnas + hashColumna(py[i]));
+        celdaHash[i] = celda;
+        inicioCelda[celda + 1]++;
+    }
+    for (size_t c = 0; c < numCeldas; ++c) {
+        inicioCelda[c + 1] += inicioCelda[c];
+    }
+
+    orden.resize(n);
+    std::vector<uint32_t>& cursor = celdaHash;  // Se reutiliza como destino de cada agente
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t destino = inicioCelda[celdaHash[i]]++;
+        cursor[i] = destino;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        orden[cursor[i]] = static_cast<uint32_t>(i);
+    }
+    // Restaurar los inicios (quedaron desplazados una celda)
+    for (size_t c = numCeldas; c > 0; --c) {
+        inicioCelda[c] = inicioCelda[c - 1];
+    }
+    inicioCelda[0] = 0;
+
+    reordenar(px, orden, tmpFloat);
+    reordenar(py, orden, tmpFloat);
+    reordenar(vx, orden, tmpFloat);
+    reordenar(vy, orden, tmpFloat);
+    reordenar(radio, orden, tmpFloat);
+    reordenar(velocidadDeseada, orden, tmpFloat);
+    reordenar(celdaFila, orden, tmpEntero);
+    reordenar(celdaColumna, orden, tmpEntero);
+    reordenar(agentes, orden, tmpAgentes);
+}
+
+void MotorFuerzaSocial::calcularFuerzas(size_t inicio, size_t fin, float dt) {
+    using namespace simd;
+
+    const VecF vRepulsion = repetir(FUERZA_REPULSION);
+    const VecF vInvAlcance = repetir(1.0f / ALCANCE_REPULSION);
+    const VecF vRigidezRepulsion = repetir(FUERZA_REPULSION / ALCANCE_REPULSION);
+    const VecF vRigidez = repetir(RIGIDEZ_CUERPO);
+    const VecF vFriccion = repetir(FRICCION_DESLIZAMIENTO);
+    const VecF vCorte2 = repetir(CORTE * CORTE);
+    const VecF vEpsilon = repetir(EPSILON_DISTANCIA);
+    const VecF vCero = repetir(0.0f);
+    const VecF vDt = repetir(dt);
+    const VecF vCarriles = indices();
+
+    for (size_t i = inicio; i < fin; ++i) {
+        const float xi = px[i];
+        const float yi = py[i];
+        const VecF vxi = repetir(xi);
+        const VecF vyi = repetir(yi);
+        const VecF vvxi = repetir(vx[i]);
+        const VecF vvyi = repetir(vy[i]);
+        const VecF vri = repetir(radio[i]);
+
+        // Fuerza explícita, acoplamiento C = dt·k_n·n·nᵀ + κ·g·t·tᵀ sumado
+        // sobre los vecinos, y C·(v_i + v_j) sumado
+        VecF sumaX = vCero, sumaY = vCero;
+        VecF sumaCxx = vCero, sumaCxy = vCero, sumaCyy = vCero;
+        VecF sumaCvX = vCero, sumaCvY = vCero;
+
+        const int hf = hashFila(xi);
+        const int hc = hashColumna(yi);
+        const int c0 = std::max(0, hc - 1);
+        const int c1 = std::min(hashColumnas - 1, hc + 1);
+
+        for (int f = std::max(0, hf - 1); f <= std::min(hashFilas - 1, hf + 1); ++f) {
+            const uint32_t a = inicioCelda[f * hashColumnas + c0];
+            const uint32_t b = inicioCelda[f * hashColumnas + c1 + 1];
+            const VecF vFin = repetir(static_cast<float>(b));
+
+            for (uint32_t j = a; j < b; j += ANCHO) {
+                const VecF dx = restar(vxi, cargar(&px[j]));
+                const VecF dy = restar(vyi, cargar(&py[j]));
+                const VecF d2 = multSumar(dx, dx, multiplicar(dy, dy));
+
+                // Carriles válidos: dentro del rango, no el propio agente, dentro del corte
+                VecF mascara = menorQue(sumar(repetir(static_cast<float>(j)), vCarriles), vFin);
+                mascara = yLogico(mascara, menorQue(vEpsilon, d2));
+                mascara = yLogico(mascara, menorQue(d2, vCorte2));
+
+                const VecF d = raiz(maximo(d2, vEpsilon));
+                const VecF invD = dividir(repetir(1.0f), d);
+                const VecF nx = multiplicar(dx, invD);
+                const VecF ny = multiplicar(dy, invD);
+
+                const VecF solape = restar(sumar(vri, cargar(&radio[j])), d);
+                const VecF contacto = maximo(solape, vCero);
+
+                // Normal: repulsión exponencial + compresión del cuerpo
+                const VecF exponencial = expAprox(multiplicar(solape, vInvAlcance));
+                const VecF normal = multSumar(vRigidez, contacto, multiplicar(vRepulsion, exponencial));
+                sumaX = sumar(sumaX, seleccionar(mascara, multiplicar(normal, nx)));
+                sumaY = sumar(sumaY, seleccionar(mascara, multiplicar(normal, ny)));
+
+                // Rigidez normal (derivada de la fuerza normal respecto de d) y
+                // fricción; la fricción actúa solo con contacto
+                VecF rigidez = multiplicar(vRigidezRepulsion, exponencial);
+                rigidez = sumar(rigidez, seleccionar(menorQue(vCero, solape), vRigidez));
+                const VecF a = seleccionar(mascara, multiplicar(vDt, rigidez));
+                const VecF c = seleccionar(mascara, multiplicar(vFriccion, contacto));
+
+                // C = a·n·nᵀ + c·t·tᵀ con t = (-ny, nx)
+                const VecF nxx = multiplicar(nx, nx);
+                const VecF nyy = multiplicar(ny, ny);
+                const VecF nxy = multiplicar(nx, ny);
+                const VecF cxx = multSumar(a, nxx, multiplicar(c, nyy));
+                const VecF cyy = multSumar(a, nyy, multiplicar(c, nxx));
+                const VecF cxy = multiplicar(restar(a, c), nxy);
+                sumaCxx = sumar(sumaCxx, cxx);
+                sumaCxy = sumar(sumaCxy, cxy);
+                sumaCyy = sumar(sumaCyy, cyy);
+
+                const VecF svx = sumar(vvxi, cargar(&vx[j]));
+                const VecF svy = sumar(vvyi, cargar(&vy[j]));
+                sumaCvX = sumar(sumaCvX, multSumar(cxx, svx, multiplicar(cxy, svy)));
+                sumaCvY = sumar(sumaCvY, multSumar(cxy, svx, multiplicar(cyy, svy)));
+            }
+        }
+
+        // Impulso hacia la salida
+        float dirFila = 0.0f;
+        float dirColumna = 0.0f;
+        campo->getDireccionInterpolada(xi, yi, dirFila, dirColumna);
+        const float v0 = velocidadDeseada[i];
+
+        float paredX = 0.0f, paredY = 0.0f;
+        float kxx = 0.0f, kxy = 0.0f, kyy = 0.0f;
+        fuerzaParedes(xi, yi, radio[i], paredX, paredY, kxx, kxy, kyy);
+
+        // (1 + dt/τ)·v' + dt·Σ 2C·(v' - m) + dt²·K·v' = v + dt·(F + v0·e/τ),
+        // con m = (v_i + v_j)/2: entre pares se relaja la velocidad relativa
+        const float relajacion = dt / TIEMPO_RELAJACION;
+        const float diagonal = 1.0f + relajacion;
+        mxx[i] = diagonal + 2.0f * dt * sumaHorizontal(sumaCxx) + dt * dt * kxx;
+        mxy[i] = 2.0f * dt * sumaHorizontal(sumaCxy) + dt * dt * kxy;
+        myy[i] = diagonal + 2.0f * dt * sumaHorizontal(sumaCyy) + dt * dt * kyy;
+        bx[i] = vx[i] + dt * (sumaHorizontal(sumaX) + paredX + sumaHorizontal(sumaCvX)) + relajacion * v0 * dirFila;
+        by[i] = vy[i] + dt * (sumaHorizontal(sumaY) + paredY + sumaHorizontal(sumaCvY)) + relajacion * v0 * dirColumna;
+    }
+}
+
+void MotorFuerzaSocial::fuerzaParedes(float x, float y, float r, float& fx, float& fy,
+                                      float& kxx, float& kxy, float& kyy) const {
+    const int f0 = static_cast<int>(std::lround(x));
+    const int c0 = static_cast<int>(std::lround(y));
+
+    for (int f = f0 - 1; f <= f0 + 1; ++f) {
+        for (int c = c0 - 1; c <= c0 + 1; ++c) {
+            if (!esPared(f, c)) continue;
+
+            // Punto más cercano del cuadrado de la pared
+            float cx = std::min(std::max(x, f - 0.5f), f + 0.5f);
+            float cy = std::min(std::max(y, c - 0.5f), c + 0.5f);
+            float dx = x - cx;
+            float dy = y - cy;
+            float d = std::sqrt(dx * dx + dy * dy);
+            if (d < EPSILON_DISTANCIA) continue;  // Dentro de la pared: lo resuelve integrar()
+
+            float nx = dx / d;
+            float ny = dy / d;
+            float solape = r - d;
+            float exponencial = std::exp(solape / ALCANCE_REPULSION);
+            float normal = FUERZA_REPULSION * exponencial + RIGIDEZ_CUERPO * std::max(solape, 0.0f);
+            fx += normal * nx;
+            fy += normal * ny;
+
+            float rigidez = FUERZA_REPULSION / ALCANCE_REPULSION * exponencial +
+                            (solape > 0.0f ? RIGIDEZ_CUERPO : 0.0f);
+            kxx += rigidez * nx * nx;
+            kxy += rigidez * nx * ny;
+            kyy += rigidez * ny * ny;
+        }
+    }
+}
+
+void MotorFuerzaSocial::integrar(size_t inicio, size_t fin, float dt) {
+    for (size_t i = inicio; i < fin; ++i) {
+        // M es identidad más semidefinidas positivas: det >= 1
+        const float det = mxx[i] * myy[i] - mxy[i] * mxy[i];
+        float nvx = (myy[i] * bx[i] - mxy[i] * by[i]) / det;
+        float nvy = (mxx[i] * by[i] - mxy[i] * bx[i]) / det;
+
+        float nx = px[i] + nvx * dt;
+        float ny = py[i] + nvy * dt;
+
+        // Nunca entrar en una pared: se desliza por el eje libre o se detiene
+        if (esPared(static_cast<int>(std::lround(nx)), static_cast<int>(std::lround(ny)))) {
+            if (!esPared(static_cast<int>(std::lround(nx)), static_cast<int>(std::lround(py[i])))) {
+                ny = py[i];
+                nvy = 0.0f;
+            } else if (!esPared(static_cast<int>(std::lround(px[i])), static_cast<int>(std::lround(ny)))) {
+                nx = px[i];
+                nvx = 0.0f;
+            } else {
+                nx = px[i];
+                ny = py[i];
+                nvx = nvy = 0.0f;
+            }
+        }
+
+        vx[i] = nvx;
+        vy[i] = nvy;
+        px[i] = nx;
+        py[i] = ny;
+    }
+}
+
+void MotorFuerzaSocial::retirarEvacuados() {
+    const size_t n = agentes.size();
+    size_t destino = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        int fila = static_cast<int>(std::lround(px[i]));
+        int col = static_cast<int>(std::lround(py[i]));
+
+        if (fila >= 0 && fila < filas && col >= 0 && col < columnas &&
+            tipoCelda[fila * columnas + col] == 2) {
+            Posicion salida(fila, col);
+            if (salida != Posicion(celdaFila[i], celdaColumna[i])) {
+                cambiosCelda.push_back(CambioCelda{agentes[i], Posicion(celdaFila[i], celdaColumna[i]), salida});
+            }
+            evacuados.push_back(std::move(agentes[i]));
+            continue;
+        }
+
+        // Compactar quitando a los evacuados
+        if (destino != i) {
+            agentes[destino] = std::move(agentes[i]);
+            px[destino] = px[i]; py[destino] = py[i];
+            vx[destino] = vx[i]; vy[destino] = vy[i];
+            radio[destino] = radio[i];
+            velocidadDeseada[destino] = velocidadDeseada[i];
+            celdaFila[destino] = celdaFila[i];
+            celdaColumna[destino] = celdaColumna[i];
+        }
+        destino++;
+    }
+
+    if (destino != n) {
+        agentes.resize(destino);
+        celdaFila.resize(destino);
+        celdaColumna.resize(destino);
+        ajustarRelleno();
+    }
+}
+
+void MotorFuerzaSocial::recogerResultados() {
+    rapidezMaxima = 0.0f;
+
+    for (size_t i = 0; i < agentes.size(); ++i) {
+        int fila = static_cast<int>(std::lround(px[i]));
+        int col = static_cast<int>(std::lround(py[i]));
+
+        if (fila != celdaFila[i] || col != celdaColumna[i]) {
+            cambiosCelda.push_back(CambioCelda{agentes[i], Posicion(celdaFila[i], celdaColumna[i]), Posicion(fila, col)});
+            celdaFila[i] = fila;
+            celdaColumna[i] = col;
+        }
+        rapidezMaxima = std::max(rapidezMaxima, std::sqrt(vx[i] * vx[i] + vy[i] * vy[i]));
+    }
+}
+
+void MotorFuerzaSocial::capturar(std::vector<InstantaneaAgente>& destino) const {
+    for (size_t i = 0; i < agentes.size(); ++i) {
+        InstantaneaAgente instantanea = capturarInstantanea(*agentes[i]);
+        instantanea.x = px[i];
+        instantanea.y = py[i];
+        destino.push_back(instantanea);
+    }
+}
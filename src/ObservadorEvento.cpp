@@ -1,6 +1,4 @@
 #include "../include/ObservadorEvento.h"
-#include "../include/AgenteBase.h"
-#include <iostream>
 #include <sstream>
 
 /**
@@ -12,35 +10,33 @@ GestorEventos::GestorEventos()
       totalEnPanico(0) {
 }
 
+/**
+ * Se suscribe a los eventos que cuenta
+ */
+void GestorEventos::suscribirse(BusEventos& bus) {
+    auto recibir = [this](const Evento& evento) { onEvento(evento); };
+    bus.suscribir(TipoEvento::EVACUADO, recibir);
+    bus.suscribir(TipoEvento::BLOQUEADO, recibir);
+    bus.suscribir(TipoEvento::PANICO, recibir);
+}
+
 /**
  * Implementación del método de notificación
  */
-void GestorEventos::onEventoAgente(AgenteBase* agente, const std::string& tipoEvento) {
-    if (!agente) return;
-    
-    // Procesar el evento y actualizar contadores
-    if (tipoEvento == "EVACUADO") {
-        totalEvacuados++;
-        std::cout << "[EVENTO] Agente " << agente->getId() 
-                  << " ha sido evacuado exitosamente." << std::endl;
-    }
-    else if (tipoEvento == "BLOQUEADO") {
-        totalBloqueados++;
-        std::cout << "[EVENTO] Agente " << agente->getId() 
-                  << " está bloqueado." << std::endl;
-    }
-    else if (tipoEvento == "PANICO") {
-        totalEnPanico++;
-        std::cout << "[EVENTO] Agente " << agente->getId() 
-                  << " entró en pánico." << std::endl;
-    }
-    else if (tipoEvento == "ASISTIENDO_PERSONA") {
-        std::cout << "[EVENTO] Rescatista " << agente->getId() 
-                  << " está asistiendo a una persona." << std::endl;
-    }
-    else if (tipoEvento == "OBSTACULO_ENCONTRADO") {
-        std::cout << "[EVENTO] Agente " << agente->getId() 
-                  << " encontró un obstáculo." << std::endl;
+void GestorEventos::onEvento(const Evento& evento) {
+    // Solo contadores: el detalle de cada evento queda en el bus, sin E/S aquí
+    switch (evento.tipo) {
+        case TipoEvento::EVACUADO:
+            totalEvacuados++;
+            break;
+        case TipoEvento::BLOQUEADO:
+            totalBloqueados++;
+            break;
+        case TipoEvento::PANICO:
+            totalEnPanico++;
+            break;
+        default:
+            break;
     }
 }
 
@@ -1,65 +1,93 @@
 #include "../include/PathFinder.h"
-#include <queue>
-#include <map>
 #include <algorithm>
+#include <cstdint>
+#include <vector>
 
-//usamos una estructura simple para comparar QPoints en el mapa de padres
-struct PointCompare {
-    bool operator()(const QPoint& a, const QPoint& b) const {
-        if (a.x() != b.x()) return a.x() < b.x();
-        return a.y() < b.y();
-    }
+namespace {
+
+//búferes del BFS, reutilizados entre llamadas del mismo hilo: una celda
+//está vista si 'vista' tiene el número de la búsqueda actual, así que no
+//hay que limpiar nada entre búsquedas
+struct BuferesBusqueda {
+    std::vector<uint32_t> vista;
+    std::vector<uint32_t> padre;  //índice de la celda desde la que se llegó
+    std::vector<uint32_t> frontera;
+    uint32_t busqueda = 0;
 };
 
-QPoint PathFinder::calcularSiguientePaso(Escenario* mapa, QPoint inicio, QPoint fin) {
+thread_local BuferesBusqueda buferes;
+
+}
+
+Posicion PathFinder::calcularSiguientePaso(Escenario* mapa, Posicion inicio, Posicion fin) {
     if (inicio == fin) return inicio;
 
-    //cola para el BFS
-    std::queue<QPoint> frontera;
-    frontera.push(inicio);
+    const int filas = mapa->filas;
+    const int columnas = mapa->columnas;
+    if (inicio.x() < 0 || inicio.x() >= filas || inicio.y() < 0 || inicio.y() >= columnas ||
+        fin.x() < 0 || fin.x() >= filas || fin.y() < 0 || fin.y() >= columnas) {
+        return inicio;  //fuera del mapa no hay camino
+    }
+
+    //celdas indexadas como fila * columnas + columna
+    const size_t celdas = static_cast<size_t>(filas) * columnas;
+    if (buferes.vista.size() < celdas) {
+        buferes.vista.assign(celdas, 0);
+        buferes.padre.resize(celdas);
+    }
+    if (++buferes.busqueda == 0) {  //el contador dio la vuelta
+        std::fill(buferes.vista.begin(), buferes.vista.end(), 0);
+        buferes.busqueda = 1;
+    }
+    const uint32_t busqueda = buferes.busqueda;
+    uint32_t* vista = buferes.vista.data();
+    uint32_t* padre = buferes.padre.data();
+    std::vector<uint32_t>& frontera = buferes.frontera;
 
-    //mapa para reconstruir el camino: hijo -> padre
-    std::map<QPoint, QPoint, PointCompare> padres;
-    padres[inicio] = QPoint(-1, -1); //marca de inicio
+    const uint32_t origen = inicio.indice(columnas);
+    const uint32_t destino = fin.indice(columnas);
+    frontera.clear();
+    frontera.push_back(origen);
+    vista[origen] = busqueda;
 
     bool encontrado = false;
 
-    //direcciones: arriba, abajo, izquierda, derecha
-    int dx[] = {-1, 1, 0, 0};
-    int dy[] = {0, 0, -1, 1};
+    //direcciones: arriba, abajo, izquierda, derecha (decide entre caminos del mismo largo)
+    const int dx[] = {-1, 1, 0, 0};
+    const int dy[] = {0, 0, -1, 1};
 
-    while (!frontera.empty()) {
-        QPoint actual = frontera.front();
-        frontera.pop();
-
-        if (actual == fin) {
+    for (size_t cabeza = 0; cabeza < frontera.size(); ++cabeza) {
+        const uint32_t actual = frontera[cabeza];
+        if (actual == destino) {
             encontrado = true;
             break;
         }
 
         //explorar vecinos
+        const int fila = static_cast<int>(actual / static_cast<uint32_t>(columnas));
+        const int columna = static_cast<int>(actual % static_cast<uint32_t>(columnas));
         for (int i = 0; i < 4; ++i) {
-            QPoint vecino(actual.x() + dx[i], actual.y() + dy[i]);
+            const int vecinoFila = fila + dx[i];
+            const int vecinoColumna = columna + dy[i];
 
             //si es transitable y no lo hemos visitado aun
-            if (mapa->esTransitable(vecino.x(), vecino.y()) && 
-                padres.find(vecino) == padres.end()) {
-                
-                frontera.push(vecino);
-                padres[vecino] = actual; //guardamos de donde vinimos
-            }
+            if (!mapa->esTransitable(vecinoFila, vecinoColumna)) continue;
+            const uint32_t vecino = static_cast<uint32_t>(vecinoFila) * columnas + vecinoColumna;
+            if (vista[vecino] == busqueda) continue;
+
+            vista[vecino] = busqueda;
+            padre[vecino] = actual;  //guardamos de donde vinimos
+            frontera.push_back(vecino);
         }
     }
 
     if (!encontrado) return inicio; //no hay camino, nos quedamos quietos
 
     //reconstruir el camino desde el FIN hacia el INICIO
-    QPoint paso = fin;
-    while (padres[paso] != inicio) {
-        paso = padres[paso];
-        //seguridad para evitar bucles infinitos si algo falla
-        if (paso == QPoint(-1, -1)) return inicio; 
+    uint32_t paso = destino;
+    while (padre[paso] != origen) {
+        paso = padre[paso];
     }
 
-    return paso; //este es el primer paso inmediato que debe dar el agente
-}
\ No newline at end of file
+    return Posicion::desdeIndice(paso, columnas); //este es el primer paso inmediato que debe dar el agente
+}
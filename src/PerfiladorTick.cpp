@@ -0,0 +1,85 @@
+#include "../include/PerfiladorTick.h"
+#include <iomanip>
+#include <sstream>
+
+namespace {
+// setw cuenta bytes: con tildes (UTF-8) la columna quedaría corrida
+std::string rellenarColumna(const std::string& texto, size_t ancho) {
+    size_t caracteres = 0;
+    for (unsigned char c : texto) {
+        caracteres += (c & 0xC0) != 0x80;
+    }
+    return texto + std::string(ancho > caracteres ? ancho - caracteres : 0, ' ');
+}
+}
+
+PerfiladorTick::PerfiladorTick() {
+    limpiar();
+}
+
+const char* PerfiladorTick::nombreFase(FaseTick fase) {
+    switch (fase) {
+        case FaseTick::BUSQUEDA_SALIDA: return "Búsqueda de salida";
+        case FaseTick::BUSQUEDA_RUTA:   return "Búsqueda de ruta";
+        case FaseTick::COLISIONES:      return "Colisiones";
+        case FaseTick::MOTOR:           return "Motor de movimiento";
+        case FaseTick::RESCATE:         return "Rescate";
+        case FaseTick::ESTADISTICAS:    return "Estadísticas";
+        case FaseTick::EVENTOS:         return "Eventos";
+        case FaseTick::PUBLICACION:     return "Publicación del frame";
+        case FaseTick::TICK:            return "Tick completo";
+        case FaseTick::NUM_FASES:       break;
+    }
+    return "";
+}
+
+void PerfiladorTick::cerrarTick() {
+    for (size_t i = 0; i < NUM_FASES; ++i) {
+        if (!medida[i]) {
+            continue;  // Una fase que no corrió (p. ej. el motor en modo rejilla) no cuenta como 0
+        }
+        histogramas[i].registrar(acumulado[i] / 1000.0);
+        totalNs[i] += acumulado[i];
+        acumulado[i] = 0;
+        medida[i] = false;
+    }
+}
+
+void PerfiladorTick::limpiar() {
+    for (size_t i = 0; i < NUM_FASES; ++i) {
+        histogramas[i].limpiar();
+        acumulado[i] = 0;
+        medida[i] = false;
+        totalNs[i] = 0;
+    }
+}
+
+std::string PerfiladorTick::generarReporte() const {
+    const size_t tick = static_cast<size_t>(FaseTick::TICK);
+    const double totalTick = static_cast<double>(totalNs[tick]);
+
+    std::stringstream ss;
+    ss << "=== PERFIL DEL TICK (microsegundos por tick) ===\n";
+    ss << rellenarColumna("Fase", 24)
+       << std::setw(8) << "Ticks" << std::setw(10) << "Prom." << std::setw(10) << "P50"
+       << std::setw(10) << "P95" << std::setw(10) << "P99" << std::setw(11) << "Máx."
+       << std::setw(8) << "%" << "\n";
+    ss << std::fixed << std::setprecision(1);
+
+    for (size_t i = 0; i < NUM_FASES; ++i) {
+        const HistogramaHDR& h = histogramas[i];
+        if (h.getCantidad() == 0) {
+            continue;
+        }
+        const double parte = totalTick > 0 ? 100.0 * totalNs[i] / totalTick : 0.0;
+        ss << rellenarColumna(nombreFase(static_cast<FaseTick>(i)), 24)
+           << std::setw(8) << h.getCantidad() << std::setw(10) << h.getPromedio()
+           << std::setw(10) << h.percentil(50) << std::setw(10) << h.percentil(95)
+           << std::setw(10) << h.percentil(99) << std::setw(10) << h.getMaximo()
+           << std::setw(8) << parte << "\n";
+    }
+    if (histogramas[tick].getCantidad() == 0) {
+        ss << "(sin ticks medidos)\n";
+    }
+    return ss.str();
+}
@@ -7,12 +7,15 @@
  */
 Persona::Persona(int id, Posicion posInicial, int edad, bool movilidadReducida)
     : AgenteBase(id, posInicial, 1.5,
-                 movilidadReducida ? TipoComportamiento::MOVILIDAD_REDUCIDA : TipoComportamiento::NORMAL),
+                 movilidadReducida ? TipoComportamiento::MOVILIDAD_REDUCIDA : TipoComportamiento::NORMAL,
+                 TIPO),
     edad(edad),
     nivelPanico(0.0),
     movilidadReducida(movilidadReducida),
     factorVelocidadBase(1.0),
-    escenario(nullptr) {  // NUEVO: Puntero al escenario
+    escenario(nullptr),  // NUEVO: Puntero al escenario
+    asistida(false),
+    cargada(false) {
 
     // Calcular velocidad base según edad y movilidad
     factorVelocidadBase = calcularFactorEdad();
@@ -47,7 +50,7 @@ void Persona::actualizar(double deltaTime) {
     // NUEVO: Verificar si llegó a una salida ANTES de actualizar
     if (escenario != nullptr && verificarLlegadaSalida()) {
         setEstado(EstadoAgente::EVACUADO);
-        notificarEvento("EVACUACION_EXITOSA");
+        notificarEvento(TipoEvento::EVACUACION_EXITOSA);
         return;  // No seguir actualizando, la persona ya evacuó
     }
 
@@ -60,7 +63,7 @@ void Persona::actualizar(double deltaTime) {
     // NUEVO: Verificar nuevamente después del movimiento
     if (escenario != nullptr && verificarLlegadaSalida()) {
         setEstado(EstadoAgente::EVACUADO);
-        notificarEvento("EVACUACION_EXITOSA");
+        notificarEvento(TipoEvento::EVACUACION_EXITOSA);
         return;
     }
 
@@ -158,7 +161,7 @@ void Persona::reaccionarObstaculo() {
     }
 
     // Notificar el evento
-    notificarEvento("OBSTACULO_ENCONTRADO");
+    notificarEvento(TipoEvento::OBSTACULO_ENCONTRADO);
 }
 
 /**
@@ -193,6 +196,16 @@ void Persona::incrementarPanico(double cantidad) {
     }
 }
 
+/**
+ * Verifica si la persona necesita ayuda de un rescatista
+ */
+bool Persona::necesitaAyuda() const {
+    if (asistida || estado == EstadoAgente::EVACUADO) {
+        return false;
+    }
+    return movilidadReducida || estEnPanico() || estado == EstadoAgente::BLOQUEADO;
+}
+
 /**
  * Reduce el nivel de pánico
  */
@@ -0,0 +1,99 @@
+#include "../include/PoolHilos.h"
+#include "../include/TrazaEventos.h"
+#include <algorithm>
+
+PoolHilos::PoolHilos(unsigned int numHilos)
+    : cuerpoActual(nullptr), totalElementos(0), tamanoBloque(0), siguienteBloque(0),
+    numBloques(0), bloquesPendientes(0), generacion(0), detener(false) {
+    if (numHilos == 0) {
+        numHilos = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned int i = 1; i < numHilos; ++i) {
+        trabajadores.emplace_back(&PoolHilos::bucleTrabajador, this);
+    }
+}
+
+PoolHilos::~PoolHilos() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        detener = true;
+    }
+    hayTrabajo.notify_all();
+    for (auto& hilo : trabajadores) {
+        hilo.join();
+    }
+}
+
+void PoolHilos::paraCadaRango(size_t n, const std::function<void(size_t, size_t)>& cuerpo,
+                              size_t minimoPorBloque) {
+    if (n == 0) return;
+
+    // Unos pocos bloques por hilo equilibran la carga sin mucho reparto
+    size_t bloquesDeseados = static_cast<size_t>(getNumHilos()) * 4;
+    size_t tamano = std::max(minimoPorBloque, (n + bloquesDeseados - 1) / bloquesDeseados);
+    if (trabajadores.empty() || tamano >= n) {
+        cuerpo(0, n);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cuerpoActual = &cuerpo;
+        totalElementos = n;
+        tamanoBloque = tamano;
+        siguienteBloque = 0;
+        numBloques = (n + tamano - 1) / tamano;
+        bloquesPendientes = numBloques;
+        generacion++;
+    }
+    hayTrabajo.notify_all();
+
+    ejecutarBloques();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    trabajoTerminado.wait(lock, [this]() { return bloquesPendientes == 0; });
+    cuerpoActual = nullptr;
+}
+
+bool PoolHilos::tomarBloque(const std::function<void(size_t, size_t)>*& cuerpo,
+                            size_t& inicio, size_t& fin) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!cuerpoActual || siguienteBloque >= numBloques) {
+        return false;
+    }
+    cuerpo = cuerpoActual;
+    inicio = siguienteBloque * tamanoBloque;
+    fin = std::min(totalElementos, inicio + tamanoBloque);
+    siguienteBloque++;
+    return true;
+}
+
+void PoolHilos::ejecutarBloques() {
+    const std::function<void(size_t, size_t)>* cuerpo;
+    size_t inicio, fin;
+    while (tomarBloque(cuerpo, inicio, fin)) {
+        {
+            TRAZAR("bloque", "pool");
+            (*cuerpo)(inicio, fin);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--bloquesPendientes == 0) {
+            trabajoTerminado.notify_all();
+        }
+    }
+}
+
+void PoolHilos::bucleTrabajador() {
+    TrazaEventos::nombrarHilo("trabajador del pool");
+    unsigned long vista = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            hayTrabajo.wait(lock, [this, vista]() { return detener || generacion != vista; });
+            if (detener) return;
+            vista = generacion;
+        }
+        ejecutarBloques();
+    }
+}
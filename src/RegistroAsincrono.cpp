@@ -0,0 +1,148 @@
+#include "../include/RegistroAsincrono.h"
+#include <chrono>
+#include <iostream>
+
+namespace {
+// Cada cuánto despierta el escritor si nadie lo llama
+const auto INTERVALO_ESCRITOR = std::chrono::milliseconds(5);
+
+const char* nombreNivel(NivelRegistro nivel) {
+    switch (nivel) {
+        case NivelRegistro::TRAZA: return "TRAZA";
+        case NivelRegistro::DEPURACION: return "DEPURACION";
+        case NivelRegistro::INFO: return "INFO";
+        case NivelRegistro::ADVERTENCIA: return "ADVERTENCIA";
+        case NivelRegistro::ERROR: return "ERROR";
+        default: return "?";
+    }
+}
+}
+
+RegistroAsincrono& RegistroAsincrono::global() {
+    static RegistroAsincrono registro(std::clog);
+    return registro;
+}
+
+RegistroAsincrono::RegistroAsincrono(std::ostream& salida)
+    : celdas(new Celda[CAPACIDAD]), posicionEscritura(0), posicionLectura(0),
+      tickActual(0), descartadas(0), escritas(0), salida(salida), detener(false) {
+    for (size_t i = 0; i < CAPACIDAD; ++i) {
+        celdas[i].secuencia.store(i, std::memory_order_relaxed);
+    }
+    escritor = std::thread(&RegistroAsincrono::bucleEscritor, this);
+}
+
+RegistroAsincrono::~RegistroAsincrono() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        detener = true;
+    }
+    cambio.notify_all();
+    escritor.join();
+}
+
+void RegistroAsincrono::escribir(NivelRegistro nivel, CodigoRegistro codigo, double a0, double a1, double a2) {
+    size_t posicion = posicionEscritura.load(std::memory_order_relaxed);
+    Celda* celda;
+    for (;;) {
+        celda = &celdas[posicion & (CAPACIDAD - 1)];
+        const size_t secuencia = celda->secuencia.load(std::memory_order_acquire);
+        const intptr_t diferencia = static_cast<intptr_t>(secuencia) - static_cast<intptr_t>(posicion);
+        if (diferencia == 0) {
+            if (posicionEscritura.compare_exchange_weak(posicion, posicion + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diferencia < 0) {
+            // Búfer lleno: se pierde la entrada, no se espera
+            descartadas.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            posicion = posicionEscritura.load(std::memory_order_relaxed);
+        }
+    }
+
+    const auto ahora = std::chrono::steady_clock::now().time_since_epoch();
+    celda->entrada = EntradaRegistro{
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(ahora).count()),
+        tickActual.load(std::memory_order_relaxed), nivel, codigo, {a0, a1, a2}};
+    celda->secuencia.store(posicion + 1, std::memory_order_release);
+}
+
+bool RegistroAsincrono::extraer(EntradaRegistro& entrada) {
+    Celda& celda = celdas[posicionLectura & (CAPACIDAD - 1)];
+    if (celda.secuencia.load(std::memory_order_acquire) != posicionLectura + 1) {
+        return false;  // Vacío, o el productor de esta celda todavía no terminó
+    }
+    entrada = celda.entrada;
+    celda.secuencia.store(posicionLectura + CAPACIDAD, std::memory_order_release);
+    ++posicionLectura;
+    return true;
+}
+
+void RegistroAsincrono::formatear(const EntradaRegistro& entrada) {
+    const double* a = entrada.argumentos;
+    salida << "[" << nombreNivel(entrada.nivel) << "] tick " << entrada.tick << ": ";
+    switch (entrada.codigo) {
+        case CodigoRegistro::AGENTE_EVACUADO:
+            salida << "🚪 Agente " << a[0] << " evacuado en " << a[1] << " s con " << a[2] << " pasos";
+            break;
+        case CodigoRegistro::AGENTE_SIN_SALIDA:
+            salida << "⚠️  Agente " << a[0] << " no puede encontrar salida";
+            break;
+        case CodigoRegistro::PERSONA_EVACUADA:
+            salida << "📊 Persona " << a[0] << " evacuada";
+            break;
+        case CodigoRegistro::RESCATISTA_EVACUADO:
+            salida << "📊 Rescatista " << a[0] << " evacuado";
+            break;
+        case CodigoRegistro::TOTAL_EVACUADOS:
+            salida << "📊 Total evacuados: " << a[0] << " / " << a[1];
+            break;
+        case CodigoRegistro::SIMULACION_ESTANCADA:
+            salida << "⚠️  Simulación estancada. Agentes restantes: " << a[0];
+            break;
+        case CodigoRegistro::SIMULACION_COMPLETA:
+            salida << "✅ ¡Todos los agentes han evacuado exitosamente!";
+            break;
+        default:
+            salida << "código " << static_cast<int>(entrada.codigo);
+            break;
+    }
+    salida << '\n';
+}
+
+void RegistroAsincrono::bucleEscritor() {
+    EntradaRegistro entrada;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        const bool terminar = detener;
+        lock.unlock();
+
+        bool hubo = false;
+        while (extraer(entrada)) {
+            formatear(entrada);
+            hubo = true;
+            escritas.fetch_add(1, std::memory_order_release);
+        }
+        if (hubo) {
+            salida.flush();
+        }
+
+        lock.lock();
+        if (terminar) {
+            break;
+        }
+        cambio.notify_all();  // Para quien espera en vaciar()
+        cambio.wait_for(lock, INTERVALO_ESCRITOR);
+    }
+}
+
+void RegistroAsincrono::vaciar() {
+    // Hasta dónde hay que llegar (sin contar lo descartado)
+    const size_t objetivo = posicionEscritura.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mutex);
+    while (escritas.load(std::memory_order_acquire) < objetivo && !detener) {
+        cambio.notify_all();
+        cambio.wait_for(lock, INTERVALO_ESCRITOR);
+    }
+}
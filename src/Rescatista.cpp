@@ -7,9 +7,10 @@
  * Constructor de Rescatista
  */
 Rescatista::Rescatista(int id, Posicion posInicial)
-    : AgenteBase(id, posInicial, 2.5, TipoComportamiento::RESCATISTA),
-      estaAsistiendo(false),
-      capacidadCarga(0.7) {
+    : AgenteBase(id, posInicial, 2.5, TipoComportamiento::RESCATISTA, TIPO),
+      fase(FaseRescate::LIBRE),
+      capacidadCarga(0.7),
+      personaInalcanzable(-1) {
 }
 
 /**
@@ -20,15 +21,15 @@ void Rescatista::actualizar(double deltaTime) {
         return;
     }
     
-    // Si está asistiendo a alguien, actualizar su posición también
-    if (estaAsistiendo) {
+    // Si la lleva consigo, actualizar su posición también
+    if (fase == FaseRescate::CARGANDO) {
         auto persona = personaAsistida.lock();
         if (persona) {
             // La persona asistida se mueve con el rescatista
             persona->setPosicion(posicion);
         } else {
             // Si la persona ya no existe, liberar
-            estaAsistiendo = false;
+            fase = FaseRescate::LIBRE;
         }
     }
     
@@ -37,11 +38,11 @@ void Rescatista::actualizar(double deltaTime) {
 }
 
 /**
- * Calcula la velocidad efectiva (considerando si está asistiendo)
+ * Calcula la velocidad efectiva (considerando si está cargando a alguien)
  */
 double Rescatista::calcularVelocidadEfectiva() const {
-    if (estaAsistiendo) {
-        // Velocidad reducida al asistir a alguien
+    if (fase == FaseRescate::CARGANDO) {
+        // Velocidad reducida al llevar a alguien; mientras va a buscarla no
         return velocidad * capacidadCarga;
     }
     return velocidad;
@@ -51,7 +52,7 @@ double Rescatista::calcularVelocidadEfectiva() const {
  * Define cómo reacciona el rescatista ante un obstáculo
  */
 void Rescatista::reaccionarObstaculo() {
-    notificarEvento("RESCATISTA_OBSTACULO");
+    notificarEvento(TipoEvento::RESCATISTA_OBSTACULO);
 }
 
 /**
@@ -70,61 +71,48 @@ void Rescatista::asistirPersona(std::shared_ptr<Persona> persona) {
     if (!persona) return;
     
     personaAsistida = persona;
-    estaAsistiendo = true;
+    fase = FaseRescate::EN_CAMINO;
+    persona->setAsistida(true);
     
-    notificarEvento("ASISTIENDO_PERSONA");
+    notificarEvento(TipoEvento::ASISTIENDO_PERSONA, persona->getId());
+}
+
+/**
+ * La alcanzó: desde ahora la lleva consigo
+ */
+void Rescatista::tomarPersona() {
+    auto persona = personaAsistida.lock();
+    if (fase != FaseRescate::EN_CAMINO || !persona) return;
+
+    fase = FaseRescate::CARGANDO;
+    persona->setCargada(true);
+}
+
+/**
+ * No hay camino hasta la persona asignada
+ */
+void Rescatista::descartarPersona() {
+    if (fase != FaseRescate::EN_CAMINO) return;
+
+    if (auto persona = personaAsistida.lock()) {
+        personaInalcanzable = persona->getId();
+    }
+    liberarPersona();
 }
 
 /**
  * Libera a la persona asistida
  */
 void Rescatista::liberarPersona() {
-    if (estaAsistiendo) {
+    if (fase != FaseRescate::LIBRE) {
         auto persona = personaAsistida.lock();
         if (persona) {
             persona->reducirPanico(0.5);
+            persona->setAsistida(false);
+            persona->setCargada(false);
         }
-        estaAsistiendo = false;
+        fase = FaseRescate::LIBRE;
         personaAsistida.reset();
-        notificarEvento("PERSONA_LIBERADA");
+        notificarEvento(TipoEvento::PERSONA_LIBERADA);
     }
 }
-
-/**
- * Busca personas cercanas que necesiten asistencia
- */
-void Rescatista::buscarPersonasQueNecesitanAyuda(const std::vector<std::shared_ptr<AgenteBase>>& agentes) {
-    if (estaAsistiendo) {
-        return;
-    }
-    
-    const double RADIO_BUSQUEDA = 50.0;
-    std::shared_ptr<Persona> personaMasCercana = nullptr;
-    double distanciaMinima = RADIO_BUSQUEDA;
-    
-    for (const auto& agente : agentes) {
-        // Intentar convertir a Persona
-        auto persona = std::dynamic_pointer_cast<Persona>(agente);
-        
-        if (persona && 
-            (persona->tieneMovilidadReducida() || 
-             persona->estEnPanico() || 
-             persona->getEstado() == EstadoAgente::BLOQUEADO)) {
-            
-            // CORRECCIÓN MATEMÁTICA: Usamos hypot para calcular distancia entre QPoints
-            // QPoint usa .x() y .y(), no .x y .y
-            double dx = posicion.x() - persona->getPosicion().x();
-            double dy = posicion.y() - persona->getPosicion().y();
-            double dist = std::hypot(dx, dy);
-            
-            if (dist < distanciaMinima) {
-                distanciaMinima = dist;
-                personaMasCercana = persona;
-            }
-        }
-    }
-    
-    if (personaMasCercana) {
-        asistirPersona(personaMasCercana);
-    }
-}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "../include/RuedaTemporal.h"
+
+RuedaTemporal::RuedaTemporal() : tickActual(0), cantidad(0) {
+}
+
+void RuedaTemporal::limpiar(uint64_t tickInicial) {
+    for (auto& ranura : nivel0) ranura.clear();
+    for (auto& ranura : nivel1) ranura.clear();
+    desborde.clear();
+    tickActual = tickInicial;
+    cantidad = 0;
+}
+
+void RuedaTemporal::programar(std::shared_ptr<AgenteBase> agente, uint64_t instante) {
+    insertar(Entrada{std::move(agente), instante});
+    cantidad++;
+}
+
+void RuedaTemporal::insertar(Entrada&& entrada) {
+    uint64_t tick = entrada.instante / SUBTICKS_POR_TICK;
+    if (tick < tickActual) {
+        tick = tickActual;
+    }
+
+    if ((tick >> BITS_NIVEL) == (tickActual >> BITS_NIVEL)) {
+        nivel0[tick & MASCARA].push_back(std::move(entrada));
+    } else if ((tick >> (2 * BITS_NIVEL)) == (tickActual >> (2 * BITS_NIVEL))) {
+        nivel1[(tick >> BITS_NIVEL) & MASCARA].push_back(std::move(entrada));
+    } else {
+        desborde.push_back(std::move(entrada));
+    }
+}
+
+void RuedaTemporal::redistribuir(std::vector<Entrada>& origen) {
+    std::vector<Entrada> pendientes;
+    pendientes.swap(origen);
+    for (auto& entrada : pendientes) {
+        insertar(std::move(entrada));
+    }
+}
+
+void RuedaTemporal::extraerTick(std::vector<Entrada>& vencidas) {
+    // Al entrar en un nuevo bloque se bajan las entradas del nivel superior
+    if ((tickActual & MASCARA) == 0) {
+        if (((tickActual >> BITS_NIVEL) & MASCARA) == 0) {
+            redistribuir(desborde);
+        }
+        redistribuir(nivel1[(tickActual >> BITS_NIVEL) & MASCARA]);
+    }
+
+    auto& ranura = nivel0[tickActual & MASCARA];
+    cantidad -= ranura.size();
+    for (auto& entrada : ranura) {
+        vencidas.push_back(std::move(entrada));
+    }
+    ranura.clear();
+
+    tickActual++;
+}
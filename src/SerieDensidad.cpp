@@ -0,0 +1,151 @@
+#include "../include/SerieDensidad.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+// Menos celdas iguales que esto seguidas no justifican cortar la corrida de cambios
+const size_t MINIMO_CORRIDA_IGUAL = 4;
+
+void escribirVarint(std::vector<uint8_t>& salida, uint64_t valor) {
+    while (valor >= 0x80) {
+        salida.push_back(static_cast<uint8_t>(valor | 0x80));
+        valor >>= 7;
+    }
+    salida.push_back(static_cast<uint8_t>(valor));
+}
+
+uint64_t leerVarint(const uint8_t*& p) {
+    uint64_t valor = 0;
+    int desplazamiento = 0;
+    while (*p & 0x80) {
+        valor |= static_cast<uint64_t>(*p++ & 0x7F) << desplazamiento;
+        desplazamiento += 7;
+    }
+    return valor | (static_cast<uint64_t>(*p++) << desplazamiento);
+}
+
+// Cantidad de bytes iguales desde i, comparando de a 8
+size_t contarIguales(const uint8_t* a, const uint8_t* b, size_t i, size_t n) {
+    const size_t inicio = i;
+    while (i + 8 <= n) {
+        uint64_t x, y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        if (x != y) break;
+        i += 8;
+    }
+    while (i < n && a[i] == b[i]) ++i;
+    return i - inicio;
+}
+
+template <typename T>
+void escribirValor(std::ofstream& archivo, T valor) {
+    archivo.write(reinterpret_cast<const char*>(&valor), sizeof(T));
+}
+}
+
+SerieDensidad::SerieDensidad() : filas(0), columnas(0), intervalo(0) {
+}
+
+void SerieDensidad::configurar(int f, int c, uint32_t intervaloMuestra) {
+    filas = f;
+    columnas = c;
+    intervalo = intervaloMuestra;
+    limpiar();
+}
+
+void SerieDensidad::limpiar() {
+    muestras.clear();
+    datos.clear();
+    anterior.assign(static_cast<size_t>(std::max(0, filas * columnas)), 0);
+}
+
+void SerieDensidad::agregarMuestra(uint32_t tick, const std::vector<uint8_t>& conteo) {
+    if (conteo.size() != anterior.size()) {
+        return;
+    }
+    muestras.push_back(Muestra{tick, datos.size()});
+    if ((muestras.size() - 1) % KEYFRAME_CADA == 0) {
+        std::fill(anterior.begin(), anterior.end(), 0);
+    }
+    codificar(anterior, conteo);
+    anterior = conteo;
+}
+
+void SerieDensidad::codificar(const std::vector<uint8_t>& base, const std::vector<uint8_t>& actual) {
+    const size_t n = actual.size();
+    const uint8_t* a = actual.data();
+    const uint8_t* b = base.data();
+    size_t i = 0;
+    while (i < n) {
+        const size_t iguales = contarIguales(a, b, i, n);
+        i += iguales;
+
+        // Corrida de cambios: termina en una corrida de iguales larga o al final
+        const size_t inicioCambios = i;
+        while (i < n) {
+            if (a[i] != b[i]) {
+                ++i;
+                continue;
+            }
+            const size_t siguientes = contarIguales(a, b, i, std::min(n, i + MINIMO_CORRIDA_IGUAL));
+            if (siguientes >= MINIMO_CORRIDA_IGUAL || i + siguientes == n) break;
+            i += siguientes;
+        }
+
+        escribirVarint(datos, iguales);
+        escribirVarint(datos, i - inicioCambios);
+        for (size_t k = inicioCambios; k < i; ++k) {
+            datos.push_back(static_cast<uint8_t>(a[k] - b[k]));
+        }
+    }
+}
+
+void SerieDensidad::aplicar(size_t indice, std::vector<uint8_t>& mapa) const {
+    const uint64_t fin = indice + 1 < muestras.size() ? muestras[indice + 1].offset : datos.size();
+    const uint8_t* p = datos.data() + muestras[indice].offset;
+    const uint8_t* limite = datos.data() + fin;
+    size_t i = 0;
+    while (p < limite) {
+        i += leerVarint(p);
+        const size_t cambios = leerVarint(p);
+        for (size_t k = 0; k < cambios; ++k) {
+            mapa[i++] += *p++;
+        }
+    }
+}
+
+bool SerieDensidad::decodificar(size_t indice, std::vector<uint8_t>& destino) const {
+    if (indice >= muestras.size()) {
+        return false;
+    }
+    destino.assign(anterior.size(), 0);
+    const size_t keyframe = indice - indice % KEYFRAME_CADA;
+    for (size_t i = keyframe; i <= indice; ++i) {
+        aplicar(i, destino);
+    }
+    return true;
+}
+
+bool SerieDensidad::exportar(const std::string& ruta) const {
+    std::ofstream archivo(ruta, std::ios::binary);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    archivo.write("DENS", 4);
+    escribirValor<uint32_t>(archivo, VERSION_FORMATO);
+    escribirValor<uint32_t>(archivo, static_cast<uint32_t>(filas));
+    escribirValor<uint32_t>(archivo, static_cast<uint32_t>(columnas));
+    escribirValor<uint32_t>(archivo, intervalo);
+    escribirValor<uint32_t>(archivo, KEYFRAME_CADA);
+    escribirValor<uint64_t>(archivo, muestras.size());
+    for (const Muestra& muestra : muestras) {
+        escribirValor<uint32_t>(archivo, muestra.tick);
+        escribirValor<uint64_t>(archivo, muestra.offset);
+    }
+    escribirValor<uint64_t>(archivo, datos.size());
+    archivo.write(reinterpret_cast<const char*>(datos.data()), static_cast<std::streamsize>(datos.size()));
+    return archivo.good();
+}
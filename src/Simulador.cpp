@@ -1,243 +1,1034 @@
 #include "../include/Simulador.h"
 #include "../include/Persona.h"
 #include "../include/Rescatista.h"
+#include "../include/RegistroAsincrono.h"
 #include <QDebug>
+#include <QMetaObject>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
-Simulador::Simulador(QObject *parent)
-    : QObject(parent), escenario(nullptr), esActivo(false), tiempoSimulacion(0.0),
-    ticksSinMovimiento(0), maxTicksSinMovimiento(10) {
-    timer = new QTimer(this);
+Simulador::Simulador(QObject *parent, unsigned int numHilos)
+    : QObject(parent), escenario(nullptr), esActivo(false), preparada(false), terminada(false),
+    intervaloTickMs(INTERVALO_TICK_MS), maximaVelocidad(false),
+    modoMovimiento(ModoMovimiento::REJILLA), tiempoSimulacion(0.0),
+    tickActual(0), grabador(nullptr), exportadorSerie(nullptr), ticksSinMovimiento(0), maxTicksSinMovimiento(10),
+    tilesFilas(0), tilesColumnas(0), numDurmientes(0), versionEscenario(0),
+    agentesEvacuados(0) {
     estadisticas = new EstadisticasSimulacion();
-    connect(timer, &QTimer::timeout, this, &Simulador::loopPrincipal);
+    grabador = new GrabadorTrayectorias();
+    exportadorSerie = new ExportadorSerie();
+    frames = new BufferFrames();
+    bus = new BusEventos();
+    gestorEventos = new GestorEventos();
+    gestorEventos->suscribirse(*bus);
+    pool = new PoolHilos(numHilos);
+    motorFuerzaSocial = new MotorFuerzaSocial(pool);
+    motorCampoPiso = new MotorCampoPiso(pool);
+
+    // El temporizador vive en el hilo de simulación: cada tick se ejecuta allí
+    hilo = new QThread(this);
+    hilo->setObjectName("simulacion");
+    timer = new QTimer();
+    timer->moveToThread(hilo);
+    connect(timer, &QTimer::timeout, timer, [this]() { alVencerTimer(); });
+    hilo->start();
+    ejecutarEnHilo([]() { TrazaEventos::nombrarHilo("simulacion"); });
 }
 
 Simulador::~Simulador() {
+    ejecutarEnHilo([this]() { timer->stop(); });
+    hilo->quit();
+    hilo->wait();
+    for (const auto& agente : agentes) {
+        agente->setConteoEstados(nullptr);  // La GUI puede conservar los agentes
+    }
+    delete timer;
+    delete motorFuerzaSocial;
+    delete motorCampoPiso;
+    delete pool;
+    delete frames;
+    delete bus;
+    delete gestorEventos;
+    delete grabador;  // Cierra el archivo si quedó una grabación abierta
+    delete exportadorSerie;
     delete escenario;
     delete estadisticas;
 }
 
+void Simulador::ejecutarEnHilo(const std::function<void()>& tarea) {
+    // Desde el propio hilo (o con el hilo detenido) no hay nada con qué competir
+    if (QThread::currentThread() == hilo || !hilo->isRunning()) {
+        tarea();
+        return;
+    }
+    // Se ejecuta entre dos ticks y se espera a que termine
+    TRAZAR("espera al hilo de simulacion", "gui");
+    QMetaObject::invokeMethod(timer, tarea, Qt::BlockingQueuedConnection);
+}
+
 void Simulador::cargarEscenario(int filas, int cols) {
-    if (escenario) delete escenario;
-    escenario = new Escenario(filas, cols);
+    ejecutarEnHilo([this, filas, cols]() {
+        if (escenario) delete escenario;
+        escenario = new Escenario(filas, cols);
+        tickActual = 0;
+        preparada = false;
+        terminada = false;
+        publicarFrame();
+    });
+}
+
+void Simulador::editarCelda(int fila, int columna, int tipo) {
+    ejecutarEnHilo([this, fila, columna, tipo]() {
+        // El cambio de versión lo recoge el próximo tick (campo, durmientes)
+        if (escenario) escenario->setCelda(fila, columna, tipo);
+    });
+}
+
+void Simulador::reemplazarCeldas(const std::vector<uint8_t>& celdas) {
+    ejecutarEnHilo([this, &celdas]() {
+        if (escenario) escenario->reemplazarCeldas(celdas);
+    });
 }
 
 void Simulador::agregarAgente(std::shared_ptr<AgenteBase> agente) {
+    ejecutarEnHilo([this, agente]() { agregarAgenteEnHilo(agente); });
+}
+
+void Simulador::agregarAgenteEnHilo(const std::shared_ptr<AgenteBase>& agente) {
     agentes.push_back(agente);
-    pasosPorAgente[agente->getId()] = 0;
-    posicionAnterior[agente->getId()] = agente->getPosicion();
+    agente->setBusEventos(bus);
+    agente->setConteoEstados(&conteoEstados);
+    if (preparada) {
+        if (modoMovimiento == ModoMovimiento::CONTINUO) {
+            motorFuerzaSocial->agregar(agente);
+        } else if (modoMovimiento == ModoMovimiento::CAMPO_PISO) {
+            motorCampoPiso->agregar(agente);
+        } else {
+            ocuparCelda(agente->getPosicion());
+            rueda.programar(agente, (tickActual + 1) * RuedaTemporal::SUBTICKS_POR_TICK);
+        }
+    }
+    if (auto rescatista = comoAgente<Rescatista>(agente)) {
+        rescatistas.push_back(rescatista);
+    }
+    if (preparada) {
+        actualizarIndiceAyuda(agente);
+        estadisticas->registrarAgente(agente);
+    }
 
     // NUEVO: Si es una Persona, asignarle referencia al escenario
-    if (auto persona = std::dynamic_pointer_cast<Persona>(agente)) {
+    if (auto persona = comoAgente<Persona>(agente)) {
         persona->setEscenario(escenario);
     }
+    publicarFrame();
 }
 
 void Simulador::iniciar() {
+    ejecutarEnHilo([this]() { iniciarEnHilo(); });
+}
+
+void Simulador::iniciarEnHilo() {
     if (!escenario) {
         qDebug() << "Error: No hay escenario cargado.";
         return;
     }
 
+    if (terminada) {
+        qDebug() << "La simulación ya terminó: reiníciela para volver a correrla.";
+        return;
+    }
+
+    // Al reanudar tras una pausa se continúa donde se quedó
+    if (!preparada) {
+        prepararSimulacion();
+    }
+
+    esActivo = true;
+    timer->start(maximaVelocidad ? 0 : intervaloTickMs);
+
+    qDebug() << "✅ Simulación iniciada con" << agentes.size() << "agentes.";
+    qDebug() << "📍 Escenario:" << escenario->filas << "x" << escenario->columnas;
+}
+
+void Simulador::prepararSimulacion() {
     if (agentes.empty()) {
         qDebug() << "Advertencia: No hay agentes en el escenario.";
     }
 
-    esActivo = true;
-    tiempoSimulacion = 0.0;
+    preparada = true;
+    tiempoSimulacion = tickActual * (INTERVALO_TICK_MS / 1000.0);
     ticksSinMovimiento = 0;
+    if (modoMovimiento == ModoMovimiento::CONTINUO) {
+        prepararMovimientoContinuo();
+    } else if (modoMovimiento == ModoMovimiento::CAMPO_PISO) {
+        prepararCampoPiso();
+    } else {
+        programarAgentes();
+    }
+
+    indiceAyuda.configurar(escenario->filas, escenario->columnas);
+    for (const auto& agente : agentes) {
+        actualizarIndiceAyuda(agente);
+    }
 
     // Inicializar estadísticas
-    estadisticas->iniciar(agentes.size(), escenario->filas, escenario->columnas);
+    estadisticas->iniciar(escenario->filas, escenario->columnas);
+    estadisticas->actualizarTiempoSimulacion(tickActual, tiempoSimulacion);
+    for (const auto& agente : agentes) {
+        estadisticas->registrarAgente(agente);
+    }
+    publicarFrame();
+}
 
-    // Registrar estado inicial de los agentes
-    estadisticas->actualizarEstadoAgentes(agentes);
+void Simulador::prepararMovimientoContinuo() {
+    versionEscenario = escenario->getVersion();
+    campo.calcular(*escenario);
+    motorFuerzaSocial->configurar(*escenario, &campo);
+    motorFuerzaSocial->limpiar();
 
-    // Iniciar temporizador de simulación
-    tiempoTranscurrido.start();
-    timer->start(500); // 500ms = 0.5 segundos por tick
+    // A la velocidad de referencia se recorre una celda por tick
+    motorFuerzaSocial->setEscalaVelocidad(static_cast<float>(1000.0 / INTERVALO_TICK_MS / VELOCIDAD_REFERENCIA));
+    for (const auto& agente : agentes) {
+        if (agente->getEstado() != EstadoAgente::EVACUADO) {
+            motorFuerzaSocial->agregar(agente);
+        }
+    }
+}
 
-    qDebug() << "✅ Simulación iniciada con" << agentes.size() << "agentes.";
-    qDebug() << "📍 Escenario:" << escenario->filas << "x" << escenario->columnas;
+void Simulador::prepararCampoPiso() {
+    versionEscenario = escenario->getVersion();
+    campo.calcular(*escenario);
+    motorCampoPiso->limpiar();
+    motorCampoPiso->configurar(*escenario, &campo);
+
+    // A la velocidad de referencia se intenta un paso en cada tick
+    motorCampoPiso->setVelocidadReferencia(static_cast<float>(VELOCIDAD_REFERENCIA));
+    for (const auto& agente : agentes) {
+        if (agente->getEstado() != EstadoAgente::EVACUADO) {
+            motorCampoPiso->agregar(agente);
+        }
+    }
+}
+
+bool Simulador::setModoMovimiento(ModoMovimiento modo) {
+    bool aplicado = false;
+    ejecutarEnHilo([this, modo, &aplicado]() {
+        // Cambiar de motor a mitad de una corrida perdería el estado del anterior
+        if (preparada && modo != modoMovimiento) return;
+        modoMovimiento = modo;
+        aplicado = true;
+    });
+    return aplicado;
+}
+
+ModoMovimiento Simulador::getModoMovimiento() const {
+    return modoMovimiento;
 }
 
 void Simulador::pausar() {
-    esActivo = false;
-    timer->stop();
+    // Al volver, el tick en curso (si lo había) ya terminó
+    ejecutarEnHilo([this]() {
+        esActivo = false;
+        timer->stop();
+    });
     qDebug() << "Simulación pausada.";
 }
 
+void Simulador::pasoUnico() {
+    ejecutarEnHilo([this]() {
+        if (esActivo || terminada || !escenario) return;
+        if (!preparada) {
+            prepararSimulacion();
+        }
+        if (avanzarTick()) {
+            publicarFrame();
+        }
+    });
+}
+
+bool Simulador::estaTerminada() {
+    bool resultado = false;
+    ejecutarEnHilo([this, &resultado]() { resultado = terminada; });
+    return resultado;
+}
+
+void Simulador::setIntervaloTick(int ms) {
+    ejecutarEnHilo([this, ms]() {
+        intervaloTickMs = std::max(1, ms);
+        if (!maximaVelocidad && timer->isActive()) {
+            timer->setInterval(intervaloTickMs);
+        }
+    });
+}
+
+void Simulador::setMaximaVelocidad(bool activar) {
+    ejecutarEnHilo([this, activar]() {
+        maximaVelocidad = activar;
+        if (timer->isActive()) {
+            timer->setInterval(maximaVelocidad ? 0 : intervaloTickMs);
+        }
+    });
+}
+
+void Simulador::alVencerTimer() {
+    if (!esActivo) return;
+
+    if (!maximaVelocidad) {
+        if (avanzarTick()) {
+            publicarFrame();
+        }
+        return;
+    }
+
+    // Máxima velocidad: se encadenan ticks durante un frame de pantalla y solo
+    // se publica el último. Volver al bucle de eventos entre lotes permite
+    // atender pausas y cambios de velocidad.
+    QElapsedTimer lote;
+    lote.start();
+    while (avanzarTick()) {
+        if (lote.elapsed() >= PRESUPUESTO_LOTE_MS) {
+            publicarFrame();
+            return;
+        }
+    }
+}
+
 void Simulador::reiniciar() {
     pausar();
+    ejecutarEnHilo([this]() { reiniciarEnHilo(); });
+}
+
+void Simulador::reiniciarEnHilo() {
+    for (const auto& agente : agentes) {
+        agente->setConteoEstados(nullptr);
+    }
     agentes.clear();
-    pasosPorAgente.clear();
-    posicionAnterior.clear();
     tiempoSimulacion = 0.0;
+    tickActual = 0;
+    preparada = false;
+    terminada = false;
     ticksSinMovimiento = 0;
+    rueda.limpiar(0);
+    llegadas.clear();
+    agentesDetenidos.clear();
+    durmientesPorTile.clear();
+    tilesSucios.clear();
+    numDurmientes = 0;
+    motorFuerzaSocial->limpiar();
+    motorCampoPiso->limpiar();
+    campo.limpiar();
+    indiceAyuda.limpiar();
+    rescatistas.clear();
+    asignador.limpiar();
+    agentesEvacuados = 0;
+    bus->descartar();
+    gestorEventos->reiniciarContadores();
+    detenerGrabacion();
+    detenerExportacionSerie();
     estadisticas->reiniciar();
+    perfilador.limpiar();
+    publicarFrame();
     qDebug() << "Simulación reiniciada.";
 }
 
-void Simulador::loopPrincipal() {
-    if (!esActivo) return;
+bool Simulador::avanzarTick() {
+    // Cada tick se cierra al empezar el siguiente: así cuenta también el frame publicado después
+    if constexpr (PerfiladorTick::ACTIVO) {
+        perfilador.cerrarTick();
+    }
+    PERFILAR_FASE(perfilador, FaseTick::TICK);
+    TRAZAR("tick", "simulacion");
 
-    // Actualizar tiempo de simulación
-    tiempoSimulacion = tiempoTranscurrido.elapsed() / 1000.0; // Convertir a segundos
-    estadisticas->actualizarTiempoSimulacion(tiempoSimulacion);
+    tickActual++;
+    bus->setTick(tickActual);
+    RegistroAsincrono::global().setTick(tickActual);
 
+    // Tiempo simulado: no depende de la velocidad a la que se reproduzca
+    tiempoSimulacion = tickActual * (INTERVALO_TICK_MS / 1000.0);
+    estadisticas->actualizarTiempoSimulacion(tickActual, tiempoSimulacion);
+
+    if (modoMovimiento == ModoMovimiento::CONTINUO) {
+        avanzarContinuo();
+    } else if (modoMovimiento == ModoMovimiento::CAMPO_PISO) {
+        avanzarCampoPiso();
+    } else {
+        avanzarRejilla();
+    }
+    {
+        PERFILAR_FASE(perfilador, FaseTick::RESCATE);
+        TRAZAR("asignar rescates", "replanificacion");
+        atenderRescatistas();
+    }
+    {
+        PERFILAR_FASE(perfilador, FaseTick::EVENTOS);
+        bus->despachar();
+    }
+    {
+        PERFILAR_FASE(perfilador, FaseTick::ESTADISTICAS);
+        estadisticas->muestrearDensidad(tickActual, agentes);
+    }
+
+    if (grabador->estaAbierto()) {
+        TRAZAR("grabar trayectoria", "io");
+        capturarAgentes(instantaneas);
+        grabador->registrarTick(tickActual, instantaneas);
+    }
+
+    if (exportadorSerie->estaAbierto()) {
+        PERFILAR_FASE(perfilador, FaseTick::ESTADISTICAS);
+        registrarSerie();
+    }
+
+    if (ticksSinMovimiento >= maxTicksSinMovimiento) {
+        registrar<NivelRegistro::ADVERTENCIA>(CodigoRegistro::SIMULACION_ESTANCADA, agentes.size());
+        terminarSimulacion();
+        return false;
+    }
+
+    // Verificar si todos evacuaron (la lista está vacía)
+    if (agentes.empty()) {
+        registrar<NivelRegistro::INFO>(CodigoRegistro::SIMULACION_COMPLETA);
+        terminarSimulacion();
+        return false;
+    }
+
+    return true;
+}
+
+void Simulador::terminarSimulacion() {
+    terminada = true;
+    // La GUI debe poder mostrar el estado final antes del aviso
+    publicarFrame();
+    pausar();
+    detenerGrabacion();
+    detenerExportacionSerie();
+    estadisticas->calcularEstadisticas();
+    emit simulacionTerminada();
+    RegistroAsincrono::global().vaciar();  // El registro del tick queda antes del resumen
+    mostrarEstadisticas();
+    if constexpr (PerfiladorTick::ACTIVO) {
+        std::cout << perfilador.generarReporte() << std::endl;
+    }
+}
+
+void Simulador::capturarAgentes(std::vector<InstantaneaAgente>& destino) const {
+    destino.clear();
+    if (preparada && modoMovimiento == ModoMovimiento::CONTINUO) {
+        motorFuerzaSocial->capturar(destino);  // Posiciones reales, no la celda
+        return;
+    }
+    for (const auto& agente : agentes) {
+        destino.push_back(capturarInstantanea(*agente));
+    }
+}
+
+void Simulador::publicarFrame() {
+    PERFILAR_FASE(perfilador, FaseTick::PUBLICACION);
+    TRAZAR("publicar frame", "simulacion");
+    FrameSimulacion& frame = frames->escritura();
+    frame.tick = tickActual;
+    frame.tiempo = tiempoSimulacion;
+    capturarAgentes(frame.agentes);
+
+    // Contadores mantenidos en cada cambio de estado: no se recorre a los agentes
+    estadisticas->actualizarResumen(conteoEstados, static_cast<int>(agentes.size()));
+    frame.estadisticas = estadisticas->getResumen();
+
+    frames->publicar();
+}
+
+void Simulador::avanzarRejilla() {
     bool alguienSeMovio = false;
+    int agentesProcesados = 0;
     int agentesEvacuadosEnEsteFrame = 0;
+    agentesDetenidos.clear();
+
+    // Un cambio en el mapa puede abrir rutas nuevas para cualquier agente dormido
+    if (escenario->getVersion() != versionEscenario) {
+        versionEscenario = escenario->getVersion();
+        despertarTodos();
+    }
+
+    // Solo se atienden los agentes que llegan a su siguiente celda en este tick.
+    // Un agente rápido puede llegar varias veces dentro del mismo tick, por eso
+    // las llegadas se ordenan en un heap por instante.
+    const uint64_t finTick = (tickActual + 1) * RuedaTemporal::SUBTICKS_POR_TICK;
+    auto llegaDespues = [](const RuedaTemporal::Entrada& a, const RuedaTemporal::Entrada& b) {
+        if (a.instante != b.instante) return a.instante > b.instante;
+        return a.agente->getId() > b.agente->getId();
+    };
+
+    llegadas.clear();
+    rueda.extraerTick(llegadas);
+    std::make_heap(llegadas.begin(), llegadas.end(), llegaDespues);
+
+    while (!llegadas.empty()) {
+        std::pop_heap(llegadas.begin(), llegadas.end(), llegaDespues);
+        RuedaTemporal::Entrada entrada = std::move(llegadas.back());
+        llegadas.pop_back();
+
+        agentesProcesados++;
+        ResultadoPaso resultado = procesarAgente(entrada.agente);
 
-    // CAMBIO CRÍTICO: Usar iterador para poder eliminar durante el recorrido
-    for (auto it = agentes.begin(); it != agentes.end(); ) {
-        std::shared_ptr<AgenteBase> agente_ptr = *it;
-        AgenteBase* agente_raw = agente_ptr.get();
-        QPoint posActual = agente_raw->getPosicion();
-        int agenteId = agente_raw->getId();
-
-        // 1. NUEVO: Verificar si ya está evacuado (para eliminarlo)
-        if (agente_raw->getEstado() == EstadoAgente::EVACUADO) {
-            // Ya fue evacuado en un frame anterior, eliminarlo
-            pasosPorAgente.erase(agenteId);
-            posicionAnterior.erase(agenteId);
-            it = agentes.erase(it);
+        if (resultado == ResultadoPaso::EVACUADO) {
             agentesEvacuadosEnEsteFrame++;
+            continue; // No se vuelve a programar
+        }
+        if (resultado == ResultadoPaso::CARGADA) {
+            continue; // La mueve su rescatista
+        }
+        if (resultado == ResultadoPaso::DETENIDO) {
+            // Volver a intentarlo sin que nada cambie daría el mismo resultado
+            actualizarIndiceAyuda(entrada.agente);
+            agentesDetenidos.push_back(entrada.agente);
+            dormirAgente(std::move(entrada.agente));
             continue;
         }
+        alguienSeMovio = true;
+        actualizarIndiceAyuda(entrada.agente);
+
+        // Siguiente llegada a partir del instante exacto de esta (sin redondeo)
+        entrada.instante += calcularIntervaloSubticks(*entrada.agente);
+        if (entrada.instante < finTick) {
+            llegadas.push_back(std::move(entrada));
+            std::push_heap(llegadas.begin(), llegadas.end(), llegaDespues);
+        } else {
+            rueda.programar(std::move(entrada.agente), entrada.instante);
+        }
+    }
+
+    // Las celdas liberadas en este tick despiertan a sus vecinos para el siguiente
+    despertarTilesSucios();
+
+    // Retirar de la lista a los evacuados en este tick
+    if (agentesEvacuadosEnEsteFrame > 0) {
+        agentes.erase(std::remove_if(agentes.begin(), agentes.end(),
+                                     [](const std::shared_ptr<AgenteBase>& a) {
+                                         return a->getEstado() == EstadoAgente::EVACUADO;
+                                     }),
+                      agentes.end());
+    }
+
+    // Detectar si no hay movimiento (agentes atrapados). Un tick en el que
+    // ningún agente llega a su siguiente celda no cuenta como estancamiento,
+    // salvo que todos estén dormidos: entonces nada puede cambiar.
+    bool todosDormidos = rueda.vacia() && numDurmientes > 0;
+    if (!alguienSeMovio && !agentes.empty() && (agentesProcesados > 0 || todosDormidos)) {
+        ticksSinMovimiento++;
+
+        // Marcar como bloqueados a los agentes que intentaron avanzar y no pudieron
+        for (const auto& agente : agentesDetenidos) {
+            agente->setEstado(EstadoAgente::BLOQUEADO);
+            actualizarIndiceAyuda(agente);
+        }
+        if (todosDormidos && ticksSinMovimiento == 1) {
+            for (const auto& tile : durmientesPorTile) {
+                for (const auto& agente : tile) {
+                    agente->setEstado(EstadoAgente::BLOQUEADO);
+                    actualizarIndiceAyuda(agente);
+                }
+            }
+        }
+    } else if (alguienSeMovio) {
+        ticksSinMovimiento = 0;
+    }
+}
+
+bool Simulador::actualizarCampoDistancias() {
+    // Un cambio en el mapa invalida el campo de distancias
+    if (escenario->getVersion() == versionEscenario) {
+        return false;
+    }
+    versionEscenario = escenario->getVersion();
+    PERFILAR_FASE(perfilador, FaseTick::BUSQUEDA_RUTA);
+    TRAZAR("campo de distancias", "replanificacion");
+    campo.calcular(*escenario);
+    return true;
+}
+
+void Simulador::registrarCambioCelda(const std::shared_ptr<AgenteBase>& agente, Posicion desde, Posicion hasta) {
+    // Reflejar en el modelo el cambio de celda (estadísticas, grabación, frames)
+    {
+        PERFILAR_FASE(perfilador, FaseTick::ESTADISTICAS);
+        estadisticas->registrarMovimiento(agente, desde, hasta);
+    }
+    agente->setPosicion(hasta);
+    if (agente->getEstado() != EstadoAgente::EVACUANDO) {
+        agente->setEstado(EstadoAgente::EVACUANDO);
+    }
+    actualizarIndiceAyuda(agente);
+}
+
+void Simulador::retirarEvacuados(const std::vector<std::shared_ptr<AgenteBase>>& evacuadosMotor) {
+    for (const auto& agente : evacuadosMotor) {
+        evacuarAgente(agente, agente->getPosicion());
+    }
+    if (!evacuadosMotor.empty()) {
+        agentes.erase(std::remove_if(agentes.begin(), agentes.end(),
+                                     [](const std::shared_ptr<AgenteBase>& a) {
+                                         return a->getEstado() == EstadoAgente::EVACUADO;
+                                     }),
+                      agentes.end());
+    }
+}
 
-        // 2. Verificar si llegó a la salida AHORA
+void Simulador::avanzarContinuo() {
+    if (actualizarCampoDistancias()) {
+        motorFuerzaSocial->configurar(*escenario, &campo);
+    }
+
+    {
+        PERFILAR_FASE(perfilador, FaseTick::MOTOR);
+        motorFuerzaSocial->avanzar(static_cast<float>(INTERVALO_TICK_MS / 1000.0));
+    }
+
+    for (const auto& cambio : motorFuerzaSocial->getCambiosCelda()) {
+        registrarCambioCelda(cambio.agente, cambio.desde, cambio.hasta);
+    }
+    retirarEvacuados(motorFuerzaSocial->getEvacuados());
+
+    // Estancamiento: nadie se mueve de forma apreciable
+    if (!agentes.empty() && motorFuerzaSocial->getRapidezMaxima() < RAPIDEZ_MINIMA_CONTINUO) {
+        if (++ticksSinMovimiento == 1) {
+            for (const auto& agente : agentes) {
+                agente->setEstado(EstadoAgente::BLOQUEADO);
+                actualizarIndiceAyuda(agente);
+            }
+        }
+    } else {
+        ticksSinMovimiento = 0;
+    }
+}
+
+void Simulador::avanzarCampoPiso() {
+    if (actualizarCampoDistancias()) {
+        motorCampoPiso->configurar(*escenario, &campo);
+    }
+
+    {
+        PERFILAR_FASE(perfilador, FaseTick::MOTOR);
+        motorCampoPiso->avanzar();
+    }
+
+    for (const auto& movimiento : motorCampoPiso->getMovimientos()) {
+        registrarCambioCelda(movimiento.agente, movimiento.desde, movimiento.hasta);
+    }
+    for (const auto& agente : motorCampoPiso->getSinOpciones()) {
+        agente->setEstado(EstadoAgente::BLOQUEADO);
+        actualizarIndiceAyuda(agente);
+    }
+    retirarEvacuados(motorCampoPiso->getEvacuados());
+
+    // Quedarse quieto es una elección válida del autómata: solo hay
+    // estancamiento si además nadie tenía una celda libre a donde ir
+    if (!agentes.empty() && motorCampoPiso->getMovimientos().empty() &&
+        motorCampoPiso->getSinOpciones().size() == agentes.size()) {
+        ticksSinMovimiento++;
+    } else {
+        ticksSinMovimiento = 0;
+    }
+}
+
+Simulador::ResultadoPaso Simulador::procesarAgente(const std::shared_ptr<AgenteBase>& agente_ptr) {
+    AgenteBase* agente_raw = agente_ptr.get();
+    Posicion posActual = agente_raw->getPosicion();
+    int agenteId = agente_raw->getId();
+
+    if (agente_raw->getEstado() == EstadoAgente::EVACUADO) {
+        return ResultadoPaso::EVACUADO;
+    }
+
+    auto persona = comoAgente<Persona>(agente_ptr);
+    if (persona && persona->estaCargada()) {
+        return ResultadoPaso::CARGADA;
+    }
+
+    // Un rescatista asignado va primero hacia la persona; al alcanzarla se la lleva
+    auto rescatista = comoAgente<Rescatista>(agente_ptr);
+    std::shared_ptr<Persona> buscada;
+    if (rescatista && rescatista->getFase() == Rescatista::FaseRescate::EN_CAMINO) {
+        buscada = rescatista->getPersonaAsistida();
+        if (!buscada || buscada->getEstado() == EstadoAgente::EVACUADO) {
+            rescatista->liberarPersona();  // Salió por su cuenta
+            buscada.reset();
+        } else if (std::abs(buscada->getPosicion().x() - posActual.x()) <= 1 &&
+            std::abs(buscada->getPosicion().y() - posActual.y()) <= 1) {
+            recogerPersona(rescatista, buscada);
+            buscada.reset();
+        }
+    }
+
+    Posicion siguientePaso = posActual;
+    if (buscada) {
+        {
+            PERFILAR_FASE(perfilador, FaseTick::BUSQUEDA_RUTA);
+            siguientePaso = PathFinder::calcularSiguientePaso(escenario, posActual, buscada->getPosicion());
+        }
+        if (siguientePaso == posActual) {
+            // No hay camino hasta ella: que la atienda otro y este sigue hacia la salida
+            rescatista->descartarPersona();
+            actualizarIndiceAyuda(buscada);
+            buscada.reset();
+        }
+    }
+
+    if (!buscada) {
+        // 1. Verificar si ya está en una salida
         if (escenario->esSalida(posActual.x(), posActual.y())) {
-            // Registrar evacuación
-            agente_raw->setEstado(EstadoAgente::EVACUADO);
-            estadisticas->registrarEvacuacion(
-                agente_ptr,
-                posActual,
-                tiempoSimulacion,
-                pasosPorAgente[agenteId]
-                );
-            qDebug() << "🚪 Agente" << agenteId << "evacuado en" << tiempoSimulacion << "s con" << pasosPorAgente[agenteId] << "pasos";
-
-            // IMPORTANTE: Eliminar inmediatamente
-            pasosPorAgente.erase(agenteId);
-            posicionAnterior.erase(agenteId);
-            it = agentes.erase(it);
-            agentesEvacuadosEnEsteFrame++;
-            continue;
+            evacuarAgente(agente_ptr, posActual);
+            return ResultadoPaso::EVACUADO;
         }
 
-        // 3. Buscar salida y calcular ruta
-        QPoint salida = escenario->getSalidaMasCercana(posActual);
+        // 2. Buscar salida y calcular ruta
+        Posicion salida;
+        {
+            PERFILAR_FASE(perfilador, FaseTick::BUSQUEDA_SALIDA);
+            salida = escenario->getSalidaMasCercana(posActual);
+        }
 
         // Verificar que la salida es válida
         if (salida.x() == -1 || salida.y() == -1) {
-            qDebug() << "⚠️  Agente" << agenteId << "no puede encontrar salida";
+            registrar<NivelRegistro::ADVERTENCIA>(CodigoRegistro::AGENTE_SIN_SALIDA, agenteId);
             agente_raw->setEstado(EstadoAgente::BLOQUEADO);
-            ++it;
-            continue;
+            return ResultadoPaso::DETENIDO;
         }
 
-        QPoint siguientePaso = PathFinder::calcularSiguientePaso(escenario, posActual, salida);
-
-        // 4. Mover al agente
-        if (siguientePaso != posActual) {
-            // Verificar colisiones con otros agentes
-            bool colision = false;
-            for (const auto& otro : agentes) {
-                if (otro->getId() != agenteId && otro->getPosicion() == siguientePaso) {
-                    // MEJORA: No contar como colisión si el otro está evacuado
-                    if (otro->getEstado() != EstadoAgente::EVACUADO) {
-                        colision = true;
-                        estadisticas->registrarColision(siguientePaso);
-                        break;
-                    }
-                }
-            }
+        {
+            PERFILAR_FASE(perfilador, FaseTick::BUSQUEDA_RUTA);
+            siguientePaso = PathFinder::calcularSiguientePaso(escenario, posActual, salida);
+        }
+        if (siguientePaso == posActual) {
+            return ResultadoPaso::DETENIDO;
+        }
+    }
 
-            if (!colision) {
-                // Registrar movimiento
-                estadisticas->registrarMovimiento(agente_ptr, posActual, siguientePaso);
+    // 3. Verificar colisiones con otros agentes
+    if (comprobarColision(siguientePaso)) {
+        // Incrementar pánico si hay colisión
+        if (persona) {
+            persona->incrementarPanico(0.1);
+        }
+        return ResultadoPaso::DETENIDO;
+    }
 
-                agente_raw->setPosicion(siguientePaso);
-                pasosPorAgente[agenteId]++;
-                posicionAnterior[agenteId] = siguientePaso;
-                alguienSeMovio = true;
+    // 4. Mover al agente
+    {
+        PERFILAR_FASE(perfilador, FaseTick::ESTADISTICAS);
+        estadisticas->registrarMovimiento(agente_ptr, posActual, siguientePaso);
+    }
 
-                // Actualizar estado del agente
-                if (agente_raw->getEstado() != EstadoAgente::EVACUANDO) {
-                    agente_raw->setEstado(EstadoAgente::EVACUANDO);
-                }
+    liberarCelda(posActual);
+    ocuparCelda(siguientePaso);
+    agente_raw->setPosicion(siguientePaso);
 
-                // NUEVO: Verificar si llegó a salida después de moverse
-                if (escenario->esSalida(siguientePaso.x(), siguientePaso.y())) {
-                    agente_raw->setEstado(EstadoAgente::EVACUADO);
-                    estadisticas->registrarEvacuacion(
-                        agente_ptr,
-                        siguientePaso,
-                        tiempoSimulacion,
-                        pasosPorAgente[agenteId]
-                        );
-                    qDebug() << "🚪 Agente" << agenteId << "evacuado tras moverse en" << tiempoSimulacion << "s";
-
-                    // Eliminar inmediatamente
-                    pasosPorAgente.erase(agenteId);
-                    posicionAnterior.erase(agenteId);
-                    it = agentes.erase(it);
-                    agentesEvacuadosEnEsteFrame++;
-                    continue;
-                }
-            } else {
-                // Incrementar pánico si hay colisión (opcional)
-                if (auto persona = std::dynamic_pointer_cast<Persona>(agente_ptr)) {
-                    persona->incrementarPanico(0.1);
-                }
-            }
+    if (agente_raw->getEstado() != EstadoAgente::EVACUANDO) {
+        agente_raw->setEstado(EstadoAgente::EVACUANDO);
+    }
+
+    // La persona cargada avanza con su rescatista
+    if (rescatista && rescatista->getCargando()) {
+        if (auto cargada = rescatista->getPersonaAsistida()) {
+            registrarCambioCelda(cargada, cargada->getPosicion(), siguientePaso);
         }
+    }
 
-        ++it;
+    // Verificar si llegó a salida después de moverse (yendo a buscar a alguien no sale)
+    if (!buscada && escenario->esSalida(siguientePaso.x(), siguientePaso.y())) {
+        evacuarAgente(agente_ptr, siguientePaso);
+        return ResultadoPaso::EVACUADO;
     }
 
-    // Actualizar estado de los agentes restantes en estadísticas
-    estadisticas->actualizarEstadoAgentes(agentes);
+    return ResultadoPaso::MOVIDO;
+}
 
-    // Notificar a la GUI
-    emit mundoActualizado();
+void Simulador::recogerPersona(const std::shared_ptr<Rescatista>& rescatista, const std::shared_ptr<Persona>& persona) {
+    // Deja su celda y desde ahora va en la del rescatista
+    liberarCelda(persona->getPosicion());
+    registrarCambioCelda(persona, persona->getPosicion(), rescatista->getPosicion());
+    rescatista->tomarPersona();
+}
 
-    // Emitir resumen de estadísticas
-    QString resumen = QString::fromStdString(estadisticas->getResumenRapido());
-    emit estadisticasActualizadas(resumen);
+void Simulador::evacuarAgente(const std::shared_ptr<AgenteBase>& agente, Posicion salida) {
+    int agenteId = agente->getId();
 
-    // Detectar si no hay movimiento (agentes atrapados)
-    if (!alguienSeMovio && !agentes.empty()) {
-        ticksSinMovimiento++;
+    // La persona cargada no ocupa celda: va en la de su rescatista
+    auto evacuada = comoAgente<Persona>(agente);
+    const bool ocupaCelda = !(evacuada && evacuada->estaCargada());
 
-        // Detectar agentes bloqueados
-        for (const auto& agente_ptr : agentes) {
-            if (agente_ptr->getEstado() != EstadoAgente::EVACUADO) {
-                agente_ptr->setEstado(EstadoAgente::BLOQUEADO);
-            }
+    agente->setEstado(EstadoAgente::EVACUADO);
+    agente->setConteoEstados(nullptr);  // Los contadores son de agentes activos
+    if (modoMovimiento == ModoMovimiento::REJILLA && ocupaCelda) {
+        liberarCelda(salida);
+    }
+    agentesEvacuados++;
+    indiceAyuda.quitar(agenteId);
+    if (auto rescatista = comoAgente<Rescatista>(agente)) {
+        // La que lleva sale con él; la que iba a buscar queda disponible para otro rescatista
+        std::shared_ptr<Persona> persona = rescatista->getPersonaAsistida();
+        if (persona && rescatista->getCargando()) {
+            evacuarAgente(persona, salida);
+        }
+        rescatista->liberarPersona();
+        if (persona) {
+            actualizarIndiceAyuda(persona);
         }
+        rescatistas.erase(std::remove(rescatistas.begin(), rescatistas.end(), rescatista), rescatistas.end());
+    }
+    int pasos;
+    {
+        PERFILAR_FASE(perfilador, FaseTick::ESTADISTICAS);
+        pasos = estadisticas->registrarEvacuacion(agente, salida, tiempoSimulacion).pasosRealizados;
+    }
+    registrar<NivelRegistro::DEPURACION>(CodigoRegistro::AGENTE_EVACUADO, agenteId, tiempoSimulacion, pasos);
+}
 
-        if (ticksSinMovimiento >= maxTicksSinMovimiento) {
-            qDebug() << "⚠️  ADVERTENCIA: Simulación estancada. Agentes bloqueados o sin salida.";
-            qDebug() << "⚠️  Agentes restantes:" << agentes.size();
-            pausar();
-            estadisticas->calcularEstadisticas();
-            emit simulacionTerminada();
-            mostrarEstadisticas();
-            return;
+uint64_t Simulador::calcularIntervaloSubticks(const AgenteBase& agente) const {
+    // Un agente a la velocidad de referencia avanza una celda por tick
+    double velocidad = agente.calcularVelocidadEfectiva();
+    if (velocidad <= 0.0) {
+        return RuedaTemporal::SUBTICKS_POR_TICK;
+    }
+    double intervalo = RuedaTemporal::SUBTICKS_POR_TICK * VELOCIDAD_REFERENCIA / velocidad;
+    return std::max<uint64_t>(1, static_cast<uint64_t>(std::llround(intervalo)));
+}
+
+void Simulador::programarAgentes() {
+    // Reconstruir la ocupación y las estructuras de sueño para el mapa actual
+    ocupacion.assign(static_cast<size_t>(escenario->filas) * escenario->columnas, 0);
+    tilesFilas = (escenario->filas + TAM_TILE - 1) / TAM_TILE;
+    tilesColumnas = (escenario->columnas + TAM_TILE - 1) / TAM_TILE;
+    durmientesPorTile.assign(static_cast<size_t>(tilesFilas) * tilesColumnas, {});
+    tileSucio.assign(durmientesPorTile.size(), 0);
+    tilesSucios.clear();
+    numDurmientes = 0;
+    versionEscenario = escenario->getVersion();
+
+    // Todos llegan al inicio del siguiente tick; a partir de ahí cada uno sigue su ritmo
+    rueda.limpiar(tickActual + 1);
+    const uint64_t inicio = (tickActual + 1) * RuedaTemporal::SUBTICKS_POR_TICK;
+    for (const auto& agente : agentes) {
+        if (agente->getEstado() != EstadoAgente::EVACUADO) {
+            ocuparCelda(agente->getPosicion());
+            rueda.programar(agente, inicio);
         }
+    }
+}
+
+void Simulador::actualizarIndiceAyuda(const std::shared_ptr<AgenteBase>& agente) {
+    auto persona = comoAgente<Persona>(agente);
+    if (!persona) return;
+
+    if (persona->necesitaAyuda()) {
+        indiceAyuda.actualizar(persona);
     } else {
-        ticksSinMovimiento = 0;
+        indiceAyuda.quitar(persona->getId());
     }
+}
 
-    // Verificar si todos evacuaron (la lista está vacía)
-    if (agentes.empty()) {
-        pausar();
-        estadisticas->calcularEstadisticas();
-        emit simulacionTerminada();
-        qDebug() << "✅ ¡Todos los agentes han evacuado exitosamente!";
-        mostrarEstadisticas();
+void Simulador::atenderRescatistas() {
+    // Solo la rejilla lleva al rescatista hasta la persona: los motores
+    // continuo y de campo de piso mueven a todos hacia las salidas
+    if (modoMovimiento != ModoMovimiento::REJILLA) {
+        return;
     }
+
+    bool hayLibres = false;
+    for (const auto& rescatista : rescatistas) {
+        // La persona asistida pudo evacuar por su cuenta
+        if (rescatista->getEstaAsistiendo()) {
+            auto persona = rescatista->getPersonaAsistida();
+            if (!persona || persona->getEstado() == EstadoAgente::EVACUADO) {
+                rescatista->liberarPersona();
+            }
+        }
+        hayLibres = hayLibres || !rescatista->getEstaAsistiendo();
+    }
+    if (!hayLibres || indiceAyuda.size() == 0) {
+        return;
+    }
+
+    // Todos los libres a la vez: nadie persigue a la persona de otro ni deja
+    // sin atender a alguien lejano por tomar al más cercano
+    for (const auto& asignacion : asignador.asignar(rescatistas, indiceAyuda)) {
+        indiceAyuda.quitar(asignacion.persona->getId());
+        asignacion.rescatista->asistirPersona(asignacion.persona);
+        // Si estaba dormido esperando una celda, ahora tiene otro destino
+        marcarTileSucio(tileDe(asignacion.rescatista->getPosicion()));
+    }
+    despertarTilesSucios();
+}
+
+bool Simulador::comprobarColision(Posicion destino) {
+    PERFILAR_FASE(perfilador, FaseTick::COLISIONES);
+    int indice = indiceCelda(destino);
+    if (indice < 0 || ocupacion[indice] <= 0) {
+        return false;
+    }
+    estadisticas->registrarColision(destino);
+    return true;
+}
+
+int Simulador::indiceCelda(Posicion celda) const {
+    if (celda.x() < 0 || celda.x() >= escenario->filas ||
+        celda.y() < 0 || celda.y() >= escenario->columnas) {
+        return -1;
+    }
+    return celda.x() * escenario->columnas + celda.y();
+}
+
+void Simulador::ocuparCelda(Posicion celda) {
+    int indice = indiceCelda(celda);
+    if (indice >= 0) {
+        ocupacion[indice]++;
+    }
+}
+
+void Simulador::liberarCelda(Posicion celda) {
+    int indice = indiceCelda(celda);
+    if (indice < 0) return;
+    ocupacion[indice]--;
+
+    // Marcar los tiles de las 8 vecinas: cualquiera de ellas pudo estar esperando esta celda
+    int filaMin = std::max(0, celda.x() - 1) / TAM_TILE;
+    int filaMax = std::min(escenario->filas - 1, celda.x() + 1) / TAM_TILE;
+    int colMin = std::max(0, celda.y() - 1) / TAM_TILE;
+    int colMax = std::min(escenario->columnas - 1, celda.y() + 1) / TAM_TILE;
+    for (int tf = filaMin; tf <= filaMax; ++tf) {
+        for (int tc = colMin; tc <= colMax; ++tc) {
+            marcarTileSucio(tf * tilesColumnas + tc);
+        }
+    }
+}
+
+int Simulador::tileDe(Posicion celda) const {
+    int tf = std::clamp(celda.x(), 0, escenario->filas - 1) / TAM_TILE;
+    int tc = std::clamp(celda.y(), 0, escenario->columnas - 1) / TAM_TILE;
+    return tf * tilesColumnas + tc;
+}
+
+void Simulador::marcarTileSucio(int tile) {
+    if (!tileSucio[tile]) {
+        tileSucio[tile] = 1;
+        tilesSucios.push_back(tile);
+    }
+}
+
+void Simulador::dormirAgente(std::shared_ptr<AgenteBase> agente) {
+    durmientesPorTile[tileDe(agente->getPosicion())].push_back(std::move(agente));
+    numDurmientes++;
+}
+
+void Simulador::despertarTilesSucios() {
+    const uint64_t inicio = (tickActual + 1) * RuedaTemporal::SUBTICKS_POR_TICK;
+    for (int tile : tilesSucios) {
+        tileSucio[tile] = 0;
+        auto& durmientes = durmientesPorTile[tile];
+        numDurmientes -= durmientes.size();
+        for (auto& agente : durmientes) {
+            rueda.programar(std::move(agente), inicio);
+        }
+        durmientes.clear();
+    }
+    tilesSucios.clear();
+}
+
+void Simulador::despertarTodos() {
+    for (size_t tile = 0; tile < durmientesPorTile.size(); ++tile) {
+        if (!durmientesPorTile[tile].empty()) {
+            marcarTileSucio(static_cast<int>(tile));
+        }
+    }
+    despertarTilesSucios();
+}
+
+bool Simulador::iniciarGrabacion(const std::string& rutaArchivo) {
+    bool ok = false;
+    ejecutarEnHilo([this, &rutaArchivo, &ok]() { ok = iniciarGrabacionEnHilo(rutaArchivo); });
+    return ok;
+}
+
+bool Simulador::iniciarGrabacionEnHilo(const std::string& rutaArchivo) {
+    if (!escenario) return false;
+
+    if (!grabador->abrir(rutaArchivo, *escenario, INTERVALO_TICK_MS / 1000.0)) {
+        qDebug() << "Error: no se pudo crear el archivo de trayectorias" << QString::fromStdString(rutaArchivo);
+        return false;
+    }
+
+    // Estado inicial como primer keyframe
+    capturarAgentes(instantaneas);
+    grabador->registrarTick(tickActual, instantaneas);
+    qDebug() << "⏺ Grabando trayectorias en" << QString::fromStdString(rutaArchivo);
+    return true;
+}
+
+void Simulador::detenerGrabacion() {
+    ejecutarEnHilo([this]() {
+        if (grabador->estaAbierto()) {
+            grabador->cerrar();
+            qDebug() << "⏹ Grabación de trayectorias finalizada en el tick" << tickActual;
+        }
+    });
+}
+
+bool Simulador::estaGrabando() {
+    bool grabando = false;
+    ejecutarEnHilo([this, &grabando]() { grabando = grabador->estaAbierto(); });
+    return grabando;
+}
+
+bool Simulador::iniciarExportacionSerie(const std::string& rutaArchivo) {
+    bool ok = false;
+    ejecutarEnHilo([this, &rutaArchivo, &ok]() { ok = iniciarExportacionSerieEnHilo(rutaArchivo); });
+    return ok;
+}
+
+bool Simulador::iniciarExportacionSerieEnHilo(const std::string& rutaArchivo) {
+    if (!escenario) return false;
+
+    // Las columnas de flujo son las salidas del mapa al empezar
+    std::vector<Posicion> salidas;
+    for (int fila = 0; fila < escenario->filas; ++fila) {
+        for (int columna = 0; columna < escenario->columnas; ++columna) {
+            if (escenario->grid[fila][columna] == 2) {
+                salidas.emplace_back(fila, columna);
+            }
+        }
+    }
+
+    if (!exportadorSerie->abrir(rutaArchivo, salidas)) {
+        qDebug() << "Error: no se pudo crear el archivo de la serie" << QString::fromStdString(rutaArchivo);
+        return false;
+    }
+    evacuadosPorSalida.assign(salidas.size(), 0);
+    registrarSerie();  // Fila base: el flujo por salida se cuenta desde aquí
+    qDebug() << "⏺ Exportando serie por tick en" << QString::fromStdString(rutaArchivo);
+    return true;
+}
+
+void Simulador::registrarSerie() {
+    const std::vector<Posicion>& salidas = exportadorSerie->getSalidas();
+    for (size_t i = 0; i < salidas.size(); ++i) {
+        evacuadosPorSalida[i] = estadisticas->getPersonasEvacuadasPorSalida(salidas[i]);
+    }
+    estadisticas->actualizarResumen(conteoEstados, static_cast<int>(agentes.size()));
+    exportadorSerie->registrarTick(estadisticas->getResumen(), evacuadosPorSalida);
+}
+
+void Simulador::detenerExportacionSerie() {
+    ejecutarEnHilo([this]() {
+        if (exportadorSerie->estaAbierto()) {
+            exportadorSerie->cerrar();
+            qDebug() << "⏹ Serie por tick finalizada en el tick" << tickActual;
+        }
+    });
+}
+
+bool Simulador::estaExportandoSerie() {
+    bool exportando = false;
+    ejecutarEnHilo([this, &exportando]() { exportando = exportadorSerie->estaAbierto(); });
+    return exportando;
 }
 
 Escenario* Simulador::getEscenario() {
@@ -253,18 +1044,61 @@ EstadisticasSimulacion* Simulador::getEstadisticas() {
 }
 
 void Simulador::exportarEstadisticas(const std::string& rutaArchivo) {
-    estadisticas->calcularEstadisticas();
-    if (estadisticas->exportarReporte(rutaArchivo)) {
-        qDebug() << "Estadísticas exportadas a:" << QString::fromStdString(rutaArchivo);
-    } else {
-        qDebug() << "Error al exportar estadísticas";
+    ejecutarEnHilo([this, &rutaArchivo]() {
+        TRAZAR("exportar estadisticas", "io");
+        estadisticas->calcularEstadisticas();
+        if (estadisticas->exportarReporte(rutaArchivo)) {
+            qDebug() << "Estadísticas exportadas a:" << QString::fromStdString(rutaArchivo);
+        } else {
+            qDebug() << "Error al exportar estadísticas";
+        }
+    });
+}
+
+bool Simulador::exportarDensidad(const std::string& rutaArchivo) {
+    bool exportado = false;
+    ejecutarEnHilo([this, &rutaArchivo, &exportado]() {
+        TRAZAR("exportar densidad", "io");
+        exportado = estadisticas->exportarDensidad(rutaArchivo);
+    });
+    return exportado;
+}
+
+bool Simulador::obtenerUltimaDensidad(std::vector<uint8_t>& destino) {
+    bool hayMuestra = false;
+    ejecutarEnHilo([this, &destino, &hayMuestra]() {
+        const SerieDensidad& serie = estadisticas->getSerieDensidad();
+        hayMuestra = serie.getCantidadMuestras() > 0;
+        if (hayMuestra) {
+            destino = serie.getUltimaMuestra();
+        }
+    });
+    return hayMuestra;
+}
+
+std::string Simulador::generarReporte() {
+    std::string reporte;
+    ejecutarEnHilo([this, &reporte]() {
+        estadisticas->calcularEstadisticas();
+        reporte = estadisticas->generarReporte() + "\n" + gestorEventos->generarReporte();
+    });
+    return reporte;
+}
+
+std::string Simulador::generarReportePerfil() {
+    if constexpr (!PerfiladorTick::ACTIVO) {
+        return "El perfilado no está compilado.\n"
+               "Configure con -DSIMULADOR_PERFILADO=ON para medir las fases del tick.\n";
     }
+    std::string reporte;
+    ejecutarEnHilo([this, &reporte]() { reporte = perfilador.generarReporte(); });
+    return reporte;
 }
 
 void Simulador::mostrarEstadisticas() {
     // Actualizar estado actual antes de calcular
-    estadisticas->actualizarEstadoAgentes(agentes);
-    estadisticas->actualizarTiempoSimulacion(tiempoSimulacion);
+    estadisticas->actualizarTiempoSimulacion(tickActual, tiempoSimulacion);
+    estadisticas->actualizarResumen(conteoEstados, static_cast<int>(agentes.size()));
     estadisticas->calcularEstadisticas();
 
     std::string reporte = estadisticas->generarReporte();
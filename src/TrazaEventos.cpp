@@ -0,0 +1,180 @@
+#include "../include/TrazaEventos.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+thread_local const char* nombreHiloActual = nullptr;
+
+void escribirCadenaJson(std::ofstream& archivo, const char* texto) {
+    archivo << '"';
+    for (const char* p = texto; *p; ++p) {
+        if (*p == '"' || *p == '\\') {
+            archivo << '\\';
+        }
+        archivo << *p;
+    }
+    archivo << '"';
+}
+}
+
+// El búfer lo guarda 'buffers'; el hilo solo lo usa hasta terminar. El
+// puntero sin destructor es el que consulta anotar(); el dueño solo se toca
+// al tomar el búfer y al terminar el hilo.
+thread_local TrazaEventos::BufferHilo* TrazaEventos::bufferHiloActual = nullptr;
+thread_local TrazaEventos::DuenoBuffer TrazaEventos::duenoBufferHilo;
+
+TrazaEventos::DuenoBuffer::~DuenoBuffer() {
+    if (buffer) {
+        TrazaEventos::global().devolverBuffer(buffer);
+    }
+}
+
+TrazaEventos& TrazaEventos::global() {
+    static TrazaEventos traza;
+    return traza;
+}
+
+TrazaEventos::TrazaEventos() : activa(false), generacion(0), origenNs(ahoraNs()) {
+}
+
+uint64_t TrazaEventos::ahoraNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void TrazaEventos::iniciar() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        origenNs = ahoraNs();
+    }
+    // Cada hilo descarta sus intervalos anteriores al ver la nueva generación
+    generacion.fetch_add(1, std::memory_order_release);
+    activa.store(true, std::memory_order_release);
+}
+
+void TrazaEventos::detener() {
+    activa.store(false, std::memory_order_release);
+}
+
+void TrazaEventos::nombrarHilo(const char* nombre) {
+    nombreHiloActual = nombre;
+    if (bufferHiloActual) {
+        bufferHiloActual->nombre.store(nombre, std::memory_order_relaxed);
+    }
+}
+
+TrazaEventos::BufferHilo* TrazaEventos::bufferDelHilo() {
+    if (bufferHiloActual) {
+        return bufferHiloActual;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    BufferHilo* buffer;
+    if (!libres.empty()) {
+        // Sigue a continuación de lo que anotó el hilo anterior (anotar() lo
+        // vacía si era de otra sesión)
+        buffer = libres.back();
+        libres.pop_back();
+        if (nombreHiloActual) {
+            buffer->nombre.store(nombreHiloActual, std::memory_order_relaxed);
+        }
+    } else {
+        auto nuevo = std::make_unique<BufferHilo>();
+        nuevo->intervalos.reset(new Intervalo[CAPACIDAD_POR_HILO]);
+        nuevo->cantidad.store(0, std::memory_order_relaxed);
+        nuevo->generacion.store(generacion.load(std::memory_order_acquire), std::memory_order_relaxed);
+        nuevo->descartados.store(0, std::memory_order_relaxed);
+        nuevo->nombre.store(nombreHiloActual, std::memory_order_relaxed);
+        nuevo->idHilo = static_cast<uint32_t>(buffers.size()) + 1;
+        buffers.push_back(std::move(nuevo));
+        buffer = buffers.back().get();
+    }
+    bufferHiloActual = buffer;
+    duenoBufferHilo.buffer = buffer;
+    return buffer;
+}
+
+void TrazaEventos::devolverBuffer(BufferHilo* buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    libres.push_back(buffer);
+    bufferHiloActual = nullptr;
+}
+
+void TrazaEventos::anotar(const char* nombre, const char* categoria, uint64_t inicioNs, uint64_t finNs) {
+    BufferHilo* buffer = bufferDelHilo();
+
+    const uint32_t sesion = generacion.load(std::memory_order_acquire);
+    if (buffer->generacion.load(std::memory_order_relaxed) != sesion) {
+        buffer->cantidad.store(0, std::memory_order_relaxed);
+        buffer->descartados.store(0, std::memory_order_relaxed);
+        buffer->generacion.store(sesion, std::memory_order_release);
+    }
+
+    const size_t n = buffer->cantidad.load(std::memory_order_relaxed);
+    if (n >= CAPACIDAD_POR_HILO) {
+        buffer->descartados.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->intervalos[n] = Intervalo{nombre, categoria, inicioNs, finNs - inicioNs};
+    buffer->cantidad.store(n + 1, std::memory_order_release);
+}
+
+bool TrazaEventos::exportar(const std::string& ruta) {
+    std::ofstream archivo(ruta);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const uint32_t sesion = generacion.load(std::memory_order_acquire);
+
+    archivo << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    archivo << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+               "\"args\":{\"name\":\"Simulador de evacuación\"}}";
+    archivo << std::fixed << std::setprecision(3);
+
+    for (const auto& buffer : buffers) {
+        const char* nombre = buffer->nombre.load(std::memory_order_relaxed);
+        archivo << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->idHilo
+                << ",\"args\":{\"name\":";
+        if (nombre) {
+            escribirCadenaJson(archivo, nombre);
+        } else {
+            archivo << "\"hilo " << buffer->idHilo << "\"";
+        }
+        archivo << "}}";
+
+        if (buffer->generacion.load(std::memory_order_acquire) != sesion) {
+            continue;  // El hilo no anotó nada en esta sesión
+        }
+        const size_t n = buffer->cantidad.load(std::memory_order_acquire);
+        for (size_t i = 0; i < n; ++i) {
+            const Intervalo& intervalo = buffer->intervalos[i];
+            if (intervalo.inicioNs < origenNs) {
+                continue;
+            }
+            archivo << ",\n{\"name\":";
+            escribirCadenaJson(archivo, intervalo.nombre);
+            archivo << ",\"cat\":";
+            escribirCadenaJson(archivo, intervalo.categoria);
+            archivo << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->idHilo
+                    << ",\"ts\":" << (intervalo.inicioNs - origenNs) / 1000.0
+                    << ",\"dur\":" << intervalo.duracionNs / 1000.0 << "}";
+        }
+    }
+    archivo << "\n]}\n";
+    return archivo.good();
+}
+
+uint64_t TrazaEventos::getDescartados() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t total = 0;
+    const uint32_t sesion = generacion.load(std::memory_order_acquire);
+    for (const auto& buffer : buffers) {
+        if (buffer->generacion.load(std::memory_order_relaxed) == sesion) {
+            total += buffer->descartados.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
@@ -9,15 +9,17 @@
 #include <QDialog>
 #include <QFont>
 #include <QDebug>
+#include "../include/TrazaEventos.h"
 
 VentanaPrincipal::VentanaPrincipal(QWidget *parent)
     : QMainWindow(parent),
     simulacionEnEjecucion(false),
-    tiempoSimulacion(0) {
+    muestraDensidadMostrada(-1) {
 
     // Configurar ventana
     setWindowTitle("Simulador de Evacuación - Sistema Multiagente");
     setMinimumSize(1200, 800);
+    TrazaEventos::nombrarHilo("gui");
 
     // Crear componentes principales
     simulador = new Simulador(this);
@@ -30,13 +32,14 @@ VentanaPrincipal::VentanaPrincipal(QWidget *parent)
     crearBarraHerramientas();
     crearPanelControl();
     crearPanelEstadisticas();
+    crearPanelReproduccion();
     configurarLayout();
     conectarSeñales();
 
     // Inicializar con un escenario por defecto
     simulador->cargarEscenario(20, 20);
     vistaEscenario->setEscenario(simulador->getEscenario());
-    vistaEscenario->setAgentes(&simulador->getAgentes());
+    vistaEscenario->setFuenteFrames(simulador->getBufferFrames());
 
     statusBar()->showMessage("Listo. Dibuja el escenario o carga una configuración.");
 }
@@ -63,6 +66,26 @@ void VentanaPrincipal::crearMenus() {
 
     menuArchivo->addSeparator();
 
+    accionGrabarTrayectoria = menuArchivo->addAction("&Grabar Trayectoria...");
+    accionGrabarTrayectoria->setCheckable(true);
+    connect(accionGrabarTrayectoria, &QAction::toggled, this, &VentanaPrincipal::grabarTrayectoria);
+
+    QAction* accionReproducir = menuArchivo->addAction("&Reproducir Trayectoria...");
+    connect(accionReproducir, &QAction::triggered, this, &VentanaPrincipal::abrirTrayectoria);
+
+    QAction* accionExportarDensidad = menuArchivo->addAction("Exportar &Densidad...");
+    connect(accionExportarDensidad, &QAction::triggered, this, &VentanaPrincipal::exportarDensidad);
+
+    accionExportarSerie = menuArchivo->addAction("Exportar &Serie por Tick...");
+    accionExportarSerie->setCheckable(true);
+    connect(accionExportarSerie, &QAction::toggled, this, &VentanaPrincipal::exportarSerie);
+
+    accionGrabarTraza = menuArchivo->addAction("Grabar &Traza de Ejecución...");
+    accionGrabarTraza->setCheckable(true);
+    connect(accionGrabarTraza, &QAction::toggled, this, &VentanaPrincipal::grabarTraza);
+
+    menuArchivo->addSeparator();
+
     QAction* accionSalir = menuArchivo->addAction("&Salir");
     accionSalir->setShortcut(QKeySequence::Quit);
     connect(accionSalir, &QAction::triggered, this, &VentanaPrincipal::salir);
@@ -82,6 +105,15 @@ void VentanaPrincipal::crearMenus() {
     accionReiniciar->setShortcut(Qt::Key_F7);
     connect(accionReiniciar, &QAction::triggered, this, &VentanaPrincipal::reiniciarSimulacion);
 
+    QAction* accionPaso = menuSimulacion->addAction("Avanzar un &Tick");
+    accionPaso->setShortcut(Qt::Key_F8);
+    connect(accionPaso, &QAction::triggered, this, &VentanaPrincipal::avanzarUnTick);
+
+    menuSimulacion->addSeparator();
+
+    QAction* accionPerfil = menuSimulacion->addAction("Perfil del Tic&k...");
+    connect(accionPerfil, &QAction::triggered, this, &VentanaPrincipal::mostrarPerfil);
+
     // Menú Ayuda
     menuAyuda = menuBar()->addMenu("&Ayuda");
 
@@ -97,16 +129,19 @@ void VentanaPrincipal::crearBarraHerramientas() {
     btnIniciar = new QPushButton("▶ Iniciar", this);
     btnPausar = new QPushButton("⏸ Pausar", this);
     btnReiniciar = new QPushButton("⟲ Reiniciar", this);
+    btnPaso = new QPushButton("⏭ Paso", this);
 
     btnPausar->setEnabled(false);
 
     barraHerramientas->addWidget(btnIniciar);
     barraHerramientas->addWidget(btnPausar);
     barraHerramientas->addWidget(btnReiniciar);
+    barraHerramientas->addWidget(btnPaso);
 
     connect(btnIniciar, &QPushButton::clicked, this, &VentanaPrincipal::iniciarSimulacion);
     connect(btnPausar, &QPushButton::clicked, this, &VentanaPrincipal::pausarSimulacion);
     connect(btnReiniciar, &QPushButton::clicked, this, &VentanaPrincipal::reiniciarSimulacion);
+    connect(btnPaso, &QPushButton::clicked, this, &VentanaPrincipal::avanzarUnTick);
 }
 
 void VentanaPrincipal::crearPanelControl() {
@@ -123,12 +158,35 @@ void VentanaPrincipal::crearPanelControl() {
     lblVelocidad = new QLabel("Normal (500ms)", this);
     lblVelocidad->setAlignment(Qt::AlignCenter);
 
+    // Sin pausa entre ticks: la vista solo muestra el último estado
+    chkMaximaVelocidad = new QCheckBox("Máxima velocidad", this);
+
     layout->addWidget(lblTitulo);
     layout->addWidget(sliderVelocidad);
     layout->addWidget(lblVelocidad);
+    layout->addWidget(chkMaximaVelocidad);
+
+    // Modo de movimiento de los agentes
+    QLabel* lblMovimiento = new QLabel("Movimiento:", this);
+    comboMovimiento = new QComboBox(this);
+    comboMovimiento->addItem("Rejilla (celda a celda)");
+    comboMovimiento->addItem("Continuo (fuerza social)");
+    comboMovimiento->addItem("Campo de piso (autómata)");
+    layout->addWidget(lblMovimiento);
+    layout->addWidget(comboMovimiento);
+
+    // Capa con la última muestra de densidad por celda
+    chkMostrarDensidad = new QCheckBox("Mostrar densidad", this);
+    layout->addWidget(chkMostrarDensidad);
 
     connect(sliderVelocidad, &QSlider::valueChanged,
             this, &VentanaPrincipal::cambiarVelocidadSimulacion);
+    connect(chkMaximaVelocidad, &QCheckBox::toggled,
+            this, &VentanaPrincipal::cambiarMaximaVelocidad);
+    connect(comboMovimiento, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &VentanaPrincipal::cambiarModoMovimiento);
+    connect(chkMostrarDensidad, &QCheckBox::toggled,
+            this, &VentanaPrincipal::cambiarMostrarDensidad);
 
     panelControl->setLayout(layout);
     panelControl->setMaximumWidth(250);
@@ -238,6 +296,37 @@ void VentanaPrincipal::crearPanelEstadisticas() {
     panelAgentes->setMaximumWidth(250);
 }
 
+void VentanaPrincipal::crearPanelReproduccion() {
+    panelReproduccion = new QGroupBox("Reproducción", this);
+    QVBoxLayout* layout = new QVBoxLayout();
+
+    lblLineaTiempo = new QLabel("Tick: 0", this);
+    lblLineaTiempo->setAlignment(Qt::AlignCenter);
+
+    sliderLineaTiempo = new QSlider(Qt::Horizontal, this);
+    sliderLineaTiempo->setMinimum(0);
+    sliderLineaTiempo->setMaximum(0);
+
+    btnReproducir = new QPushButton("▶ Reproducir", this);
+    btnSalirReproduccion = new QPushButton("Volver al Editor", this);
+
+    timerReproduccion = new QTimer(this);
+
+    layout->addWidget(lblLineaTiempo);
+    layout->addWidget(sliderLineaTiempo);
+    layout->addWidget(btnReproducir);
+    layout->addWidget(btnSalirReproduccion);
+
+    connect(sliderLineaTiempo, &QSlider::valueChanged, this, &VentanaPrincipal::moverLineaTiempo);
+    connect(btnReproducir, &QPushButton::clicked, this, &VentanaPrincipal::alternarReproduccion);
+    connect(btnSalirReproduccion, &QPushButton::clicked, this, &VentanaPrincipal::salirReproduccion);
+    connect(timerReproduccion, &QTimer::timeout, this, &VentanaPrincipal::avanzarReproduccion);
+
+    panelReproduccion->setLayout(layout);
+    panelReproduccion->setMaximumWidth(250);
+    panelReproduccion->setVisible(false);
+}
+
 void VentanaPrincipal::configurarLayout() {
     QWidget* centralWidget = new QWidget(this);
     QHBoxLayout* layoutPrincipal = new QHBoxLayout();
@@ -248,6 +337,7 @@ void VentanaPrincipal::configurarLayout() {
     layoutIzquierdo->addWidget(panelAgentes);
     layoutIzquierdo->addWidget(panelControl);
     layoutIzquierdo->addWidget(panelEstadisticas);
+    layoutIzquierdo->addWidget(panelReproduccion);
     layoutIzquierdo->addStretch();
 
     // Área central con el escenario
@@ -261,14 +351,18 @@ void VentanaPrincipal::configurarLayout() {
 }
 
 void VentanaPrincipal::conectarSeñales() {
-    connect(simulador, &Simulador::mundoActualizado,
+    connect(vistaEscenario, &VistaEscenario::frameActualizado,
             this, &VentanaPrincipal::actualizarVista);
     connect(simulador, &Simulador::simulacionTerminada,
             this, &VentanaPrincipal::onSimulacionTerminada);
-    connect(simulador, &Simulador::estadisticasActualizadas,
-            this, &VentanaPrincipal::actualizarEstadisticasTexto);
     connect(vistaEscenario, &VistaEscenario::escenarioModificado,
             this, &VentanaPrincipal::actualizarEstadisticas);
+
+    // El mapa lo lee el hilo de simulación: cada edición se aplica allí, entre dos ticks
+    connect(vistaEscenario, &VistaEscenario::celdaEditada,
+            [this](int fila, int columna, int tipo) {
+                simulador->editarCelda(fila, columna, tipo);
+            });
     
     // CRÍTICO: Conectar señal de agentes agregados desde la vista al simulador
     connect(vistaEscenario, &VistaEscenario::agenteAgregado,
@@ -286,11 +380,15 @@ void VentanaPrincipal::nuevoEscenario() {
         return;
     }
 
+    if (vistaEscenario->enModoReproduccion()) {
+        salirReproduccion();
+    }
+
     int filas = spinFilas->value();
     int columnas = spinColumnas->value();
 
     simulador->cargarEscenario(filas, columnas);
-    vistaEscenario->redimensionarEscenario(filas, columnas);
+    vistaEscenario->setEscenario(simulador->getEscenario());
     vistaEscenario->limpiarAgentes();
 
     statusBar()->showMessage(QString("Nuevo escenario creado: %1x%2").arg(filas).arg(columnas));
@@ -323,17 +421,17 @@ void VentanaPrincipal::guardarConfiguracion() {
 
     // Guardar agentes
     QJsonArray agentesArray;
-    for (const auto& agente : vistaEscenario->getAgentesCreados()) {
+    for (const auto& agente : vistaEscenario->getAgentesColocados()) {
         QJsonObject agenteObj;
-        agenteObj["id"] = agente->getId();
-        agenteObj["x"] = agente->getPosicion().x();
-        agenteObj["y"] = agente->getPosicion().y();
-        agenteObj["tipo"] = static_cast<int>(agente->getTipoComportamiento());
+        agenteObj["id"] = agente.id;
+        agenteObj["x"] = agente.celda.x();
+        agenteObj["y"] = agente.celda.y();
+        agenteObj["tipo"] = static_cast<int>(agente.tipo);
 
         // Si es persona, guardar edad
-        if (const auto persona_ptr = std::dynamic_pointer_cast<Persona>(agente)) {
-            agenteObj["edad"] = persona_ptr->getEdad();
-            agenteObj["movilidadReducida"] = persona_ptr->tieneMovilidadReducida();
+        if (agente.tipo != TipoComportamiento::RESCATISTA) {
+            agenteObj["edad"] = agente.edad;
+            agenteObj["movilidadReducida"] = agente.movilidadReducida;
         }
 
         agentesArray.append(agenteObj);
@@ -374,6 +472,10 @@ void VentanaPrincipal::abrirConfiguracion() {
     QByteArray data = file.readAll();
     file.close();
 
+    if (vistaEscenario->enModoReproduccion()) {
+        salirReproduccion();
+    }
+
     QJsonDocument doc = QJsonDocument::fromJson(data);
     QJsonObject config = doc.object();
 
@@ -382,24 +484,26 @@ void VentanaPrincipal::abrirConfiguracion() {
     int columnas = config["columnas"].toInt();
 
     simulador->cargarEscenario(filas, columnas);
-    vistaEscenario->redimensionarEscenario(filas, columnas);
+    vistaEscenario->setEscenario(simulador->getEscenario());
     vistaEscenario->limpiarAgentes();
 
-    // Cargar grid
+    // Cargar grid (se arma completo y el simulador lo copia en su hilo)
     QJsonArray gridArray = config["grid"].toArray();
     Escenario* esc = simulador->getEscenario();
-    for (int i = 0; i < filas && i < gridArray.size(); ++i) {
+    std::vector<uint8_t> celdas(static_cast<size_t>(esc->filas) * esc->columnas, 0);
+    for (int i = 0; i < esc->filas && i < gridArray.size(); ++i) {
         QJsonArray fila = gridArray[i].toArray();
-        for (int j = 0; j < columnas && j < fila.size(); ++j) {
-            esc->setCelda(i, j, fila[j].toInt());
+        for (int j = 0; j < esc->columnas && j < fila.size(); ++j) {
+            celdas[static_cast<size_t>(i) * esc->columnas + j] = static_cast<uint8_t>(fila[j].toInt());
         }
     }
+    simulador->reemplazarCeldas(celdas);
 
     // Cargar agentes
     QJsonArray agentesArray = config["agentes"].toArray();
     for (const auto& agenteVal : agentesArray) {
         QJsonObject agenteObj = agenteVal.toObject();
-        QPoint pos(agenteObj["x"].toInt(), agenteObj["y"].toInt());
+        Posicion pos(agenteObj["x"].toInt(), agenteObj["y"].toInt());
         int tipo = agenteObj["tipo"].toInt();
 
         if (tipo == static_cast<int>(TipoComportamiento::RESCATISTA)) {
@@ -437,25 +541,46 @@ void VentanaPrincipal::mostrarAcercaDe() {
                        "<p>Versión 1.0 - 2024</p>");
 }
 
-void VentanaPrincipal::iniciarSimulacion() {
-    if (vistaEscenario->getAgentesCreados().empty()) {
+bool VentanaPrincipal::validarInicioSimulacion() {
+    if (vistaEscenario->enModoReproduccion()) {
+        QMessageBox::information(this, "Información",
+                                 "Vuelve al editor antes de iniciar una simulación.");
+        return false;
+    }
+
+    if (vistaEscenario->getAgentesColocados().empty()) {
         QMessageBox::information(this, "Información",
                                  "Agrega agentes al escenario antes de iniciar la simulación.");
-        return;
+        return false;
     }
 
-    if (simulador->getEscenario()->getSalidaMasCercana(QPoint(0,0)) == QPoint(-1, -1)) {
+    if (simulador->getEscenario()->getSalidaMasCercana(Posicion(0, 0)) == Posicion(-1, -1)) {
         QMessageBox::critical(this, "Error de Configuración",
                               "¡Debes definir al menos una Salida (🚪) en el mapa!");
-        return; //aborta la simulación si no hay destino
+        return false; //aborta la simulación si no hay destino
     }
 
+    return true;
+}
+
+void VentanaPrincipal::iniciarSimulacion() {
+    if (!validarInicioSimulacion()) return;
+
     simulador->iniciar();
     simulacionEnEjecucion = true;
     actualizarEstadoBotones(true);
     statusBar()->showMessage("Simulación en ejecución...");
 }
 
+void VentanaPrincipal::avanzarUnTick() {
+    if (simulacionEnEjecucion || !validarInicioSimulacion()) return;
+
+    simulador->pasoUnico();
+    actualizarVista();
+    statusBar()->showMessage(QString("Simulación pausada en el tick %1.")
+                                 .arg(vistaEscenario->getFrameActual().tick));
+}
+
 void VentanaPrincipal::pausarSimulacion() {
     simulador->pausar();
     simulacionEnEjecucion = false;
@@ -464,12 +589,20 @@ void VentanaPrincipal::pausarSimulacion() {
 }
 
 void VentanaPrincipal::reiniciarSimulacion() {
+    if (vistaEscenario->enModoReproduccion()) {
+        salirReproduccion();
+    }
+
     // 1. Pausar y limpiar el simulador completamente
     simulador->pausar();
     simulador->reiniciar();
+    accionGrabarTrayectoria->setChecked(false);
+    accionExportarSerie->setChecked(false);
     
     // 2. Limpiar la vista del escenario
     vistaEscenario->limpiarAgentes();
+    vistaEscenario->ocultarDensidad();
+    muestraDensidadMostrada = -1;
     
     // 3. Reiniciar las dimensiones del escenario (mantener el tamaño actual)
     Escenario* esc = simulador->getEscenario();
@@ -478,12 +611,10 @@ void VentanaPrincipal::reiniciarSimulacion() {
         int columnas = esc->columnas;
         simulador->cargarEscenario(filas, columnas);
         vistaEscenario->setEscenario(simulador->getEscenario());
-        vistaEscenario->setAgentes(&simulador->getAgentes());
     }
     
     // 4. Reiniciar variables de estado
     simulacionEnEjecucion = false;
-    tiempoSimulacion = 0;
     archivoActual.clear(); // Limpiar referencia al archivo
     
     // 5. Actualizar interfaz
@@ -502,21 +633,51 @@ void VentanaPrincipal::reiniciarSimulacion() {
 }
 
 void VentanaPrincipal::actualizarVista() {
-    vistaEscenario->update();
+    const FrameSimulacion& frame = vistaEscenario->getFrameActual();
     actualizarEstadisticas();
 
-    tiempoSimulacion++;
-    lblTiempoTranscurrido->setText(QString("Tiempo: %1s").arg(tiempoSimulacion / 2));
+    int segundos = static_cast<int>(frame.tick) * Simulador::INTERVALO_TICK_MS / 1000;
+    lblTiempoTranscurrido->setText(QString("Tiempo: %1s").arg(segundos));
+    if (frame.estadisticas.totalAgentes > 0) {
+        lblEstadisticasResumen->setText(
+            QString::fromStdString(EstadisticasSimulacion::formatearResumen(frame.estadisticas)));
+    }
+    actualizarDensidad(frame.tick);
+}
+
+void VentanaPrincipal::actualizarDensidad(uint32_t tick) {
+    if (!chkMostrarDensidad->isChecked() || vistaEscenario->enModoReproduccion()) {
+        return;
+    }
+    // Solo se pide al simulador cuando hay una muestra nueva
+    const int64_t muestra = tick / EstadisticasSimulacion::INTERVALO_DENSIDAD;
+    if (muestra == muestraDensidadMostrada) {
+        return;
+    }
+    muestraDensidadMostrada = muestra;
+    std::vector<uint8_t> conteo;
+    if (simulador->obtenerUltimaDensidad(conteo)) {
+        vistaEscenario->setMapaDensidad(conteo);
+    }
 }
 
 void VentanaPrincipal::onSimulacionTerminada() {
+    // El último frame ya está publicado cuando llega la señal
+    if (vistaEscenario->sincronizarFrame()) {
+        vistaEscenario->update();
+    }
+    actualizarVista();
+    int segundos = static_cast<int>(vistaEscenario->getFrameActual().tick) * Simulador::INTERVALO_TICK_MS / 1000;
+
     simulacionEnEjecucion = false;
+    accionGrabarTrayectoria->setChecked(false); // El simulador cierra la grabación al terminar
+    accionExportarSerie->setChecked(false);
     actualizarEstadoBotones(false);
     statusBar()->showMessage("¡Simulación completada! Todos los agentes evacuados.");
 
     QMessageBox::information(this, "Simulación Completada",
                              QString("Todos los agentes han sido evacuados exitosamente.\n\n"
-                                     "Tiempo total: %1 segundos").arg(tiempoSimulacion / 2));
+                                     "Tiempo total: %1 segundos").arg(segundos));
 }
 
 void VentanaPrincipal::cambiarHerramienta(int index) {
@@ -535,48 +696,52 @@ void VentanaPrincipal::cambiarVelocidadSimulacion(int valor) {
 
     lblVelocidad->setText(texto);
 
-    // Aquí deberías ajustar el intervalo del timer del simulador
-    // Esto requiere agregar un método en Simulador para cambiar la velocidad
+    // Se aplica al instante, sin reiniciar la simulación
+    simulador->setIntervaloTick(intervalo);
 }
 
-void VentanaPrincipal::actualizarEstadisticas() {
-    const auto& agentes = simulador->getAgentes();
-
-    int total = agentes.size();
-    int evacuados = 0;
-    int enRuta = 0;
-    int bloqueados = 0;
-
-    for (const auto& agente : agentes) {
-        switch (agente->getEstado()) {
-        case EstadoAgente::EVACUADO:
-            evacuados++;
-            break;
-        case EstadoAgente::EVACUANDO:
-            enRuta++;
-            break;
-        case EstadoAgente::BLOQUEADO:
-            bloqueados++;
-            break;
-        default:
-            break;
-        }
+void VentanaPrincipal::cambiarModoMovimiento(int index) {
+    ModoMovimiento modo = static_cast<ModoMovimiento>(index);
+    if (!simulador->setModoMovimiento(modo)) {
+        QMessageBox::information(this, "Información",
+                                 "Reinicia la simulación para cambiar el modo de movimiento.");
+        comboMovimiento->blockSignals(true);
+        comboMovimiento->setCurrentIndex(static_cast<int>(simulador->getModoMovimiento()));
+        comboMovimiento->blockSignals(false);
+        return;
+    }
+    statusBar()->showMessage("Movimiento: " + comboMovimiento->currentText());
+}
+
+void VentanaPrincipal::cambiarMostrarDensidad(bool mostrar) {
+    muestraDensidadMostrada = -1;
+    if (mostrar) {
+        actualizarDensidad(vistaEscenario->getFrameActual().tick);
+    } else {
+        vistaEscenario->ocultarDensidad();
     }
+}
 
-    lblTotalAgentes->setText(QString("Total de agentes: %1").arg(total));
-    lblEvacuados->setText(QString("Evacuados: %1").arg(evacuados));
-    lblEnRuta->setText(QString("En ruta: %1").arg(enRuta));
-    lblBloqueados->setText(QString("Bloqueados: %1").arg(bloqueados));
+void VentanaPrincipal::cambiarMaximaVelocidad(bool activar) {
+    sliderVelocidad->setEnabled(!activar);
+    simulador->setMaximaVelocidad(activar);
 }
 
-void VentanaPrincipal::actualizarEstadisticasTexto(QString resumen) {
-    lblEstadisticasResumen->setText(resumen);
+void VentanaPrincipal::actualizarEstadisticas() {
+    if (vistaEscenario->sincronizarFrame()) {
+        vistaEscenario->update();
+    }
+    const FrameSimulacion& frame = vistaEscenario->getFrameActual();
+
+    const ResumenEstadisticas& resumen = frame.estadisticas;
+    lblTotalAgentes->setText(QString("Total de agentes: %1").arg(resumen.totalAgentes));
+    lblEvacuados->setText(QString("Evacuados: %1").arg(resumen.evacuados));
+    lblEnRuta->setText(QString("En ruta: %1").arg(resumen.enRuta));
+    lblBloqueados->setText(QString("Bloqueados: %1").arg(resumen.bloqueados));
 }
 
 void VentanaPrincipal::mostrarReporteCompleto() {
-    EstadisticasSimulacion* stats = simulador->getEstadisticas();
-    stats->calcularEstadisticas();
-    QString reporte = QString::fromStdString(stats->generarReporte());
+    QString reporte = QString::fromStdString(simulador->generarReporte());
     
     // Crear diálogo para mostrar el reporte
     QDialog* dialogo = new QDialog(this);
@@ -602,13 +767,13 @@ void VentanaPrincipal::mostrarReporteCompleto() {
     layout->addLayout(layoutBotones);
     
     connect(btnCerrar, &QPushButton::clicked, dialogo, &QDialog::accept);
-    connect(btnExportar, &QPushButton::clicked, [this, stats]() {
+    connect(btnExportar, &QPushButton::clicked, [this]() {
         QString archivo = QFileDialog::getSaveFileName(
             this, "Exportar Estadísticas", "", 
-            "Archivo de Texto (*.txt);;CSV (*.csv);;JSON (*.json)"
+            "Archivo de Texto (*.txt);;CSV (*.csv);;JSON (*.json);;Eventos en columnas (*.cols)"
         );
         if (!archivo.isEmpty()) {
-            stats->exportarReporte(archivo.toStdString());
+            simulador->exportarEstadisticas(archivo.toStdString());
             QMessageBox::information(this, "Éxito", 
                 "Estadísticas exportadas correctamente a:\n" + archivo);
         }
@@ -618,9 +783,188 @@ void VentanaPrincipal::mostrarReporteCompleto() {
     delete dialogo;
 }
 
+void VentanaPrincipal::mostrarPerfil() {
+    QDialog* dialogo = new QDialog(this);
+    dialogo->setWindowTitle("⏱ Perfil del Tick");
+    dialogo->resize(800, 360);
+
+    QVBoxLayout* layout = new QVBoxLayout(dialogo);
+
+    QTextEdit* textoPerfil = new QTextEdit(dialogo);
+    textoPerfil->setReadOnly(true);
+    textoPerfil->setPlainText(QString::fromStdString(simulador->generarReportePerfil()));
+    textoPerfil->setFont(QFont("Courier", 10));
+
+    QPushButton* btnCerrar = new QPushButton("Cerrar", dialogo);
+    connect(btnCerrar, &QPushButton::clicked, dialogo, &QDialog::accept);
+
+    layout->addWidget(textoPerfil);
+    layout->addWidget(btnCerrar);
+
+    dialogo->exec();
+    delete dialogo;
+}
+
+void VentanaPrincipal::exportarDensidad() {
+    QString archivo = QFileDialog::getSaveFileName(
+        this, "Exportar Densidad", "", "Serie de densidad (*.dens)");
+    if (archivo.isEmpty()) return;
+
+    if (!simulador->exportarDensidad(archivo.toStdString())) {
+        QMessageBox::critical(this, "Error", "No se pudo escribir el archivo de densidad.");
+        return;
+    }
+    statusBar()->showMessage("Densidad exportada a: " + archivo);
+}
+
+void VentanaPrincipal::exportarSerie(bool activar) {
+    if (!activar) {
+        simulador->detenerExportacionSerie();
+        statusBar()->showMessage("Exportación de la serie por tick detenida.");
+        return;
+    }
+    if (simulador->estaExportandoSerie()) return;
+
+    QString archivo = QFileDialog::getSaveFileName(
+        this, "Exportar Serie por Tick", "", "CSV (*.csv)");
+
+    if (archivo.isEmpty() || !simulador->iniciarExportacionSerie(archivo.toStdString())) {
+        if (!archivo.isEmpty()) {
+            QMessageBox::critical(this, "Error", "No se pudo crear el archivo de la serie.");
+        }
+        accionExportarSerie->setChecked(false);
+        return;
+    }
+    statusBar()->showMessage("Exportando serie por tick en: " + archivo);
+}
+
+void VentanaPrincipal::grabarTraza(bool activar) {
+    TrazaEventos& traza = TrazaEventos::global();
+    if (activar) {
+        traza.iniciar();
+        statusBar()->showMessage("Grabando traza de ejecución. Desmarque la opción para guardarla.");
+        return;
+    }
+    if (!traza.estaActiva()) return;
+    traza.detener();
+
+    QString archivo = QFileDialog::getSaveFileName(
+        this, "Guardar Traza de Ejecución", "", "Traza de Chrome (*.json)");
+    if (archivo.isEmpty()) return;
+
+    if (!traza.exportar(archivo.toStdString())) {
+        QMessageBox::critical(this, "Error", "No se pudo escribir el archivo de traza.");
+        return;
+    }
+    QString mensaje = "Traza guardada en: " + archivo;
+    if (traza.getDescartados() > 0) {
+        mensaje += QString(" (%1 intervalos descartados por búfer lleno)").arg(traza.getDescartados());
+    }
+    statusBar()->showMessage(mensaje);
+}
+
+void VentanaPrincipal::grabarTrayectoria(bool activar) {
+    if (!activar) {
+        simulador->detenerGrabacion();
+        statusBar()->showMessage("Grabación de trayectorias detenida.");
+        return;
+    }
+    if (simulador->estaGrabando()) return;
+
+    QString archivo = QFileDialog::getSaveFileName(
+        this, "Grabar Trayectoria", "", "Trayectorias (*.tray)");
+
+    if (archivo.isEmpty() || !simulador->iniciarGrabacion(archivo.toStdString())) {
+        if (!archivo.isEmpty()) {
+            QMessageBox::critical(this, "Error", "No se pudo crear el archivo de trayectorias.");
+        }
+        accionGrabarTrayectoria->setChecked(false);
+        return;
+    }
+    statusBar()->showMessage("Grabando trayectorias en: " + archivo);
+}
+
+void VentanaPrincipal::abrirTrayectoria() {
+    if (simulacionEnEjecucion) {
+        QMessageBox::warning(this, "Advertencia",
+                             "Detén la simulación antes de reproducir una grabación.");
+        return;
+    }
+
+    QString archivo = QFileDialog::getOpenFileName(
+        this, "Reproducir Trayectoria", "", "Trayectorias (*.tray)");
+    if (archivo.isEmpty()) return;
+
+    auto lector = std::make_shared<LectorTrayectorias>();
+    if (!lector->abrir(archivo)) {
+        QMessageBox::critical(this, "Error",
+                              "No se pudo abrir la grabación (archivo inválido o incompleto).");
+        return;
+    }
+
+    timerReproduccion->stop();
+    lectorTrayectorias = lector;
+    vistaEscenario->iniciarReproduccion(lectorTrayectorias);
+
+    sliderLineaTiempo->setMinimum(static_cast<int>(lector->getPrimerTick()));
+    sliderLineaTiempo->setMaximum(static_cast<int>(lector->getUltimoTick()));
+    sliderLineaTiempo->setValue(static_cast<int>(lector->getPrimerTick()));
+    timerReproduccion->setInterval(static_cast<int>(lector->getSegundosPorTick() * 1000));
+
+    panelReproduccion->setVisible(true);
+    btnIniciar->setEnabled(false);
+    btnPaso->setEnabled(false);
+    comboHerramientas->setEnabled(false);
+    statusBar()->showMessage("Reproduciendo: " + archivo);
+}
+
+void VentanaPrincipal::moverLineaTiempo(int tick) {
+    if (!lectorTrayectorias) return;
+
+    vistaEscenario->mostrarTick(static_cast<uint32_t>(tick));
+    lblLineaTiempo->setText(QString("Tick: %1 / %2 (%3 s)")
+                                .arg(tick)
+                                .arg(lectorTrayectorias->getUltimoTick())
+                                .arg(tick * lectorTrayectorias->getSegundosPorTick(), 0, 'f', 1));
+}
+
+void VentanaPrincipal::alternarReproduccion() {
+    if (timerReproduccion->isActive()) {
+        timerReproduccion->stop();
+        btnReproducir->setText("▶ Reproducir");
+    } else {
+        if (sliderLineaTiempo->value() >= sliderLineaTiempo->maximum()) {
+            sliderLineaTiempo->setValue(sliderLineaTiempo->minimum());
+        }
+        timerReproduccion->start();
+        btnReproducir->setText("⏸ Pausar");
+    }
+}
+
+void VentanaPrincipal::avanzarReproduccion() {
+    if (sliderLineaTiempo->value() >= sliderLineaTiempo->maximum()) {
+        alternarReproduccion();
+        return;
+    }
+    sliderLineaTiempo->setValue(sliderLineaTiempo->value() + 1);
+}
+
+void VentanaPrincipal::salirReproduccion() {
+    timerReproduccion->stop();
+    btnReproducir->setText("▶ Reproducir");
+    vistaEscenario->detenerReproduccion();
+    lectorTrayectorias.reset();
+
+    panelReproduccion->setVisible(false);
+    actualizarEstadoBotones(simulacionEnEjecucion);
+    statusBar()->showMessage("Modo edición.");
+}
+
 void VentanaPrincipal::actualizarEstadoBotones(bool simulacionActiva) {
     btnIniciar->setEnabled(!simulacionActiva);
     btnPausar->setEnabled(simulacionActiva);
+    btnPaso->setEnabled(!simulacionActiva);
+    comboMovimiento->setEnabled(!simulacionActiva);
     btnNuevoEscenario->setEnabled(!simulacionActiva);
     comboHerramientas->setEnabled(!simulacionActiva);
 }
@@ -1,15 +1,16 @@
 #include "../include/VistaEscenario.h"
-#include "../include/Persona.h"
-#include "../include/Rescatista.h"
+#include "../include/TrazaEventos.h"
 #include <QPainter>
 #include <QMouseEvent>
+#include <algorithm>
 #include <cmath>
 
 VistaEscenario::VistaEscenario(QWidget *parent)
     : QWidget(parent),
     escenario(nullptr),
-    agentes(nullptr),
     factoria(nullptr),
+    escenarioEdicion(nullptr),
+    fuenteFrames(nullptr),
     tamañoCelda(TAMAÑO_CELDA_DEFAULT),
     margenX(MARGEN),
     margenY(MARGEN),
@@ -23,6 +24,16 @@ VistaEscenario::VistaEscenario(QWidget *parent)
     setMouseTracking(true);
     setFocusPolicy(Qt::StrongFocus);
     setMinimumSize(400, 400);
+
+    // Se repinta al ritmo de la pantalla, sin importar lo que tarde un tick
+    timerRefresco = new QTimer(this);
+    connect(timerRefresco, &QTimer::timeout, this, [this]() {
+        if (sincronizarFrame()) {
+            emit frameActualizado();
+            update();
+        }
+    });
+    timerRefresco->start(INTERVALO_REFRESCO_MS);
 }
 
 VistaEscenario::~VistaEscenario() {
@@ -35,11 +46,20 @@ void VistaEscenario::setEscenario(Escenario* esc) {
     update();
 }
 
-void VistaEscenario::setAgentes(const std::vector<std::shared_ptr<AgenteBase>>* ags) {
-    agentes = ags;
+void VistaEscenario::setFuenteFrames(BufferFrames* buffer) {
+    fuenteFrames = buffer;
+    sincronizarFrame();
     update();
 }
 
+bool VistaEscenario::sincronizarFrame() {
+    return fuenteFrames && fuenteFrames->leer();
+}
+
+const FrameSimulacion& VistaEscenario::getFrameActual() const {
+    return fuenteFrames ? fuenteFrames->lectura() : frameVacio;
+}
+
 void VistaEscenario::setFactoria(FactoriaAgentes* fact) {
     factoria = fact;
 }
@@ -56,37 +76,55 @@ void VistaEscenario::setMovilidadReducida(bool reducida) {
     movilidadReducidaNuevo = reducida;
 }
 
-void VistaEscenario::limpiarEscenario() {
-    if (!escenario) return;
-
-    for (int i = 0; i < escenario->filas; ++i) {
-        for (int j = 0; j < escenario->columnas; ++j) {
-            escenario->setCelda(i, j, 0);
-        }
-    }
+void VistaEscenario::limpiarAgentes() {
+    agentesColocados.clear();
     update();
 }
 
-void VistaEscenario::limpiarAgentes() {
-    agentesCreados.clear();
-    update();
+void VistaEscenario::iniciarReproduccion(std::shared_ptr<LectorTrayectorias> lector) {
+    if (!lector) return;
+    if (!enModoReproduccion()) {
+        escenarioEdicion = escenario;
+    }
+
+    lectorReproduccion = lector;
+    escenarioReproduccion = lector->crearEscenario();
+    escenario = escenarioReproduccion.get();
+    dibujandoArrastre = false;
+
+    calcularTamañoCelda();
+    mostrarTick(lector->getPrimerTick());
 }
 
-void VistaEscenario::redimensionarEscenario(int filas, int columnas) {
-    if (!escenario) return;
+void VistaEscenario::detenerReproduccion() {
+    if (!enModoReproduccion()) return;
 
-    escenario->filas = filas;
-    escenario->columnas = columnas;
-    escenario->grid.clear();
-    escenario->grid.resize(filas, std::vector<int>(columnas, 0));
+    escenario = escenarioEdicion;
+    escenarioEdicion = nullptr;
+    lectorReproduccion.reset();
+    escenarioReproduccion.reset();
+    frameReproduccion = FrameAgentes();
 
-    limpiarAgentes();
     calcularTamañoCelda();
     update();
 }
 
+void VistaEscenario::mostrarTick(uint32_t tick) {
+    if (!enModoReproduccion()) return;
+
+    // Solo se decodifica desde el keyframe más cercano: no se vuelve a simular
+    if (lectorReproduccion->decodificarFrame(tick, frameReproduccion)) {
+        emit infoActualizada(QString("Reproducción: tick %1 (%2 s) - %3 agentes")
+                                 .arg(tick)
+                                 .arg(frameReproduccion.tiempo, 0, 'f', 1)
+                                 .arg(frameReproduccion.agentes.size()));
+    }
+    update();
+}
+
 void VistaEscenario::paintEvent(QPaintEvent *event) {
     Q_UNUSED(event);
+    TRAZAR("pintar escenario", "gui");
 
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
@@ -106,6 +144,7 @@ void VistaEscenario::paintEvent(QPaintEvent *event) {
 
     // Dibujar componentes
     dibujarGrid(painter);
+    dibujarDensidad(painter);
     dibujarAgentes(painter);
     dibujarGuias(painter);
 }
@@ -152,36 +191,24 @@ void VistaEscenario::dibujarCelda(QPainter& painter, int fila, int col) {
 }
 
 void VistaEscenario::dibujarAgentes(QPainter& painter) {
-    if (!agentes) return;
-
-    for (const auto& agente_ptr : *agentes) {
-        dibujarAgente(painter, agente_ptr.get());
+    if (enModoReproduccion()) {
+        for (const auto& agente : frameReproduccion.agentes) {
+            dibujarInstantanea(painter, agente);
+        }
+        return;
     }
 
-    // Dibujar también los agentes creados que aún no están en el simulador
-    for (const auto& agente_creado_ptr : agentesCreados) {
-        bool yaEnSimulador = false;
-        for (const auto& a_ptr : *agentes) {
-            if (a_ptr.get() == agente_creado_ptr.get()) {
-                yaEnSimulador = true;
-                break;
-            }
-        }
-        if (!yaEnSimulador) {
-            dibujarAgente(painter, agente_creado_ptr.get());
-        }
+    // Los agentes creados se agregan al simulador al instante, así que ya
+    // aparecen en el frame publicado
+    for (const auto& agente : getFrameActual().agentes) {
+        dibujarInstantanea(painter, agente);
     }
 }
 
-void VistaEscenario::dibujarAgente(QPainter& painter, AgenteBase* agente) {
-    if (!agente) return;
-
-    QPoint posGrid = agente->getPosicion();
-    QPoint posPantalla = gridAPixel(posGrid.x(), posGrid.y());
-
-    // Centro de la celda
-    int centroX = posPantalla.x() + tamañoCelda / 2;
-    int centroY = posPantalla.y() + tamañoCelda / 2;
+void VistaEscenario::dibujarInstantanea(QPainter& painter, const InstantaneaAgente& agente) {
+    // Centro de la celda (x = fila, y = columna)
+    double centroX = margenX + agente.y * tamañoCelda + tamañoCelda / 2.0;
+    double centroY = margenY + agente.x * tamañoCelda + tamañoCelda / 2.0;
     int radio = tamañoCelda / 3;
 
     QColor color = obtenerColorAgente(agente);
@@ -189,7 +216,7 @@ void VistaEscenario::dibujarAgente(QPainter& painter, AgenteBase* agente) {
     // Dibujar círculo para el agente
     painter.setBrush(QBrush(color));
     painter.setPen(QPen(Qt::black, 2));
-    painter.drawEllipse(QPoint(centroX, centroY), radio, radio);
+    painter.drawEllipse(QPointF(centroX, centroY), radio, radio);
 
     // Letra identificadora
     QFont font = painter.font();
@@ -199,13 +226,19 @@ void VistaEscenario::dibujarAgente(QPainter& painter, AgenteBase* agente) {
     painter.setPen(Qt::white);
 
     QString letra;
-    if (dynamic_cast<Rescatista*>(agente)) {
+    switch (agente.clase) {
+    case ClaseAgente::RESCATISTA:
         letra = "R";
-    } else if (auto persona = dynamic_cast<Persona*>(agente)) {
-        letra = persona->tieneMovilidadReducida() ? "M" : "P";
+        break;
+    case ClaseAgente::PERSONA_MOVILIDAD_REDUCIDA:
+        letra = "M";
+        break;
+    case ClaseAgente::PERSONA:
+        letra = "P";
+        break;
     }
 
-    painter.drawText(QRect(centroX - radio, centroY - radio,
+    painter.drawText(QRect(static_cast<int>(centroX) - radio, static_cast<int>(centroY) - radio,
                            radio * 2, radio * 2),
                      Qt::AlignCenter, letra);
 }
@@ -216,6 +249,7 @@ void VistaEscenario::dibujarGuias(QPainter& painter) {
 
 void VistaEscenario::mousePressEvent(QMouseEvent *event) {
     if (!escenario || event->button() != Qt::LeftButton) return;
+    if (enModoReproduccion()) return; // La grabación no se edita
 
     QPoint posClick = event->pos();
     dibujandoArrastre = true;
@@ -311,6 +345,34 @@ QPoint VistaEscenario::pixelAGrid(QPoint pixel) const {
     return QPoint(fila, col);
 }
 
+void VistaEscenario::setMapaDensidad(const std::vector<uint8_t>& conteo) {
+    mapaDensidad = conteo;
+    update();
+}
+
+void VistaEscenario::ocultarDensidad() {
+    mapaDensidad.clear();
+    update();
+}
+
+void VistaEscenario::dibujarDensidad(QPainter& painter) {
+    const size_t celdas = static_cast<size_t>(escenario->filas) * escenario->columnas;
+    if (mapaDensidad.size() != celdas) return;  // Vacío o de otro escenario
+
+    painter.setPen(Qt::NoPen);
+    for (int i = 0; i < escenario->filas; ++i) {
+        for (int j = 0; j < escenario->columnas; ++j) {
+            const int conteo = mapaDensidad[static_cast<size_t>(i) * escenario->columnas + j];
+            if (conteo == 0) continue;
+
+            // Más opaco cuantos más agentes comparten la celda (satura en 4)
+            const int alfa = 70 + 45 * (std::min(conteo, 4) - 1);
+            QPoint pos = gridAPixel(i, j);
+            painter.fillRect(QRect(pos.x(), pos.y(), tamañoCelda, tamañoCelda), QColor(220, 40, 30, alfa));
+        }
+    }
+}
+
 QPoint VistaEscenario::gridAPixel(int fila, int col) const {
     int x = margenX + col * tamañoCelda;
     int y = margenY + fila * tamañoCelda;
@@ -318,19 +380,19 @@ QPoint VistaEscenario::gridAPixel(int fila, int col) const {
 }
 
 void VistaEscenario::aplicarHerramientaPiso(int fila, int col) {
-    escenario->setCelda(fila, col, 0);
+    emit celdaEditada(fila, col, 0);
     emit escenarioModificado();
     update();
 }
 
 void VistaEscenario::aplicarHerramientaPared(int fila, int col) {
-    escenario->setCelda(fila, col, 1);
+    emit celdaEditada(fila, col, 1);
     emit escenarioModificado();
     update();
 }
 
 void VistaEscenario::aplicarHerramientaSalida(int fila, int col) {
-    escenario->setCelda(fila, col, 2);
+    emit celdaEditada(fila, col, 2);
     emit escenarioModificado();
     update();
 }
@@ -338,7 +400,7 @@ void VistaEscenario::aplicarHerramientaSalida(int fila, int col) {
 void VistaEscenario::aplicarHerramientaPersona(int fila, int col) {
     if (!factoria) return;
 
-    QPoint pos(fila, col);
+    Posicion pos(fila, col);
 
     // Verificar que la celda sea transitable
     if (!escenario->esTransitable(fila, col)) {
@@ -351,7 +413,8 @@ void VistaEscenario::aplicarHerramientaPersona(int fila, int col) {
     }
 
     auto persona = factoria->crearPersona(pos, edadAgenteNuevo, movilidadReducidaNuevo);
-    agentesCreados.push_back(persona);
+    agentesColocados.push_back(AgenteColocado{persona->getId(), pos, persona->getTipoComportamiento(),
+                                              edadAgenteNuevo, movilidadReducidaNuevo});
 
     emit agenteAgregado(persona);
     update();
@@ -360,7 +423,7 @@ void VistaEscenario::aplicarHerramientaPersona(int fila, int col) {
 void VistaEscenario::aplicarHerramientaRescatista(int fila, int col) {
     if (!factoria) return;
 
-    QPoint pos(fila, col);
+    Posicion pos(fila, col);
 
     // Verificar que la celda sea transitable
     if (!escenario->esTransitable(fila, col)) {
@@ -373,23 +436,23 @@ void VistaEscenario::aplicarHerramientaRescatista(int fila, int col) {
     }
 
     auto rescatista = factoria->crearRescatista(pos);
-    agentesCreados.push_back(rescatista);
+    agentesColocados.push_back(AgenteColocado{rescatista->getId(), pos, TipoComportamiento::RESCATISTA, 0, false});
 
     emit agenteAgregado(rescatista);
     update();
 }
 
 void VistaEscenario::aplicarHerramientaBorrar(int fila, int col) {
-    QPoint pos(fila, col);
+    Posicion pos(fila, col);
 
-    escenario->setCelda(fila, col, 0);
+    emit celdaEditada(fila, col, 0);
 
-    agentesCreados.erase(
-        std::remove_if(agentesCreados.begin(), agentesCreados.end(),
-                       [pos](const std::shared_ptr<AgenteBase>& agente_ptr) {
-                           return agente_ptr->getPosicion() == pos;
+    agentesColocados.erase(
+        std::remove_if(agentesColocados.begin(), agentesColocados.end(),
+                       [pos](const AgenteColocado& agente) {
+                           return agente.celda == pos;
                        }),
-        agentesCreados.end()
+        agentesColocados.end()
         );
     emit escenarioModificado();
     update();
@@ -424,11 +487,9 @@ QColor VistaEscenario::obtenerColorCelda(int tipoCelda) const {
     }
 }
 
-QColor VistaEscenario::obtenerColorAgente(AgenteBase* agente) const {
-    if (!agente) return Qt::black;
-
+QColor VistaEscenario::obtenerColorAgente(const InstantaneaAgente& agente) const {
     // Color según el estado
-    switch (agente->getEstado()) {
+    switch (agente.estado) {
     case EstadoAgente::EVACUADO:
         return QColor(0, 200, 0);       // Verde - Evacuado
     case EstadoAgente::EVACUANDO:
@@ -442,32 +503,30 @@ QColor VistaEscenario::obtenerColorAgente(AgenteBase* agente) const {
     }
 
     // Color según el tipo
-    if (dynamic_cast<Rescatista*>(agente)) {
+    switch (agente.clase) {
+    case ClaseAgente::RESCATISTA:
         return QColor(0, 150, 255);         // Azul rescatista
-    } else if (auto persona = dynamic_cast<Persona*>(agente)) {
-        if (persona->tieneMovilidadReducida()) {
-            return QColor(200, 100, 200);   // Púrpura - Movilidad reducida
-        }
+    case ClaseAgente::PERSONA_MOVILIDAD_REDUCIDA:
+        return QColor(200, 100, 200);       // Púrpura - Movilidad reducida
+    case ClaseAgente::PERSONA:
         return QColor(100, 100, 255);       // Azul persona normal
     }
 
     return Qt::gray;
 }
 
-bool VistaEscenario::posicionOcupada(QPoint pos) const {
-    // Verificar en agentes creados
-    for (const auto& agente : agentesCreados) {
-        if (agente->getPosicion() == pos) {
+bool VistaEscenario::posicionOcupada(Posicion pos) const {
+    // Verificar en agentes colocados que todavía no aparecen en un frame
+    for (const auto& agente : agentesColocados) {
+        if (agente.celda == pos) {
             return true;
         }
     }
 
     // Verificar en agentes del simulador
-    if (agentes) {
-        for (const auto& agente : *agentes) {
-            if (agente->getPosicion() == pos) {
-                return true;
-            }
+    for (const auto& agente : getFrameActual().agentes) {
+        if (std::lround(agente.x) == pos.x() && std::lround(agente.y) == pos.y()) {
+            return true;
         }
     }
 